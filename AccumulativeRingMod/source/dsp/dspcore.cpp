@@ -47,17 +47,26 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = double(sampleRate);
 
+  for (auto &os : offlineOversampler) {
+    os.setup(1);
+    os.set(offlineFold, OversamplingQuality::fir);
+  }
+
   reset();
   startup();
 }
 
-size_t DSPCore::getLatency() { return 0; }
+size_t DSPCore::getLatency()
+{
+  return useOfflineOversampler() ? size_t(std::lround(offlineOversampler[0].latency()))
+                                 : 0;
+}
 
 #define ASSIGN_PARAMETER(METHOD)                                                         \
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   outputGain.METHOD(pv[ID::outputGain]->getDouble());                                    \
   mix.METHOD(pv[ID::mix]->getDouble());                                                  \
@@ -105,9 +114,10 @@ size_t DSPCore::getLatency() { return 0; }
 
 void DSPCore::updateUpRate()
 {
-  upRate = double(sampleRate) * fold[oversampling];
+  const auto activeFold = useOfflineOversampler() ? offlineFold : fold[oversampling];
+  upRate = double(sampleRate) * activeFold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   for (auto &x : inputGate) x.setup(upRate, double(0.001));
 }
@@ -131,6 +141,7 @@ void DSPCore::reset()
   for (auto &x : upSampler) x.reset();
   for (auto &x : decimationLowpass) x.reset();
   for (auto &x : halfbandIir) x.reset();
+  for (auto &x : offlineOversampler) x.reset();
 
   startup();
 }
@@ -245,23 +256,41 @@ std::array<double, 2> DSPCore::processFrame(const std::array<double, 4> &frame)
   };
 }
 
+template<typename Sample>
 void DSPCore::process(
   const size_t length,
-  const float *in0,
-  const float *in1,
-  const float *in2,
-  const float *in3,
-  float *out0,
-  float *out1)
+  const Sample *in0,
+  const Sample *in1,
+  const Sample *in2,
+  const Sample *in3,
+  Sample *out0,
+  Sample *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
+    if (useOfflineOversampler()) {
+      const std::array<double, 4> x{in0[i], in1[i], in2[i], in3[i]};
+      std::array<double *, 4> up;
+      for (size_t k = 0; k < up.size(); ++k) up[k] = offlineOversampler[k].up(&x[k], 1);
+      for (size_t j = 0; j < offlineFold; ++j) {
+        auto frame = processFrame({up[0][j], up[1][j], up[2][j], up[3][j]});
+        up[0][j] = frame[0];
+        up[1][j] = frame[1];
+      }
+      double y0, y1;
+      offlineOversampler[0].down(&y0, 1);
+      offlineOversampler[1].down(&y1, 1);
+      out0[i] = Sample(y0);
+      out1[i] = Sample(y1);
+      continue;
+    }
+
     upSampler[0].process(in0[i]);
     upSampler[1].process(in1[i]);
     upSampler[2].process(in2[i]);
@@ -312,3 +341,20 @@ void DSPCore::process(
     }
   }
 }
+
+template void DSPCore::process<float>(
+  const size_t,
+  const float *,
+  const float *,
+  const float *,
+  const float *,
+  float *,
+  float *);
+template void DSPCore::process<double>(
+  const size_t,
+  const double *,
+  const double *,
+  const double *,
+  const double *,
+  double *,
+  double *);
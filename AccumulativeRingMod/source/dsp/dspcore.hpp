@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/multirate/oversampler.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "filter.hpp"
@@ -17,6 +18,7 @@ public:
   DSPCore() {}
 
   GlobalParameter param;
+  bool isOffline = false; // Set before `setup`. Uses `offlineOversampler` if true.
   bool isPlaying = false;
   float tempo = 120.0f;
   double beatsElapsed = 0.0f;
@@ -28,41 +30,46 @@ public:
   void startup();
   size_t getLatency();
   void setParameters();
+  template<typename Sample>
   void process(
     const size_t length,
-    const float *in0,
-    const float *in1,
-    const float *in2,
-    const float *in3,
-    float *out0,
-    float *out1);
+    const Sample *in0,
+    const Sample *in1,
+    const Sample *in2,
+    const Sample *in3,
+    Sample *out0,
+    Sample *out1);
 
 private:
   void updateUpRate();
   std::array<double, 2> processFrame(const std::array<double, 4> &frame);
 
+  bool useOfflineOversampler() const { return isOffline && oversampling != 0; }
+
   static constexpr size_t upFold = 16;
+  static constexpr size_t offlineFold = 64;
   static constexpr std::array<size_t, 3> fold{1, 2, upFold};
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100;
 
-  RotarySmoother<double> stereoPhaseOffset;
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> mix;
-  ExpSmoother<double> stereoPhaseLinkKp;
-  ExpSmoother<double> stereoPhaseCross;
-  ExpSmoother<double> phaseWarp;
-  ExpSmoother<double> inputPhaseMod;
-  ExpSmoother<double> inputPreAsymmetry;
-  ExpSmoother<double> inputLowpassG;
-  ExpSmoother<double> inputHighpassG;
-  ExpSmoother<double> inputPostAsymmetry;
-  ExpSmoother<double> sidePhaseMod;
-  ExpSmoother<double> sidePreAsymmetry;
-  ExpSmoother<double> sideLowpassG;
-  ExpSmoother<double> sideHighpassG;
-  ExpSmoother<double> sidePostAsymmetry;
+  RotarySmoother<double> stereoPhaseOffset{smootherContext};
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> mix{smootherContext};
+  ExpSmoother<double> stereoPhaseLinkKp{smootherContext};
+  ExpSmoother<double> stereoPhaseCross{smootherContext};
+  ExpSmoother<double> phaseWarp{smootherContext};
+  ExpSmoother<double> inputPhaseMod{smootherContext};
+  ExpSmoother<double> inputPreAsymmetry{smootherContext};
+  ExpSmoother<double> inputLowpassG{smootherContext};
+  ExpSmoother<double> inputHighpassG{smootherContext};
+  ExpSmoother<double> inputPostAsymmetry{smootherContext};
+  ExpSmoother<double> sidePhaseMod{smootherContext};
+  ExpSmoother<double> sidePreAsymmetry{smootherContext};
+  ExpSmoother<double> sideLowpassG{smootherContext};
+  ExpSmoother<double> sideHighpassG{smootherContext};
+  ExpSmoother<double> sidePostAsymmetry{smootherContext};
 
   size_t oversampling = 2;
   bool enableInputEnvelope = false;
@@ -77,4 +84,5 @@ private:
   std::array<CubicUpSampler<double, upFold>, 4> upSampler;
   std::array<DecimationLowpass<double, Sos16FoldFirstStage<double>>, 2> decimationLowpass;
   std::array<HalfBandIIR<double, HalfBandCoefficient<double>>, 2> halfbandIir;
+  std::array<Oversampler<double>, 4> offlineOversampler; // Only 0 and 1 are downsampled.
 };
@@ -27,6 +27,11 @@ void Editor::syncUI(ParamID id, float normalized)
 
 void Editor::valueChanged(CControl *pControl)
 {
+  switch (pControl->getTag()) {
+    case Synth::ParameterID::ID::oversampling:
+      controller->getComponentHandler()->restartComponent(kLatencyChanged);
+  }
+
   PlugEditor::valueChanged(pControl);
   syncUI(pControl->getTag(), pControl->getValueNormalized());
 }
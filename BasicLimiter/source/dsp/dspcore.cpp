@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   for (auto &lm : limiter)
     lm.resize(size_t(UpSamplerFir::upfold * maxAttackSeconds * this->sampleRate) + 1);
@@ -54,8 +54,8 @@ void DSPCore::reset()
 
   for (auto &lm : limiter) lm.reset(pv[ID::limiterThreshold]->getFloat());
   for (auto &he : highEliminator) he.reset();
-  for (auto &us : upSampler) us.reset();
-  for (auto &ds : downSampler) ds.reset();
+  upSampler.reset();
+  downSampler.reset();
   startup();
 }
 
@@ -92,30 +92,34 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   if (param.value[ParameterID::truePeak]->getInt()) {
     constexpr size_t upfold = UpSamplerFir::upfold;
-    for (size_t i = 0; i < length; ++i) {
-      auto sig0 = highEliminator[0].process(in0[i]);
-      auto sig1 = highEliminator[1].process(in1[i]);
+    for (size_t start = 0; start < length; start += truePeakBlockSize) {
+      const size_t blockSize = std::min(truePeakBlockSize, length - start);
+
+      for (size_t i = 0; i < blockSize; ++i) {
+        eliminated[0][i] = highEliminator[0].process(in0[start + i]);
+        eliminated[1][i] = highEliminator[1].process(in1[start + i]);
+      }
 
-      upSampler[0].process(sig0);
-      upSampler[1].process(sig1);
+      upSampler.process(
+        blockSize, eliminated[0].data(), eliminated[1].data(), expanded[0].data(),
+        expanded[1].data());
 
-      std::array<std::array<float, upfold>, 2> expanded;
-      for (size_t j = 0; j < upfold; ++j) {
-        auto &&tp0 = upSampler[0].output[j];
-        auto &&tp1 = upSampler[1].output[j];
+      for (size_t j = 0; j < blockSize * upfold; ++j) {
+        auto &tp0 = expanded[0][j];
+        auto &tp1 = expanded[1][j];
 
         auto &&inAbs = processStereoLink(tp0, tp1);
 
-        expanded[0][j] = limiter[0].process(tp0, inAbs[0]);
-        expanded[1][j] = limiter[1].process(tp1, inAbs[1]);
+        tp0 = limiter[0].process(tp0, inAbs[0]);
+        tp1 = limiter[1].process(tp1, inAbs[1]);
       }
 
-      out0[i] = downSampler[0].process(expanded[0]);
-      out1[i] = downSampler[1].process(expanded[1]);
+      downSampler.process(
+        blockSize, expanded[0].data(), expanded[1].data(), out0 + start, out1 + start);
     }
   } else {
     for (size_t i = 0; i < length; ++i) {
@@ -36,12 +36,18 @@ public:
 private:
   std::array<float, 2> processStereoLink(float in0, float in1);
 
+  static constexpr size_t truePeakBlockSize = 64;
+
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
-  ExpSmoother<float> interpStereoLink;
+  ExpSmoother<float> interpStereoLink{smootherContext};
 
   std::array<Limiter<float>, 2> limiter;
   std::array<NaiveConvolver<float, HighEliminationFir<float>>, 2> highEliminator;
-  std::array<FirPolyPhaseUpSampler<float, UpSamplerFir>, 2> upSampler;
-  std::array<FirDownSampler<float, DownSamplerFir>, 2> downSampler;
+  StereoFirPolyPhaseUpSampler<float, UpSamplerFir> upSampler;
+  StereoFirDownSampler<float, DownSamplerFir> downSampler;
+
+  std::array<std::array<float, truePeakBlockSize>, 2> eliminated{};
+  std::array<std::array<float, UpSamplerFir::upfold * truePeakBlockSize>, 2> expanded{};
 };
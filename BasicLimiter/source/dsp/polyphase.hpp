@@ -26,46 +26,113 @@ public:
   }
 };
 
-template<typename Sample, typename FractionalDelayFIR> class FirPolyPhaseUpSampler {
-  std::array<Sample, FractionalDelayFIR::bufferSize> buf{};
+/**
+Polyphase FIR upsampler for 2 channels.
 
+Coefficients are transposed to `[tap][phase]`, so the innermost loop runs over the
+contiguous phases. Compilers vectorize the loop over phases for both channels. History
+is a double length ring buffer, which is written twice instead of shifted.
+*/
+template<typename Sample, typename FractionalDelayFIR> class StereoFirPolyPhaseUpSampler {
 public:
-  std::array<Sample, FractionalDelayFIR::upfold> output;
+  static constexpr size_t nTap = FractionalDelayFIR::bufferSize;
+  static constexpr size_t upfold = FractionalDelayFIR::upfold;
 
-  void reset() { buf.fill(Sample(0)); }
+private:
+  static constexpr auto coefficient = []() {
+    std::array<std::array<Sample, upfold>, nTap> co{};
+    for (size_t p = 0; p < upfold; ++p) {
+      for (size_t n = 0; n < nTap; ++n) co[n][p] = FractionalDelayFIR::coefficient[p][n];
+    }
+    return co;
+  }();
+
+  std::array<std::array<Sample, 2 * nTap>, 2> buf{};
+  size_t wptr = 0;
 
-  void process(Sample input)
+public:
+  void reset()
   {
-    std::rotate(buf.rbegin(), buf.rbegin() + 1, buf.rend());
-    buf[0] = input;
+    for (auto &bf : buf) bf.fill(Sample(0));
+    wptr = 0;
+  }
+
+  // `out0` and `out1` have `length * upfold` samples.
+  void process(
+    size_t length, const Sample *in0, const Sample *in1, Sample *out0, Sample *out1)
+  {
+    for (size_t i = 0; i < length; ++i) {
+      wptr = wptr == 0 ? nTap - 1 : wptr - 1;
+      buf[0][wptr] = buf[0][wptr + nTap] = in0[i];
+      buf[1][wptr] = buf[1][wptr + nTap] = in1[i];
 
-    std::fill(output.begin(), output.end(), Sample(0));
-    for (size_t i = 0; i < FractionalDelayFIR::coefficient.size(); ++i) {
-      auto &&phase = FractionalDelayFIR::coefficient[i];
-      for (size_t n = 0; n < phase.size(); ++n) output[i] += buf[n] * phase[n];
+      alignas(64) std::array<Sample, upfold> acc0{};
+      alignas(64) std::array<Sample, upfold> acc1{};
+      const Sample *x0 = buf[0].data() + wptr;
+      const Sample *x1 = buf[1].data() + wptr;
+      for (size_t n = 0; n < nTap; ++n) {
+        const auto &co = coefficient[n];
+        for (size_t p = 0; p < upfold; ++p) {
+          acc0[p] += x0[n] * co[p];
+          acc1[p] += x1[n] * co[p];
+        }
+      }
+      std::copy(acc0.begin(), acc0.end(), out0 + i * upfold);
+      std::copy(acc1.begin(), acc1.end(), out1 + i * upfold);
     }
   }
 };
 
-template<typename Sample, typename Fir> class FirDownSampler {
-  std::array<std::array<Sample, Fir::bufferSize>, Fir::upfold> buf{{}};
+/**
+Polyphase FIR downsampler for 2 channels. History is a double length ring buffer for each
+phase, in the same way as `StereoFirPolyPhaseUpSampler`.
 
+This one is intentionally left scalar. Output is summed with a single accumulator over
+`[phase][tap]` in the original order, so that true peak renders stay bit exact. Splitting
+the sum into lanes would reorder the floating point additions. Only the upsampler is
+vectorized, because it is the one that runs `upfold` outputs per input sample.
+*/
+template<typename Sample, typename Fir> class StereoFirDownSampler {
 public:
-  void reset() { buf.fill({}); }
+  static constexpr size_t nTap = Fir::bufferSize;
+  static constexpr size_t upfold = Fir::upfold;
+
+private:
+  std::array<std::array<std::array<Sample, 2 * nTap>, upfold>, 2> buf{};
+  size_t wptr = 0;
 
-  Sample process(const std::array<Sample, Fir::upfold> &input)
+public:
+  void reset()
   {
-    for (size_t i = 0; i < Fir::upfold; ++i) {
-      std::rotate(buf[i].rbegin(), buf[i].rbegin() + 1, buf[i].rend());
-      buf[i][0] = input[i];
-    }
+    for (auto &bf : buf) bf.fill({});
+    wptr = 0;
+  }
 
-    Sample output = 0;
-    for (size_t i = 0; i < Fir::coefficient.size(); ++i) {
-      auto &&phase = Fir::coefficient[i];
-      for (size_t n = 0; n < phase.size(); ++n) output += buf[i][n] * phase[n];
+  // `in0` and `in1` have `length * upfold` samples.
+  void process(
+    size_t length, const Sample *in0, const Sample *in1, Sample *out0, Sample *out1)
+  {
+    for (size_t i = 0; i < length; ++i) {
+      wptr = wptr == 0 ? nTap - 1 : wptr - 1;
+      for (size_t p = 0; p < upfold; ++p) {
+        buf[0][p][wptr] = buf[0][p][wptr + nTap] = in0[i * upfold + p];
+        buf[1][p][wptr] = buf[1][p][wptr + nTap] = in1[i * upfold + p];
+      }
+
+      Sample acc0 = 0;
+      Sample acc1 = 0;
+      for (size_t p = 0; p < upfold; ++p) {
+        const auto &co = Fir::coefficient[p];
+        const Sample *x0 = buf[0][p].data() + wptr;
+        const Sample *x1 = buf[1][p].data() + wptr;
+        for (size_t n = 0; n < nTap; ++n) {
+          acc0 += x0[n] * co[n];
+          acc1 += x1[n] * co[n];
+        }
+      }
+      out0[i] = acc0;
+      out1[i] = acc1;
     }
-    return output;
   }
 };
 
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -51,6 +53,7 @@ protected:
 
   uint64_t lastState = 0;
   uint32_t wasBypassing = 0;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
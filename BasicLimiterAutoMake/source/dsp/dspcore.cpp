@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.5f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.5f);
 
   auto bufferSize
     = size_t(UpSamplerFir::upfold * maxAttackSeconds * this->sampleRate) + 1;
@@ -60,9 +60,9 @@ void DSPCore::reset()
   for (auto &lm : limiter) lm.reset(interpThreshold.getValue());
   for (auto &he : highEliminatorMain) he.reset();
   for (auto &he : highEliminatorSide) he.reset();
-  for (auto &us : upSamplerMain) us.reset();
-  for (auto &us : upSamplerSide) us.reset();
-  for (auto &ds : downSampler) ds.reset();
+  upSamplerMain.reset();
+  upSamplerSide.reset();
+  downSampler.reset();
 
   autoMakeUp.reset(
     pv[ID::autoMakeupToggle]->getInt(), pv[ID::limiterThreshold]->getFloat(),
@@ -132,7 +132,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   bool &&enableSidechain = pv[ID::sidechain]->getInt();
   const float *sidechain0 = enableSidechain ? in2 : in0;
@@ -145,45 +145,54 @@ void DSPCore::process(
   float makeUpTarget = pv[ID::autoMakeupTargetGain]->getFloat();
   if (pv[ID::truePeak]->getInt()) {
     constexpr size_t upfold = UpSamplerFir::upfold;
-    for (size_t i = 0; i < length; ++i) {
-      auto sig0 = in0[i];
-      auto sig1 = in1[i];
-      if (enableMidSide) convertToMidSide(sig0, sig1);
-
-      sig0 = highEliminatorMain[0].process(sig0);
-      sig1 = highEliminatorMain[1].process(sig1);
-      upSamplerMain[0].process(sig0);
-      upSamplerMain[1].process(sig1);
-
-      auto side0 = highEliminatorSide[0].process(sidechain0[i]);
-      auto side1 = highEliminatorSide[1].process(sidechain1[i]);
-      if (enableMidSide) convertToMidSide(side0, side1);
+    for (size_t start = 0; start < length; start += truePeakBlockSize) {
+      const size_t blockSize = std::min(truePeakBlockSize, length - start);
 
-      upSamplerSide[0].process(side0);
-      upSamplerSide[1].process(side1);
+      for (size_t i = 0; i < blockSize; ++i) {
+        auto sig0 = in0[start + i];
+        auto sig1 = in1[start + i];
+        if (enableMidSide) convertToMidSide(sig0, sig1);
 
-      auto threshold = interpThreshold.process();
-      for (size_t j = 0; j < upfold; ++j) {
-        auto &&sc0 = upSamplerSide[0].output[j];
-        auto &&sc1 = upSamplerSide[1].output[j];
-
-        auto &&inAbs = processStereoLink(sc0, sc1);
-        auto &&makeup = autoMakeUp.process(enableAutoMakeUp, threshold, makeUpTarget);
+        eliminated[0][i] = highEliminatorMain[0].process(sig0);
+        eliminated[1][i] = highEliminatorMain[1].process(sig1);
 
-        auto &&tp0 = upSamplerMain[0].output[j];
-        auto &&tp1 = upSamplerMain[1].output[j];
+        auto side0 = highEliminatorSide[0].process(sidechain0[start + i]);
+        auto side1 = highEliminatorSide[1].process(sidechain1[start + i]);
+        if (enableMidSide) convertToMidSide(side0, side1);
 
-        expanded[0][j] = makeup * limiter[0].process(tp0, inAbs[0], threshold);
-        expanded[1][j] = makeup * limiter[1].process(tp1, inAbs[1], threshold);
+        eliminated[2][i] = side0;
+        eliminated[3][i] = side1;
       }
 
-      sig0 = downSampler[0].process(expanded[0]);
-      sig1 = downSampler[1].process(expanded[1]);
+      upSamplerMain.process(
+        blockSize, eliminated[0].data(), eliminated[1].data(), expanded[0].data(),
+        expanded[1].data());
+      upSamplerSide.process(
+        blockSize, eliminated[2].data(), eliminated[3].data(), expandedSide[0].data(),
+        expandedSide[1].data());
+
+      for (size_t i = 0; i < blockSize; ++i) {
+        auto threshold = interpThreshold.process();
+        for (size_t j = i * upfold; j < (i + 1) * upfold; ++j) {
+          auto &&inAbs = processStereoLink(expandedSide[0][j], expandedSide[1][j]);
+          auto &&makeup = autoMakeUp.process(enableAutoMakeUp, threshold, makeUpTarget);
+
+          auto &tp0 = expanded[0][j];
+          auto &tp1 = expanded[1][j];
+
+          tp0 = makeup * limiter[0].process(tp0, inAbs[0], threshold);
+          tp1 = makeup * limiter[1].process(tp1, inAbs[1], threshold);
+        }
+      }
 
-      if (enableMidSide) convertToLeftRight(sig0, sig1);
+      downSampler.process(
+        blockSize, expanded[0].data(), expanded[1].data(), out0 + start, out1 + start);
 
-      out0[i] = sig0;
-      out1[i] = sig1;
+      if (enableMidSide) {
+        for (size_t i = start; i < start + blockSize; ++i) {
+          convertToLeftRight(out0[i], out1[i]);
+        }
+      }
     }
   } else {
     for (size_t i = 0; i < length; ++i) {
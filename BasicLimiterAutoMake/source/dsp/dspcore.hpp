@@ -41,17 +41,23 @@ public:
 private:
   std::array<float, 2> processStereoLink(float in0, float in1);
 
+  static constexpr size_t truePeakBlockSize = 64;
+  static constexpr size_t expandedSize = UpSamplerFir::upfold * truePeakBlockSize;
+
   float sampleRate = 44100.0f;
-  std::array<std::array<float, UpSamplerFir::upfold>, 2> expanded{};
+  SmootherContext<float> smootherContext;
+  std::array<std::array<float, truePeakBlockSize>, 4> eliminated{};
+  std::array<std::array<float, expandedSize>, 2> expanded{};
+  std::array<std::array<float, expandedSize>, 2> expandedSide{};
 
-  ExpSmoother<float> interpStereoLink;
-  ExpSmoother<float> interpThreshold;
+  ExpSmoother<float> interpStereoLink{smootherContext};
+  ExpSmoother<float> interpThreshold{smootherContext};
 
   std::array<Limiter<float>, 2> limiter;
   std::array<NaiveConvolver<float, HighEliminationFir<float>>, 2> highEliminatorMain;
   std::array<NaiveConvolver<float, HighEliminationFir<float>>, 2> highEliminatorSide;
-  std::array<FirPolyPhaseUpSampler<float, UpSamplerFir>, 2> upSamplerMain;
-  std::array<FirPolyPhaseUpSampler<float, UpSamplerFir>, 2> upSamplerSide;
-  std::array<FirDownSampler<float, DownSamplerFir>, 2> downSampler;
+  StereoFirPolyPhaseUpSampler<float, UpSamplerFir> upSamplerMain;
+  StereoFirPolyPhaseUpSampler<float, UpSamplerFir> upSamplerSide;
+  StereoFirDownSampler<float, DownSamplerFir> downSampler;
   AutoMakeUp<float> autoMakeUp;
 };
@@ -74,20 +74,7 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
   using ID = ParameterID::ID;
 
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
-    }
-  }
+  processDriver.prepare(data, dsp.param);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -113,6 +100,7 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   auto isBypassing = dsp.param.value[ParameterID::bypass]->getInt();
   if (isBypassing) {
     if (!wasBypassing) dsp.reset();
+    processDriver.flush(dsp.param);
     processBypass(data);
   } else {
     float *in0 = data.inputs[0].channelBuffers32[0];
@@ -124,7 +112,13 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 
     float *out0 = data.outputs[0].channelBuffers32[0];
     float *out1 = data.outputs[0].channelBuffers32[1];
-    dsp.process((size_t)data.numSamples, in0, in1, in2, in3, out0, out1);
+    processDriver.process(
+      data.numSamples, dsp.param, [&]() { dsp.setParameters(); },
+      [&](int32 offset, int32 length) {
+        dsp.process(
+          size_t(length), in0 + offset, in1 + offset, in2 + offset, in3 + offset,
+          out0 + offset, out1 + offset);
+      });
   }
   wasBypassing = isBypassing;
 
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#define SET_PARAMETERS dsp->setParameters();
+
+#include "../../test/bench.hpp"
+#include "../source/dsp/dspcore.hpp"
+
+// CMake provides this macro, but just in case.
+#ifndef UHHYOU_PLUGIN_NAME
+  #define UHHYOU_PLUGIN_NAME "BasicLimiterAutoMake"
+#endif
+
+int main(int argc, char **argv)
+{
+  return runBench<DSPCore>(
+    argc, argv, UHHYOU_PLUGIN_NAME,
+    [](auto &dsp, size_t frame, size_t length, auto &in, auto &out) {
+      dsp.process(
+        length, in[0].data() + frame, in[1].data() + frame, in[0].data() + frame,
+        in[1].data() + frame, out[0].data() + frame, out[1].data() + frame);
+    });
+}
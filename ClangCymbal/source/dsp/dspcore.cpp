@@ -38,7 +38,30 @@ inline float semitoneToNormalizedFreq(
 
 DSPCore::DSPCore() {}
 
-Note::Note()
+Note::Note(const SmootherContext<float> &context)
+  : modEnvelopeToFdnPitch(context)
+  , modEnvelopeToFdnOvertoneAdd(context)
+  , modEnvelopeToOscJitter(context)
+  , modEnvelopeToOscNoisePulseRatio(context)
+  , oscBounce(context)
+  , oscBounceCurve(context)
+  , oscJitter(context)
+  , oscDensity(context)
+  , oscPulseAmpRandomness(context)
+  , oscNoisePulseRatio(context)
+  , fdnFreqOffset(context)
+  , fdnOvertoneOffset(context)
+  , fdnOvertoneMul(context)
+  , fdnOvertoneAdd(context)
+  , fdnOvertoneModulo(context)
+  , fdnFeedback(context)
+  , tremoloMix(context)
+  , tremoloDepth(context)
+  , tremoloDelayTime(context)
+  , tremoloModToDelayTimeOffset(context)
+  , tremoloModDeltaPhase(context)
+  , oscLowpass(context)
+  , fdn(context)
 {
   fdnMatrixRandomBase.resize(fdnMatrixSize);
   for (size_t i = 0; i < fdnMatrixRandomBase.size(); ++i) {
@@ -61,7 +84,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = float(sampleRate);
   upRate = upFold * this->sampleRate;
 
-  SmootherCommon<float>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   // 10 msec + 1 sample transition time.
   transitionBuffer.resize(1 + size_t(upRate * double(0.005)), float(0));
@@ -389,9 +412,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<float>::setTime(pv[ID::commonSmoothingTimeSecond]->getFloat());
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setTime(pv[ID::commonSmoothingTimeSecond]->getFloat());
+  smootherContext.setBufferSize(float(length));
 
   bool overSampling = pv[ID::overSampling]->getInt();
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
@@ -78,7 +79,7 @@ public:
   NoteState state = NoteState::rest;
   int_fast32_t id = -1;
 
-  Note();
+  explicit Note(const SmootherContext<float> &context);
   void setup(float sampleRate);
   void reset(float sampleRate, GlobalParameter &param);
   void setParameters(float sampleRate, GlobalParameter &param);
@@ -120,7 +121,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -137,21 +138,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocityMap.map(velocity);
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -166,11 +163,12 @@ private:
 
   static constexpr size_t upFold = 2;
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float upRate = 88200.0f;
   DecibelScale<float> velocityMap{-60, 0, true};
 
-  Note note;
-  ExpSmoother<float> interpMasterGain;
+  Note note{smootherContext};
+  ExpSmoother<float> interpMasterGain{smootherContext};
 
   std::array<float, 2> halfIn{{}};
   HalfBandIIR<float, HalfBandCoefficient<float>> halfbandIir;
@@ -136,6 +136,11 @@ public:
   ParallelSVF<Sample, length> lowpass;
   ParallelSVF<Sample, length> highpass;
 
+  explicit FeedbackDelayNetwork(const SmootherContext<Sample> &context)
+    : lowpass(context), highpass(context)
+  {
+  }
+
   /**
   If `identityAmount` is close to 0, then the result becomes close to identity matrix.
 
@@ -39,7 +39,11 @@ private:
   ExpSmoother<float> kSmoother;
 
 public:
-  GenericSVF() { static_assert(type <= 5, "SVF type must be less than or equal to 5."); }
+  explicit GenericSVF(const SmootherContext<float> &context)
+    : gSmoother(context), kSmoother(context)
+  {
+    static_assert(type <= 5, "SVF type must be less than or equal to 5.");
+  }
 
   // normalizedFreq = cutoffHz / sampleRate.
   void pushCutoff(Sample normalizedFreq, Sample Q)
@@ -103,6 +107,12 @@ private:
   std::array<ExpSmoother<Sample>, length> k;
 
 public:
+  explicit ParallelSVF(const SmootherContext<Sample> &context)
+    : g(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+    , k(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+  {
+  }
+
   void pushCutoffAt(size_t index, Sample normalizedFreq, Sample Q)
   {
     g[index].push(std::tan(std::clamp(normalizedFreq, minCutoff, nyquist) * Sample(pi)));
@@ -169,6 +169,7 @@ struct GlobalParameter : public ParameterInterface {
   GlobalParameter()
   {
     value.resize(ParameterID::ID_ENUM_LENGTH);
+    changed.resize(ParameterID::ID_ENUM_LENGTH);
 
     using Info = Vst::ParameterInfo;
     using ID = ParameterID::ID;
@@ -391,9 +392,15 @@ struct GlobalParameter : public ParameterInterface {
   tresult setState(IBStream *stream)
   {
     IBStreamer streamer(stream, kLittleEndian);
-    for (auto &val : value)
-      if (val->setState(streamer)) return kResultFalse;
-    return kResultOk;
+    tresult result = kResultOk;
+    for (auto &val : value) {
+      if (val->setState(streamer)) {
+        result = kResultFalse;
+        break;
+      }
+    }
+    changed.postMarkAll();
+    return result;
   }
 
   tresult getState(IBStream *stream)
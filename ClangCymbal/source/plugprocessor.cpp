@@ -66,20 +66,7 @@ tresult PLUGIN_API PlugProcessor::setActive(TBool state)
 
 tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
-    }
-  }
+  processDriver.prepare(data, dsp.param);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -97,38 +84,36 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   if (!dsp.isInitialized) return kNotInitialized;
 
   dsp.setParameters();
-  if (data.inputEvents != nullptr) handleEvent(data);
 
   float *out0 = data.outputs[0].channelBuffers32[0];
   float *out1 = data.outputs[0].channelBuffers32[1];
-  size_t length = data.numSamples < 0 ? 0 : size_t(data.numSamples);
-  dsp.process(length, out0, out1);
+  processDriver.process(
+    data.numSamples, dsp.param, [&]() { dsp.setParameters(); },
+    [&](Vst::Event &event) { handleEvent(event); },
+    [&](int32 offset, int32 length) {
+      dsp.process(size_t(length), out0 + offset, out1 + offset);
+    });
 
   return kResultOk;
 }
 
-void PlugProcessor::handleEvent(Vst::ProcessData &data)
+void PlugProcessor::handleEvent(Vst::Event &event)
 {
-  for (int32 index = 0; index < data.inputEvents->getEventCount(); ++index) {
-    Vst::Event event;
-    if (data.inputEvents->getEvent(index, event) != kResultOk) continue;
-    switch (event.type) {
-      case Vst::Event::kNoteOnEvent: {
-        auto noteId
-          = event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId;
-        dsp.pushMidiNote(
-          true, event.sampleOffset, noteId, event.noteOn.pitch, event.noteOn.tuning,
-          event.noteOn.velocity);
-      } break;
-
-      case Vst::Event::kNoteOffEvent: {
-        auto noteId
-          = event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId;
-        dsp.pushMidiNote(false, event.sampleOffset, noteId, 0, 0, 0);
-      } break;
-
-        // Add other event type here.
-    }
+  switch (event.type) {
+    case Vst::Event::kNoteOnEvent: {
+      auto noteId = event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId;
+      dsp.pushMidiNote(
+        true, event.sampleOffset, noteId, event.noteOn.pitch, event.noteOn.tuning,
+        event.noteOn.velocity);
+    } break;
+
+    case Vst::Event::kNoteOffEvent: {
+      auto noteId
+        = event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId;
+      dsp.pushMidiNote(false, event.sampleOffset, noteId, 0, 0, 0);
+    } break;
+
+      // Add other event type here.
   }
 }
 
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -39,9 +41,10 @@ public:
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
 protected:
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#define SET_PARAMETERS dsp->setParameters();
+
+#include "../../test/bench.hpp"
+#include "../source/dsp/dspcore.hpp"
+
+// CMake provides this macro, but just in case.
+#ifndef UHHYOU_PLUGIN_NAME
+  #define UHHYOU_PLUGIN_NAME "ClangCymbal"
+#endif
+
+int main(int argc, char **argv)
+{
+  return runBench<DSPCore>(
+    argc, argv, UHHYOU_PLUGIN_NAME,
+    [](auto &dsp, size_t frame, size_t length, auto &, auto &out) {
+      dsp.process(length, out[0].data() + frame, out[1].data() + frame);
+    },
+    [](auto &dsp, size_t frame, const NoteEvent &note) {
+      dsp.pushMidiNote(
+        note.type == NoteEventType::noteOn, uint32_t(frame), note.id, note.pitch,
+        note.tuning, note.velocity);
+    });
+}
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-only
 // Copyright Takamitsu Endo (ryukau@gmail.com)
 
+#include "../../../common/trace.hpp"
 #include "../../../lib/juce_ScopedNoDenormal.hpp"
 
 #include "dspcore.hpp"
@@ -34,6 +35,8 @@ DSPCore::DSPCore()
   unisonPan.reserve(maximumVoice);
   noteIndices.reserve(maximumVoice);
   voiceIndices.reserve(maximumVoice);
+
+  info.wavetable = &wavetable.front();
 }
 
 void Note::setup(float sampleRate) { fdn.setup(sampleRate, maxDelayTime); }
@@ -43,7 +46,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = float(sampleRate);
   upRate = upFold * this->sampleRate;
 
-  SmootherCommon<float>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   info.synchronizer.reset(upRate, defaultTempo, float(1));
   info.smootherKp = float(EMAFilter<double>::cutoffToP(sampleRate, 100));
@@ -54,6 +57,7 @@ void DSPCore::setup(double sampleRate)
   for (auto &note : notes) note.setup(upRate);
 
   reset();
+  prepareRefresh = true;
 }
 
 #define SET_NOTE_FILTER_CUTOFF(METHOD)                                                   \
@@ -184,25 +188,50 @@ void DSPCore::setParameters()
     note.setParameters(upRate, info, param);
   }
 
-  if (prepareRefresh || (!isWavetableRefeshed && pv[ID::refreshWavetable]->getInt())) {
-    info.wavetable.param.denominatorSlope
-      = pv[ID::oscSpectrumDenominatorSlope]->getFloat();
-    info.wavetable.param.rotationSlope = pv[ID::oscSpectrumRotationSlope]->getFloat();
-    info.wavetable.param.rotationOffset = pv[ID::oscSpectrumRotationOffset]->getFloat();
-    info.wavetable.param.interval = 1 + pv[ID::oscSpectrumInterval]->getInt();
-    info.wavetable.param.highpassIndex = pv[ID::oscSpectrumHighpass]->getInt();
-    info.wavetable.param.blur = pv[ID::oscSpectrumBlur]->getFloat();
-    for (size_t idx = 0; idx < oscOvertoneSize; ++idx) {
-      info.wavetable.param.overtoneAmp[idx] = std::polar(
-        pv[ID::oscOvertone0 + idx]->getFloat(),
-        float(pi) * pv[ID::oscRotation0 + idx]->getFloat());
-    }
-    info.wavetable.fillTable(upRate);
+  // The first table after `setup()` is built here, as the preset is loaded after it.
+  if (prepareRefresh) {
+    wavetable.reset(getWavetableInput());
+    info.wavetable = &wavetable.front();
+  } else if (!isWavetableRefeshed && pv[ID::refreshWavetable]->getInt()) {
+    wavetable.request(getWavetableInput());
   }
   isWavetableRefeshed = pv[ID::refreshWavetable]->getInt();
   prepareRefresh = false;
 }
 
+OscWavetableInput DSPCore::getWavetableInput()
+{
+  using ID = ParameterID::ID;
+  auto &pv = param.value;
+
+  OscWavetableInput input;
+  input.upRate = upRate;
+  input.denominatorSlope = pv[ID::oscSpectrumDenominatorSlope]->getFloat();
+  input.rotationSlope = pv[ID::oscSpectrumRotationSlope]->getFloat();
+  input.rotationOffset = pv[ID::oscSpectrumRotationOffset]->getFloat();
+  input.interval = 1 + pv[ID::oscSpectrumInterval]->getInt();
+  input.highpassIndex = pv[ID::oscSpectrumHighpass]->getInt();
+  input.blur = pv[ID::oscSpectrumBlur]->getFloat();
+  for (size_t idx = 0; idx < oscOvertoneSize; ++idx) {
+    input.overtoneAmp[idx] = std::polar(
+      pv[ID::oscOvertone0 + idx]->getFloat(),
+      float(pi) * pv[ID::oscRotation0 + idx]->getFloat());
+  }
+  return input;
+}
+
+void DSPCore::buildWavetable(OscWavetable &table, const OscWavetableInput &input)
+{
+  table.param.denominatorSlope = input.denominatorSlope;
+  table.param.rotationSlope = input.rotationSlope;
+  table.param.rotationOffset = input.rotationOffset;
+  table.param.interval = input.interval;
+  table.param.highpassIndex = input.highpassIndex;
+  table.param.blur = input.blur;
+  table.param.overtoneAmp = input.overtoneAmp;
+  table.fillTable(input.upRate);
+}
+
 inline float alignModValue(float amount, float alignment, float value)
 {
   if (alignment == 0) return amount * value;
@@ -239,7 +268,7 @@ std::array<float, 2> Note::process(float sampleRate, NoteProcessInfo &info)
   auto oscGain = envelope.process() * velocity;
   if (oscGain >= eps) {
     auto nt = oscPitchMod + oscNote + info.oscNoteOffset.getValue();
-    sig += oscGain * osc.process(sampleRate, nt, info.wavetable);
+    sig += oscGain * osc.process(sampleRate, nt, *info.wavetable);
   }
 
   if (info.fdnEnable) {
@@ -295,8 +324,13 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<float>::setTime(pv[ID::smoothingTimeSecond]->getFloat());
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setTime(pv[ID::smoothingTimeSecond]->getFloat());
+  smootherContext.setBufferSize(float(length));
+
+  if (wavetable.update()) {
+    info.wavetable = &wavetable.front();
+    wavetable.release();
+  }
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -346,6 +380,8 @@ void Note::noteOn(
   NoteProcessInfo &info,
   GlobalParameter &param)
 {
+  UHHYOU_TRACE_SCOPE("noteOn");
+
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
@@ -374,12 +410,16 @@ void Note::noteOn(
     sampleRate * pv[ID::oscDecay]->getFloat());
 
   // FDN matrix.
-  std::uniform_int_distribution<unsigned> seedDist{
-    0, std::numeric_limits<unsigned>::max()};
+  {
+    UHHYOU_TRACE_SCOPE("randomOrthogonal");
 
-  fdn.randomOrthogonal(
-    seedDist(info.fdnRng), pv[ID::fdnMatrixIdentityAmount]->getFloat(),
-    pv[ID::fdnRandomizeRatio]->getFloat(), info.fdnMatrixRandomBase);
+    std::uniform_int_distribution<unsigned> seedDist{
+      0, std::numeric_limits<unsigned>::max()};
+
+    fdn.randomOrthogonal(
+      seedDist(info.fdnRng), pv[ID::fdnMatrixIdentityAmount]->getFloat(),
+      pv[ID::fdnRandomizeRatio]->getFloat(), info.fdnMatrixRandomBase);
+  }
 
   // FDN delay.
   fdn.delay.rate = pv[ID::fdnInterpRate]->getFloat();
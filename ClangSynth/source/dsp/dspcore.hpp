@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "../../../common/backgroundjob.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
@@ -15,11 +17,25 @@
 
 #include <array>
 #include <cmath>
+#include <complex>
 #include <random>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
 
+using OscWavetable = Wavetable<float, oscOvertoneSize>;
+
+struct OscWavetableInput {
+  float upRate = 88200.0f;
+  float denominatorSlope = float(1);
+  float rotationSlope = 0;
+  float rotationOffset = 0;
+  float blur = float(1);
+  size_t interval = 1;
+  size_t highpassIndex = 0;
+  std::array<std::complex<float>, oscOvertoneSize> overtoneAmp{};
+};
+
 constexpr float minOscNoteOffsetRate = float(9.5); // ~= 12 * log2(sqrt(3)).
 
 inline float calcNotePitch(float note, float equalTemperament = 12.0f)
@@ -48,8 +64,8 @@ enum class NoteState { active, release, rest };
                                                                                                     \
   fdnEnable = pv[ID::fdnEnable]->getInt();                                                          \
                                                                                                     \
-  oscNoteOffsetRate = SmootherCommon<float>::timeInSamples >= 1                                     \
-    ? minOscNoteOffsetRate / SmootherCommon<float>::timeInSamples                                   \
+  oscNoteOffsetRate = smootherContext.timeInSamples >= 1                                            \
+    ? minOscNoteOffsetRate / smootherContext.timeInSamples                                          \
     : minOscNoteOffsetRate;                                                                         \
                                                                                                     \
   eqTemp = pv[ID::equalTemperament]->getFloat() + float(1);                                         \
@@ -89,10 +105,12 @@ enum class NoteState { active, release, rest };
   modEnvelopeToFdnOvertoneAdd.METHOD(pv[ID::modEnvelopeToFdnOvertoneAdd]->getFloat());
 
 struct NoteProcessInfo {
+  const SmootherContext<float> &smootherContext;
+
   pcg64 fdnRng;
   uint32_t previousSeed = 0;
   std::vector<std::vector<float>> fdnMatrixRandomBase;
-  Wavetable<float, oscOvertoneSize> wavetable;
+  const OscWavetable *wavetable = nullptr; // Front of `DSPCore::wavetable`.
 
   TableLFO<float, nLfoWavetable, 1024, TableLFOType::lfo> lfo;
   TableLFO<float, nModEnvelopeWavetable + 1, 1024, TableLFOType::envelope> envelope;
@@ -123,7 +141,23 @@ struct NoteProcessInfo {
   ExpSmoother<float> modEnvelopeToFdnPitch;
   ExpSmoother<float> modEnvelopeToFdnOvertoneAdd;
 
-  NoteProcessInfo()
+  explicit NoteProcessInfo(const SmootherContext<float> &context)
+    : smootherContext(context)
+    , fdnFreqOffset(context)
+    , fdnOvertoneOffset(context)
+    , fdnOvertoneMul(context)
+    , fdnOvertoneAdd(context)
+    , fdnOvertoneModulo(context)
+    , fdnLowpassQ(context)
+    , fdnHighpassQ(context)
+    , fdnFeedback(context)
+    , lfoToOscPitchAmount(context)
+    , lfoToFdnPitchAmount(context)
+    , modEnvelopeToFdnLowpassCutoff(context)
+    , modEnvelopeToFdnHighpassCutoff(context)
+    , modEnvelopeToOscPitch(context)
+    , modEnvelopeToFdnPitch(context)
+    , modEnvelopeToFdnOvertoneAdd(context)
   {
     fdnMatrixRandomBase.resize(fdnMatrixSize);
     for (size_t i = 0; i < fdnMatrixRandomBase.size(); ++i) {
@@ -256,7 +290,7 @@ public:
   float tempo = 120.0f;
   double beatsElapsed = 0.0f;
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   DSPCore();
 
@@ -284,31 +318,31 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
   float getTempoSyncInterval();
+  OscWavetableInput getWavetableInput();
+
+  static void buildWavetable(OscWavetable &table, const OscWavetableInput &input);
 
   static constexpr size_t upFold = 2;
   bool prepareRefresh = true;
   bool isWavetableRefeshed = false;
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float upRate = 88200.0f;
   DecibelScale<float> velocityMap{-60, 0, true};
 
@@ -319,8 +353,12 @@ private:
   std::vector<float> unisonPan;
   std::array<Note, maximumVoice> notes;
 
-  NoteProcessInfo info;
-  ExpSmoother<float> interpMasterGain;
+  NoteProcessInfo info{smootherContext};
+  ExpSmoother<float> interpMasterGain{smootherContext};
+
+  // Refresh requested from GUI is built on background thread, and swapped at the start of
+  // `process()`.
+  BackgroundDoubleBuffer<OscWavetable, OscWavetableInput> wavetable{buildWavetable};
 
   std::array<std::array<float, 2>, 2> halfIn{{}};
   std::array<HalfBandIIR<float, HalfBandCoefficient<float>>, 2> halfbandIir;
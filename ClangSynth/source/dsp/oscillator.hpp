@@ -3,10 +3,8 @@
 
 #pragma once
 
-#define POCKETFFT_NO_MULTITHREADING
-#include "../../../lib/pocketfft/pocketfft_hdronly.h"
-
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/fft/realfft.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -16,55 +14,6 @@
 
 namespace SomeDSP {
 
-template<typename T> class PocketFFT {
-public:
-  pocketfft::shape_t shape;
-  pocketfft::stride_t strideR;
-  pocketfft::stride_t strideC;
-  pocketfft::shape_t axes;
-  size_t ndata = 1;
-
-  void setShape(pocketfft::shape_t _shape)
-  {
-    shape = _shape;
-
-    strideR.resize(shape.size());
-    strideC.resize(shape.size());
-
-    size_t tmpR = sizeof(T);
-    size_t tmpC = sizeof(std::complex<T>);
-    for (int i = int(shape.size()) - 1; i >= 0; --i) {
-      strideR[i] = tmpR;
-      tmpR *= shape[i];
-      strideC[i] = tmpC;
-      tmpC *= shape[i];
-    }
-
-    ndata = 1;
-    for (const auto &shp : shape) ndata *= shp;
-
-    axes.resize(shape.size());
-    for (size_t i = 0; i < axes.size(); ++i) axes[i] = i;
-  }
-
-  void setShape1D(size_t size)
-  {
-    pocketfft::shape_t _shape{size};
-    setShape(_shape);
-  }
-
-  void r2c(const T *data_in, std::complex<T> *data_out, bool forward = true, T scale = 1)
-  {
-    pocketfft::r2c(shape, strideR, strideC, axes, forward, data_in, data_out, scale);
-  }
-
-  void c2r(const std::complex<T> *data_in, T *data_out, bool forward = false, T scale = 1)
-  {
-    pocketfft::c2r(
-      shape, strideC, strideR, axes, forward, data_in, data_out, scale / ndata);
-  }
-};
-
 template<typename Sample, size_t nOvertone> struct WavetableParameter {
   std::array<std::complex<Sample>, nOvertone> overtoneAmp{};
   std::vector<std::complex<Sample>> source;
@@ -101,7 +50,7 @@ private:
   };
 
   std::vector<std::complex<Sample>> fullSpectrum;
-  PocketFFT<Sample> fft;
+  RealFFT<Sample> fft;
 
   void generateSpectrum(size_t spectrumSize)
   {
@@ -176,7 +125,7 @@ public:
 
     generateSpectrum(nFreq + 1);
 
-    fft.setShape1D(bufSize);
+    fft.setup(bufSize);
 
     size_t nTable = size_t(std::log(Sample(nFreq)) / std::log(bendRange));
     maxIdx = Sample(nTable - 1);
@@ -192,7 +141,7 @@ public:
       std::copy(fullSpectrum.begin(), fullSpectrum.begin() + cutoff, destSpc.begin());
 
       table[idx].resize(bufSize + 1);
-      fft.c2r(destSpc.data(), table[idx].data());
+      fft.inverse(destSpc.data(), table[idx].data());
       table[idx].back() = table[idx][0];
     }
     table.back().resize(bufSize + 1);
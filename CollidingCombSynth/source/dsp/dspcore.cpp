@@ -169,8 +169,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.01f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.01f);
 
   // 10 msec + 1 sample transition time.
   transitionBuffer.resize(1 + size_t(this->sampleRate * 0.005), {0.0f, 0.0f});
@@ -237,7 +237,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   std::array<float, 2> frame{};
   for (uint32_t i = 0; i < length; ++i) {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
@@ -36,6 +37,14 @@ struct NoteProcessInfo {
   ExpSmoother<float> noiseGain;
   ExpSmoother<float> propagation;
 
+  explicit NoteProcessInfo(const SmootherContext<float> &context)
+    : lowpassCutoff(context)
+    , highpassCutoff(context)
+    , noiseGain(context)
+    , propagation(context)
+  {
+  }
+
   void reset(GlobalParameter &param)
   {
     using ID = ParameterID::ID;
@@ -129,7 +138,7 @@ public:
   void noteOff(int32_t noteId);
   void fillTransitionBuffer(size_t noteIndex);
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -146,21 +155,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(uint32_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -168,6 +173,7 @@ private:
   void setUnisonPan(size_t nUnison);
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float velocity = 0.0f;
   DecibelScale<float> velocityMap{-30, 0, true};
 
@@ -177,8 +183,8 @@ private:
   std::vector<float> unisonPan;
   std::array<Note, maxVoice> notes;
 
-  NoteProcessInfo info;
-  ExpSmoother<float> interpMasterGain;
+  NoteProcessInfo info{smootherContext};
+  ExpSmoother<float> interpMasterGain{smootherContext};
 
   std::vector<std::array<float, 2>> transitionBuffer{};
   bool isTransitioning = false;
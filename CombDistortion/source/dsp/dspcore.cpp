@@ -17,19 +17,29 @@ void DSPCore::setup(double sampleRate)
 
   pitchSmoothingKp = EMAFilter<double>::secondToP(upRate, double(0.05));
 
-  for (auto &dly : feedbackDelay) dly.setup(this->sampleRate * upFold, maxDelayTime);
+  const auto maxFold = isOffline ? offlineFold : upFold;
+  for (auto &dly : feedbackDelay) dly.setup(this->sampleRate * maxFold * maxDelayTime);
+
+  for (auto &os : offlineOversampler) {
+    os.setup(1);
+    os.set(offlineFold, OversamplingQuality::fir);
+  }
 
   reset();
   startup();
 }
 
-size_t DSPCore::getLatency() { return 0; }
+size_t DSPCore::getLatency()
+{
+  return useOfflineOversampler() ? size_t(std::lround(offlineOversampler[0].latency()))
+                                 : 0;
+}
 
 #define ASSIGN_PARAMETER(METHOD)                                                         \
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   pitchReleaseKp                                                                         \
     = EMAFilter<double>::secondToP(upRate, pv[ID::noteReleaseSeconds]->getDouble());     \
@@ -58,9 +68,10 @@ size_t DSPCore::getLatency() { return 0; }
 void DSPCore::updateUpRate()
 {
   constexpr std::array<size_t, 3> fold{1, upFold, upFold};
-  upRate = double(sampleRate) * fold[oversampling];
+  const auto activeFold = useOfflineOversampler() ? offlineFold : fold[oversampling];
+  upRate = double(sampleRate) * activeFold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 }
 
 void DSPCore::reset()
@@ -84,6 +95,7 @@ void DSPCore::reset()
   for (auto &x : feedbackDelay) x.reset();
   for (auto &x : decimationLowpass) x.reset();
   for (auto &x : halfbandIir) x.reset();
+  for (auto &x : offlineOversampler) x.reset();
 
   startup();
 }
@@ -151,19 +163,38 @@ std::array<double, 2> DSPCore::processFrame(const std::array<double, 2> &frame)
   };
 }
 
+template<typename Sample>
 void DSPCore::process(
-  const size_t length, const float *in0, const float *in1, float *out0, float *out1)
+  const size_t length, const Sample *in0, const Sample *in1, Sample *out0, Sample *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
+    if (useOfflineOversampler()) {
+      const double x0 = in0[i];
+      const double x1 = in1[i];
+      auto up0 = offlineOversampler[0].up(&x0, 1);
+      auto up1 = offlineOversampler[1].up(&x1, 1);
+      for (size_t j = 0; j < offlineFold; ++j) {
+        auto frame = processFrame({up0[j], up1[j]});
+        up0[j] = frame[0];
+        up1[j] = frame[1];
+      }
+      double y0, y1;
+      offlineOversampler[0].down(&y0, 1);
+      offlineOversampler[1].down(&y1, 1);
+      out0[i] = Sample(y0);
+      out1[i] = Sample(y1);
+      continue;
+    }
+
     upSampler[0].process(in0[i]);
     upSampler[1].process(in1[i]);
 
@@ -197,6 +228,11 @@ void DSPCore::process(
   }
 }
 
+template void DSPCore::process<float>(
+  const size_t, const float *, const float *, float *, float *);
+template void DSPCore::process<double>(
+  const size_t, const double *, const double *, double *, double *);
+
 void DSPCore::noteOn(NoteInfo &info)
 {
   using ID = ParameterID::ID;
@@ -4,8 +4,11 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/delay.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/lfo.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/multirate/oversampler.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "filter.hpp"
@@ -23,13 +26,10 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
+  bool isOffline = false; // Set before `setup`. Uses `offlineOversampler` if true.
   bool isPlaying = false;
   float tempo = 120.0f;
   double beatsElapsed = 0.0f;
@@ -41,8 +41,13 @@ public:
   void startup();
   size_t getLatency();
   void setParameters();
+  template<typename Sample>
   void process(
-    const size_t length, const float *in0, const float *in1, float *out0, float *out1);
+    const size_t length,
+    const Sample *in0,
+    const Sample *in1,
+    Sample *out0,
+    Sample *out1);
   void noteOn(NoteInfo &info);
   void noteOff(int_fast32_t noteId);
 
@@ -60,21 +65,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -83,12 +84,16 @@ private:
   std::array<double, 2> processFrame(const std::array<double, 2> &input);
   double calcNotePitch(double note, double scale, double equalTemperament = 12);
 
+  bool useOfflineOversampler() const { return isOffline && oversampling != 0; }
+
   static constexpr size_t upFold = 16;
+  static constexpr size_t offlineFold = 32;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100;
 
   double pitchSmoothingKp = 1;
@@ -96,17 +101,17 @@ private:
   ExpSmootherLocal<double> notePitchToDelayTime;
   DoubleEMAFilter<double> notePitchToDelayTimeRelease;
 
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> mix;
-  ExpSmoother<double> feedback;
-  ExpSmoother<double> feedbackHighpassKp;
-  ExpSmoother<double> feedbackLowpassKp;
-  ExpSmoother<double> delayTimeSamples;
-  ExpSmoother<double> amMix;
-  ExpSmoother<double> amClipGain;
-  ExpSmoother<double> fmMix;
-  ExpSmoother<double> fmAmount;
-  ExpSmoother<double> fmClip;
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> mix{smootherContext};
+  ExpSmoother<double> feedback{smootherContext};
+  ExpSmoother<double> feedbackHighpassKp{smootherContext};
+  ExpSmoother<double> feedbackLowpassKp{smootherContext};
+  ExpSmoother<double> delayTimeSamples{smootherContext};
+  ExpSmoother<double> amMix{smootherContext};
+  ExpSmoother<double> amClipGain{smootherContext};
+  ExpSmoother<double> fmMix{smootherContext};
+  ExpSmoother<double> fmAmount{smootherContext};
+  ExpSmoother<double> fmClip{smootherContext};
 
   size_t oversampling = 2;
 
@@ -118,4 +123,5 @@ private:
   std::array<Delay<double>, 2> feedbackDelay;
   std::array<DecimationLowpass<double, Sos16FoldFirstStage<double>>, 2> decimationLowpass;
   std::array<HalfBandIIR<double, HalfBandCoefficient<double>>, 2> halfbandIir;
+  std::array<Oversampler<double>, 2> offlineOversampler;
 };
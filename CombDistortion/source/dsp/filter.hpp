@@ -21,43 +21,4 @@ public:
   }
 };
 
-template<typename Sample> class Delay {
-public:
-  int wptr = 0;
-  std::vector<Sample> buf;
-
-  void setup(Sample sampleRate, Sample maxTime)
-  {
-    auto size = size_t(sampleRate * maxTime) + 2;
-    buf.resize(size < 4 ? 4 : size);
-
-    reset();
-  }
-
-  void reset() { std::fill(buf.begin(), buf.end(), Sample(0)); }
-
-  Sample process(Sample input, Sample timeInSample)
-  {
-    const int size = int(buf.size());
-
-    // Set delay time.
-    Sample clamped = std::clamp(timeInSample, Sample(0), Sample(size - 1));
-    int timeInt = int(clamped);
-    Sample rFraction = clamped - Sample(timeInt);
-
-    int rptr0 = wptr - timeInt;
-    if (rptr0 < 0) rptr0 += size;
-
-    int rptr1 = rptr0 - 1;
-    if (rptr1 < 0) rptr1 += size;
-
-    // Write to buffer.
-    buf[wptr] = input;
-    if (++wptr >= size) wptr -= size;
-
-    // Read from buffer.
-    return buf[rptr0] + rFraction * (buf[rptr1] - buf[rptr0]);
-  }
-};
-
 } // namespace SomeDSP
@@ -17,6 +17,20 @@ Editor::Editor(void *controller) : PlugEditor(controller)
   param = std::make_unique<Synth::GlobalParameter>();
 }
 
+void Editor::valueChanged(CControl *pControl)
+{
+  ParamID tag = pControl->getTag();
+
+  switch (tag) {
+    case Synth::ParameterID::ID::oversampling:
+      controller->getComponentHandler()->restartComponent(kLatencyChanged);
+  }
+
+  ParamValue value = pControl->getValueNormalized();
+  controller->setParamNormalized(tag, value);
+  controller->performEdit(tag, value);
+}
+
 bool Editor::prepareUI()
 {
   using ID = Synth::ParameterID::ID;
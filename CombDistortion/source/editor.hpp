@@ -15,6 +15,8 @@ class Editor : public PlugEditor {
 public:
   Editor(void *controller);
 
+  void valueChanged(CControl *pControl) override;
+
   DELEGATE_REFCOUNT(VSTGUIEditor);
 
 protected:
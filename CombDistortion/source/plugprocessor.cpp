@@ -52,8 +52,16 @@ uint32 PLUGIN_API PlugProcessor::getProcessContextRequirements()
     & Rq::kNeedTimeSignature;
 }
 
+tresult PLUGIN_API PlugProcessor::canProcessSampleSize(int32 symbolicSampleSize)
+{
+  if (symbolicSampleSize == Vst::kSample32 || symbolicSampleSize == Vst::kSample64)
+    return kResultTrue;
+  return kResultFalse;
+}
+
 tresult PLUGIN_API PlugProcessor::setupProcessing(Vst::ProcessSetup &setup)
 {
+  dsp.isOffline = setup.processMode == Vst::kOffline;
   dsp.setup(processSetup.sampleRate);
   return AudioEffect::setupProcessing(setup);
 }
@@ -69,24 +77,33 @@ tresult PLUGIN_API PlugProcessor::setActive(TBool state)
   return AudioEffect::setActive(state);
 }
 
+uint32 PLUGIN_API PlugProcessor::getLatencySamples() { return uint32(dsp.getLatency()); }
+
+template<typename Sample> void PlugProcessor::processAudio(Vst::ProcessData &data)
+{
+  Sample *in0 = getChannelBuffers<Sample>(data.inputs[0])[0];
+  Sample *in1 = getChannelBuffers<Sample>(data.inputs[0])[1];
+  Sample *out0 = getChannelBuffers<Sample>(data.outputs[0])[0];
+  Sample *out1 = getChannelBuffers<Sample>(data.outputs[0])[1];
+  const auto beatsPerSample = dsp.tempo / (double(60) * processSetup.sampleRate);
+  const auto beatsAtBlockStart = dsp.beatsElapsed;
+  processDriver.process(
+    data.numSamples, dsp.param, [&]() { dsp.setParameters(); },
+    [&](Vst::Event &event) { handleEvent(event); },
+    [&](int32 offset, int32 length) {
+      dsp.beatsElapsed = beatsAtBlockStart + offset * beatsPerSample;
+      dsp.process(
+        size_t(length), in0 + offset, in1 + offset, out0 + offset, out1 + offset);
+    });
+
+  if (dsp.param.value[ParameterID::bypass]->getInt()) processBypass<Sample>(data);
+}
+
 tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
   using ID = ParameterID::ID;
 
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
-    }
-  }
+  processDriver.prepare(data, dsp.param);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -113,52 +130,42 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   if (data.numSamples <= 0) return kResultOk;
   if (data.inputs[0].numChannels < 2) return kResultOk;
   if (data.outputs[0].numChannels < 2) return kResultOk;
-  if (data.symbolicSampleSize == Vst::kSample64) return kResultOk;
-
-  if (data.inputEvents != nullptr) handleEvent(data);
-
-  float *in0 = data.inputs[0].channelBuffers32[0];
-  float *in1 = data.inputs[0].channelBuffers32[1];
-  float *out0 = data.outputs[0].channelBuffers32[0];
-  float *out1 = data.outputs[0].channelBuffers32[1];
-  dsp.process((size_t)data.numSamples, in0, in1, out0, out1);
 
-  if (dsp.param.value[ParameterID::bypass]->getInt()) processBypass(data);
+  if (data.symbolicSampleSize == Vst::kSample64) {
+    processAudio<Vst::Sample64>(data);
+  } else {
+    processAudio<Vst::Sample32>(data);
+  }
 
   return kResultOk;
 }
 
-void PlugProcessor::processBypass(Vst::ProcessData &data)
+template<typename Sample> void PlugProcessor::processBypass(Vst::ProcessData &data)
 {
-  float **in = data.inputs[0].channelBuffers32;
-  float **out = data.outputs[0].channelBuffers32;
+  Sample **in = getChannelBuffers<Sample>(data.inputs[0]);
+  Sample **out = getChannelBuffers<Sample>(data.outputs[0]);
   for (int32_t ch = 0; ch < data.inputs[0].numChannels; ch++) {
-    if (in[ch] != out[ch]) memcpy(out[ch], in[ch], data.numSamples * sizeof(float));
+    if (in[ch] != out[ch]) memcpy(out[ch], in[ch], data.numSamples * sizeof(Sample));
   }
 }
 
-void PlugProcessor::handleEvent(Vst::ProcessData &data)
+void PlugProcessor::handleEvent(Vst::Event &event)
 {
-  for (int32 index = 0; index < data.inputEvents->getEventCount(); ++index) {
-    Vst::Event event;
-    if (data.inputEvents->getEvent(index, event) != kResultOk) continue;
-    switch (event.type) {
-      case Vst::Event::kNoteOnEvent: {
-        dsp.pushMidiNote(
-          true, event.sampleOffset,
-          event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId,
-          event.noteOn.pitch, event.noteOn.tuning, event.noteOn.velocity);
-      } break;
-
-      case Vst::Event::kNoteOffEvent: {
-        dsp.pushMidiNote(
-          false, event.sampleOffset,
-          event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId, 0, 0,
-          0);
-      } break;
-
-        // Add other event type here.
-    }
+  switch (event.type) {
+    case Vst::Event::kNoteOnEvent: {
+      dsp.pushMidiNote(
+        true, event.sampleOffset,
+        event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId,
+        event.noteOn.pitch, event.noteOn.tuning, event.noteOn.velocity);
+    } break;
+
+    case Vst::Event::kNoteOffEvent: {
+      dsp.pushMidiNote(
+        false, event.sampleOffset,
+        event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId, 0, 0, 0);
+    } break;
+
+      // Add other event type here.
   }
 }
 
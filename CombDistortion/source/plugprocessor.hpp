@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -26,6 +28,7 @@ public:
     Vst::SpeakerArrangement *outputs,
     int32 numOuts) SMTG_OVERRIDE;
   uint32 PLUGIN_API getProcessContextRequirements() SMTG_OVERRIDE;
+  tresult PLUGIN_API canProcessSampleSize(int32 symbolicSampleSize) SMTG_OVERRIDE;
 
   tresult PLUGIN_API setupProcessing(Vst::ProcessSetup &setup) SMTG_OVERRIDE;
   tresult PLUGIN_API setActive(TBool state) SMTG_OVERRIDE;
@@ -34,15 +37,18 @@ public:
   tresult PLUGIN_API setState(IBStream *state) SMTG_OVERRIDE;
   tresult PLUGIN_API getState(IBStream *state) SMTG_OVERRIDE;
 
+  uint32 PLUGIN_API getLatencySamples() SMTG_OVERRIDE;
+
   static FUnknown *createInstance(void *)
   {
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void processBypass(Vst::ProcessData &data);
+  template<typename Sample> void processBypass(Vst::ProcessData &data);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  template<typename Sample> void processAudio(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
@@ -50,6 +56,7 @@ protected:
   }
 
   uint64_t lastState = 0;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
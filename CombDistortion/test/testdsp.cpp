@@ -4,6 +4,7 @@
 #define SET_PARAMETERS dsp->setParameters();
 
 #include "../../test/fxtester.hpp"
+#include "../../test/sampleprecision.hpp"
 #include "../source/dsp/dspcore.hpp"
 
 // CMake provides this macro, but just in case.
@@ -16,5 +17,13 @@
 int main()
 {
   FxTester<DSPCore> tester(UHHYOU_PLUGIN_NAME, OUT_DIR_PATH);
-  return tester.isFinished ? EXIT_SUCCESS : EXIT_FAILURE;
+  if (!tester.isPassed()) return EXIT_FAILURE;
+
+  auto isSampleSizeMatched = testSampleSize<DSPCore>(
+    UHHYOU_PLUGIN_NAME, [](auto &dsp, size_t frame, size_t length, auto &in, auto &out) {
+      dsp.process(
+        length, in[0].data() + frame, in[1].data() + frame, out[0].data() + frame,
+        out[1].data() + frame);
+    });
+  return isSampleSizeMatched ? EXIT_SUCCESS : EXIT_FAILURE;
 }
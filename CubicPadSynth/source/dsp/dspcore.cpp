@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-only
 // Copyright Takamitsu Endo (ryukau@gmail.com)
 
+#include "../../../common/trace.hpp"
 #include "../../../lib/juce_ScopedNoDenormal.hpp"
 
 #include "dspcore.hpp"
@@ -14,9 +15,9 @@
 
 #include <iostream>
 
-#define PROCESSING_UNIT_NAME ProcessingUnit_FixedInstruction
-#define NOTE_NAME Note_FixedInstruction
-#define DSPCORE_NAME DSPCore_FixedInstruction
+#define PROCESSING_UNIT_NAME UHHYOU_SIMD_NAME(ProcessingUnit_)
+#define NOTE_NAME UHHYOU_SIMD_NAME(Note_)
+#define DSPCORE_NAME UHHYOU_SIMD_NAME(DSPCore_)
 
 inline float clamp(float value, float min, float max)
 {
@@ -120,7 +121,8 @@ DSPCORE_NAME::DSPCORE_NAME()
   noteIndices.reserve(maxVoice);
   voiceIndices.reserve(maxVoice);
 
-  midiNotes.reserve(maxVoice);
+  // Padding for `LfoWaveTable::refreshTable()`, which appends to the table.
+  lfoUiTable.reserve(nLFOWavetable + 3);
 
   for (int i = 0; i < notes.size(); ++i) {
     notes[i].vecIndex = i % 16;
@@ -130,12 +132,16 @@ DSPCORE_NAME::DSPCORE_NAME()
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
+  tableTask.wait();
+  tableTask.poll();
+  isTableRequested = false;
+
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (size_t idx = 0; idx < nUnit; ++idx) {
     units[idx].gainEnvelope.setup(
@@ -228,7 +234,7 @@ void DSPCORE_NAME::setParameters(float tempo)
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   interpMasterGain.push(param.value[ID::gain]->getFloat());
 
@@ -260,8 +266,13 @@ void DSPCORE_NAME::setParameters(float tempo)
     refreshLfo();
   isLFORefreshed = param.value[ID::refreshLFO]->getInt();
 
-  if (prepareRefresh || (!isTableRefeshed && param.value[ID::refreshTable]->getInt()))
-    refreshTable();
+  if (prepareRefresh) {
+    prepareTable();
+    buildTable();
+    isTableBuilding = false;
+  } else if (!isTableRefeshed && param.value[ID::refreshTable]->getInt()) {
+    isTableRequested = true;
+  }
   isTableRefeshed = param.value[ID::refreshTable]->getInt();
 
   prepareRefresh = false;
@@ -309,7 +320,25 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  if (wavetable.isRefreshing) {
+  if (isLfoRefreshPosted.exchange(false)) refreshLfo();
+  if (isTableRefreshPosted.exchange(false)) isTableRequested = true;
+
+  // `buildTable()` runs on a worker thread without a bound trace ring. The trace events
+  // are recorded here on the audio thread instead.
+  if (tableTask.poll()) {
+    UHHYOU_TRACE_INSTANT("swapTable");
+    isTableBuilding = false;
+  }
+  if (isTableRequested && !tableTask.isBusy()) {
+    UHHYOU_TRACE_SCOPE("submitTable");
+    prepareTable();
+    if (tableTask.submit()) {
+      isTableRequested = false;
+      isTableBuilding = true;
+    }
+  }
+
+  if (isTableBuilding) {
     for (int i = 0; i < length; ++i) {
       processMidiNote(i);
       out0[i] = 0;
@@ -318,7 +347,7 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
     return;
   }
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   std::array<float, 2> frame{};
   for (uint32_t i = 0; i < length; ++i) {
@@ -537,6 +566,9 @@ void DSPCORE_NAME::noteOn(int32_t identifier, int16_t pitch, float tuning, float
 
 void DSPCORE_NAME::fillTransitionBuffer(size_t noteIndex)
 {
+  // `wavetable` may be written by `tableTask`. Output is muted in this case.
+  if (isTableBuilding) return;
+
   isTransitioning = true;
 
   // Beware the negative overflow. trStop is size_t.
@@ -580,7 +612,7 @@ void DSPCORE_NAME::noteOff(int32_t noteId)
     if (notes[i].id == noteId) notes[i].release(units);
 }
 
-void DSPCORE_NAME::refreshTable()
+void DSPCORE_NAME::prepareTable()
 {
   using ID = ParameterID::ID;
 
@@ -603,25 +635,44 @@ void DSPCORE_NAME::refreshTable()
     otPhase[idx] = param.value[ID::overtonePhase0 + idx]->getFloat();
   }
 
+  auto &in = padsynthInput;
+  in.sampleRate = sampleRate;
+  in.tableBaseFreq = tableBaseFreq;
+  in.seed = param.value[ID::padSynthSeed]->getInt();
+  in.expand = param.value[ID::spectrumExpand]->getFloat();
+  in.shift = int32_t(param.value[ID::spectrumShift]->getInt()) - spectrumSize;
+  in.profileSkip = param.value[ID::profileComb]->getInt() + 1;
+  in.profileShape = param.value[ID::profileShape]->getFloat();
+  in.randomPitch = param.value[ID::overtonePitchRandom]->getInt();
+  in.invertSpectrum = param.value[ID::spectrumInvert]->getInt();
+  in.uniformPhaseProfile = param.value[ID::uniformPhaseProfile]->getInt();
+}
+
+void DSPCORE_NAME::buildTable()
+{
+  const auto &in = padsynthInput;
   wavetable.padsynth(
-    sampleRate, tableBaseFreq, otFrequency, otGain, otPhase, otBandWidth,
-    param.value[ID::padSynthSeed]->getInt(), param.value[ID::spectrumExpand]->getFloat(),
-    int32_t(param.value[ID::spectrumShift]->getInt()) - spectrumSize,
-    param.value[ID::profileComb]->getInt() + 1, param.value[ID::profileShape]->getFloat(),
-    param.value[ID::overtonePitchRandom]->getInt(),
-    param.value[ID::spectrumInvert]->getInt(),
-    param.value[ID::uniformPhaseProfile]->getInt());
+    in.sampleRate, in.tableBaseFreq, otFrequency, otGain, otPhase, otBandWidth, in.seed,
+    in.expand, in.shift, in.profileSkip, in.profileShape, in.randomPitch,
+    in.invertSpectrum, in.uniformPhaseProfile);
 }
 
 void DSPCORE_NAME::refreshLfo()
 {
+  UHHYOU_TRACE_SCOPE("refreshLfo");
+
   using ID = ParameterID::ID;
 
   reset();
 
-  std::vector<float> table(nLFOWavetable);
+  lfoUiTable.resize(nLFOWavetable);
   for (size_t idx = 0; idx < nLFOWavetable; ++idx)
-    table[idx] = param.value[ID::lfoWavetable0 + idx]->getFloat();
+    lfoUiTable[idx] = param.value[ID::lfoWavetable0 + idx]->getFloat();
 
-  lfoWavetable.refreshTable(table, param.value[ID::lfoWavetableType]->getInt());
+  lfoWavetable.refreshTable(lfoUiTable, param.value[ID::lfoWavetableType]->getInt());
+}
+
+std::unique_ptr<DSPInterface> UHHYOU_SIMD_NAME(makeDSPCore_)()
+{
+  return std::make_unique<DSPCORE_NAME>();
 }
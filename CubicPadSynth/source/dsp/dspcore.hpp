@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include "../../../common/backgroundjob.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/vcl.hpp"
 #include "../../../lib/vcl/vectormath_exp.h"
@@ -13,12 +16,16 @@
 #include "oscillator.hpp"
 
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <memory>
 #include <random>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
 
+inline namespace UHHYOU_SIMD_NAMESPACE {
+
 class EMAFilter16 {
 public:
   void setP(float p) { kp = std::clamp<float>(p, float(0), float(1)); };
@@ -31,6 +38,8 @@ private:
   Vec16f value = 0;
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
+
 inline float calcMasterPitch(int32_t octave, int32_t semi, int32_t milli, float bend)
 {
   return 12 * octave + semi + milli / 1000.0f + (bend - 0.5f) * 4.0f;
@@ -47,6 +56,20 @@ inline float getMasterPitch(GlobalParameter &param)
 
 constexpr size_t nUnit = 8;
 
+// Scalar inputs of `WaveTable::padsynth()`. Overtone arrays are members of DSPCore.
+struct PadSynthInput {
+  float sampleRate = 44100.0f;
+  float tableBaseFreq = 20.0f;
+  uint32_t seed = 0;
+  float expand = 1.0f;
+  int32_t shift = 0;
+  uint32_t profileSkip = 1;
+  float profileShape = 1.0f;
+  bool randomPitch = false;
+  bool invertSpectrum = false;
+  bool uniformPhaseProfile = false;
+};
+
 enum class NoteState { active, release, rest };
 
 struct NoteProcessInfo {
@@ -63,6 +86,20 @@ struct NoteProcessInfo {
   LinearSmoother<float> lfoPitchAmount;
   LinearSmoother<float> lfoLowpass;
 
+  explicit NoteProcessInfo(const SmootherContext<float> &context)
+    : masterPitch(context)
+    , equalTemperament(context)
+    , pitchA4Hz(context)
+    , tableLowpass(context)
+    , tableLowpassKeyFollow(context)
+    , tableLowpassEnvelopeAmount(context)
+    , pitchEnvelopeAmount(context)
+    , lfoFrequency(context)
+    , lfoPitchAmount(context)
+    , lfoLowpass(context)
+  {
+  }
+
   void reset(GlobalParameter &param)
   {
     using ID = ParameterID::ID;
@@ -106,6 +143,11 @@ struct NoteProcessInfo {
                                                                                          \
     bool isActive = false;                                                               \
                                                                                          \
+    explicit ProcessingUnit_##INSTRSET(const SmootherContext<float> &context)            \
+      : gainEnvelope(context), pitchEnvelope(context), lowpassEnvelope(context)          \
+    {                                                                                    \
+    }                                                                                    \
+                                                                                         \
     void setParameters(float sampleRate, NoteProcessInfo &info, GlobalParameter &param); \
     std::array<float, 2> process(                                                        \
       float sampleRate,                                                                  \
@@ -157,8 +199,10 @@ public:
   virtual void process(const size_t length, float *out0, float *out1) = 0;
   virtual void noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity) = 0;
   virtual void noteOff(int32_t noteId) = 0;
-  virtual void refreshTable() = 0;
-  virtual void refreshLfo() = 0;
+
+  // Thread safe. Refreshes are started on the next `process()`.
+  void requestTableRefresh() { isTableRefreshPosted.store(true); }
+  void requestLfoRefresh() { isLfoRefreshPosted.store(true); }
 
   struct MidiNote {
     bool isNoteOn;
@@ -169,7 +213,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   virtual void pushMidiNote(
     bool isNoteOn,
@@ -180,6 +224,10 @@ public:
     float velocity)
     = 0;
   virtual void processMidiNote(uint32_t frame) = 0;
+
+protected:
+  std::atomic<bool> isTableRefreshPosted{false};
+  std::atomic<bool> isLfoRefreshPosted{false};
 };
 
 #define DSPCORE_CLASS(INSTRSET)                                                          \
@@ -195,8 +243,6 @@ public:
     void noteOn(int32_t noteId, int16_t pitch, float tuning, float velocity) override;   \
     void fillTransitionBuffer(size_t noteIndex);                                         \
     void noteOff(int32_t noteId) override;                                               \
-    void refreshTable() override;                                                        \
-    void refreshLfo() override;                                                          \
                                                                                          \
     void pushMidiNote(                                                                   \
       bool isNoteOn,                                                                     \
@@ -213,30 +259,29 @@ public:
       note.pitch = pitch;                                                                \
       note.tuning = tuning;                                                              \
       note.velocity = velocity;                                                          \
-      midiNotes.push_back(note);                                                         \
+      midiNotes.push(note);                                                              \
     }                                                                                    \
                                                                                          \
     void processMidiNote(uint32_t frame) override                                        \
     {                                                                                    \
-      while (true) {                                                                     \
-        auto it                                                                          \
-          = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {   \
-              return nt.frame == frame;                                                  \
-            });                                                                          \
-        if (it == std::end(midiNotes)) return;                                           \
-        if (it->isNoteOn)                                                                \
-          noteOn(it->id, it->pitch, it->tuning, it->velocity);                           \
+      MidiNote note;                                                                     \
+      while (midiNotes.pop(frame, note)) {                                               \
+        if (note.isNoteOn)                                                               \
+          noteOn(note.id, note.pitch, note.tuning, note.velocity);                       \
         else                                                                             \
-          noteOff(it->id);                                                               \
-        midiNotes.erase(it);                                                             \
+          noteOff(note.id);                                                              \
       }                                                                                  \
     }                                                                                    \
                                                                                          \
   private:                                                                               \
     void sortVoiceIndicesByGain();                                                       \
     void terminateNotes(size_t nNote);                                                   \
+    void prepareTable();                                                                 \
+    void buildTable();                                                                   \
+    void refreshLfo();                                                                   \
                                                                                          \
     float sampleRate = 44100.0f;                                                         \
+    SmootherContext<float> smootherContext;                                              \
                                                                                          \
     std::array<float, nOvertone> otFrequency{};                                          \
     std::array<float, nOvertone> otGain{};                                               \
@@ -246,9 +291,19 @@ public:
     bool prepareRefresh = true;                                                          \
     bool isTableRefeshed = false;                                                        \
     bool isLFORefreshed = false;                                                         \
-    WaveTable<tableSize, nOvertone> wavetable;                                           \
     LfoWaveTable<lfoTableSize> lfoWavetable;                                             \
-    std::array<ProcessingUnit_##INSTRSET, nUnit> units;                                  \
+    std::vector<float> lfoUiTable;                                                       \
+                                                                                         \
+    /* Table refresh requested from GUI is built on background thread. Output is */      \
+    /* muted while `isTableBuilding`. `otFrequency` etc. and `padsynthInput` are */      \
+    /* the inputs, written only while `tableTask` is idle. */                            \
+    bool isTableRequested = false;                                                       \
+    bool isTableBuilding = true;                                                         \
+    PadSynthInput padsynthInput;                                                         \
+    WaveTable<tableSize, nOvertone> wavetable;                                           \
+    BackgroundTask tableTask{[this]() { buildTable(); }};                                \
+    std::array<ProcessingUnit_##INSTRSET, nUnit> units                                   \
+      = makeSmootherArray<ProcessingUnit_##INSTRSET, nUnit>(smootherContext);            \
                                                                                          \
     size_t nVoice = 32;                                                                  \
     int32_t panCounter = 0;                                                              \
@@ -257,8 +312,8 @@ public:
     std::vector<float> unisonPan;                                                        \
     std::array<Note_##INSTRSET, maxVoice> notes;                                         \
                                                                                          \
-    NoteProcessInfo info;                                                                \
-    LinearSmoother<float> interpMasterGain;                                              \
+    NoteProcessInfo info{smootherContext};                                               \
+    LinearSmoother<float> interpMasterGain{smootherContext};                             \
                                                                                          \
     std::vector<std::array<float, 2>> transitionBuffer{};                                \
     bool isTransitioning = false;                                                        \
@@ -267,6 +322,12 @@ public:
     TableOsc<tableSize> trOsc;                                                           \
   };
 
-PROCESSING_UNIT_CLASS(FixedInstruction)
-NOTE_CLASS(FixedInstruction)
-DSPCORE_CLASS(FixedInstruction)
+UHHYOU_SIMD_APPLY(PROCESSING_UNIT_CLASS)
+UHHYOU_SIMD_APPLY(NOTE_CLASS)
+UHHYOU_SIMD_APPLY(DSPCORE_CLASS)
+
+// Variant of current translation unit. Tests use this without dispatch.
+using DSPCore_FixedInstruction = UHHYOU_SIMD_NAME(DSPCore_);
+
+// Defined in `dspcore.cpp` for each variant. Use `UHHYOU_SIMD_DISPATCH(makeDSPCore_)`.
+UHHYOU_SIMD_DECLARE_FACTORY(std::unique_ptr<DSPInterface>, makeDSPCore_)
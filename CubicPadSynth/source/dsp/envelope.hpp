@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/vcl.hpp"
 #include "../../../lib/vcl/vectormath_exp.h"
@@ -12,9 +13,12 @@
 #include <cmath>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 class alignas(64) ExpADSREnvelope16 {
 public:
+  explicit ExpADSREnvelope16(const SmootherContext<float> &context) : sus(context) {}
+
   void setup(float sampleRate, float sustainLevel)
   {
     this->sampleRate = sampleRate;
@@ -145,6 +149,8 @@ protected:
 
 class alignas(64) LinearADSREnvelope16 {
 public:
+  explicit LinearADSREnvelope16(const SmootherContext<float> &context) : sus(context) {}
+
   void setup(float sampleRate, float sustainLevel)
   {
     this->sampleRate = sampleRate;
@@ -253,4 +259,5 @@ protected:
   Vec16f out = 0;
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
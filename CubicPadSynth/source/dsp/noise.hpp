@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../lib/vcl.hpp"
 
 #include <cstdint>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 // Numerical Recipes In C p.284. Normalized to [0, 1).
 template<typename Sample> class Random {
@@ -44,4 +46,5 @@ struct alignas(64) White16 {
   }
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
@@ -4,17 +4,18 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
-#include "../../../lib/fftw3/fftw3.h"
+#include "../../../common/dsp/fft/fftw.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../lib/vcl.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cstring>
 #include <deque>
-#include <mutex>
 #include <random>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 constexpr size_t nTable = 136; // midi note nubmer 136 ~= 21096 Hz.
 constexpr size_t nTablePadded = nTable + 4;
@@ -62,40 +63,35 @@ table is 2d array which has extra padding for interpolation.
 - Padded last 3 row is silence.
 */
 template<size_t tableSize, size_t nPeak> struct WaveTable {
-  // `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`.
-  static std::mutex fftwMutex;
-
   static constexpr size_t spectrumSize = tableSize / 2 + 1;
   static constexpr size_t paddedSize = tableSize + 3;
   fftwf_complex *spectrum;
   fftwf_complex *bandLimited;
   fftwf_complex *tmpSpec;
   std::array<float *, nTablePadded> table;
-  std::array<fftwf_plan, nTablePadded> plan;
+  fftwf_plan plan; // Owned by `FFTWPlanCache`. Same layout for all `table`.
   std::array<float, nTablePadded> frequency; // Must be sorted by ascending order.
-  bool isRefreshing = true;
   float tableBaseFreq = 20.0f;
 
   WaveTable()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    auto &fftw = FFTWPlanCache::instance();
 
-    spectrum = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * spectrumSize);
-    bandLimited = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * spectrumSize);
-    tmpSpec = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * spectrumSize);
+    spectrum = fftw.allocate<fftwf_complex>(spectrumSize);
+    bandLimited = fftw.allocate<fftwf_complex>(spectrumSize);
+    tmpSpec = fftw.allocate<fftwf_complex>(spectrumSize);
 
     for (size_t idx = 0; idx < nTablePadded; ++idx) {
-      table[idx] = (float *)fftwf_malloc(sizeof(float) * paddedSize);
+      table[idx] = fftw.allocate<float>(paddedSize);
       table[idx][0] = 0;
       table[idx][paddedSize - 1] = 0;
 
-      plan[idx]
-        = fftwf_plan_dft_c2r_1d(tableSize, bandLimited, table[idx] + 1, FFTW_ESTIMATE);
-
       // TODO: Experiment with different frequency.
       frequency[idx] = 440.0f * powf(2.0f, (idx - 69.0f) / 12.0f);
     }
 
+    plan = fftw.getC2R(tableSize, bandLimited, table[0] + 1);
+
     // Last 3 tables are slince.
     for (size_t idx = nTablePadded - 3; idx < nTablePadded; ++idx) {
       for (size_t i = 0; i < paddedSize; ++i) table[idx][i] = 0;
@@ -104,13 +100,11 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
 
   ~WaveTable()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &pln : plan) fftwf_destroy_plan(pln);
-    for (auto &tbl : table) fftwf_free(tbl);
-    fftwf_free(tmpSpec);
-    fftwf_free(bandLimited);
-    fftwf_free(spectrum);
+    auto &fftw = FFTWPlanCache::instance();
+    for (auto &tbl : table) fftw.free(tbl);
+    fftw.free(tmpSpec);
+    fftw.free(bandLimited);
+    fftw.free(spectrum);
   }
 
   inline float profile(float fi, float bwi, float shape)
@@ -122,14 +116,12 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
 
   void refreshTable()
   {
-    isRefreshing = true;
-
     // table[0] and table[1] has full spectrum.
     bandLimited[0][0] = 0;
     bandLimited[0][1] = 0;
     std::memcpy(
       bandLimited + 1, spectrum + 1, sizeof(fftwf_complex) * (spectrumSize - 1));
-    fftwf_execute(plan[0]);
+    fftwExecute(plan, bandLimited, table[0] + 1);
     std::memcpy(table[1], table[0], sizeof(float) * paddedSize);
 
     for (size_t idx = 2; idx <= nTable; ++idx) {
@@ -142,7 +134,7 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
       std::memset(
         bandLimited + bandIdx, 0, sizeof(fftwf_complex) * (spectrumSize - bandIdx));
 
-      fftwf_execute(plan[idx]);
+      fftwExecute(plan, bandLimited, table[idx] + 1);
     }
 
     // Fill padded elements.
@@ -163,8 +155,6 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
         for (size_t i = 0; i < paddedSize; ++i) table[idx][i] /= max;
       }
     }
-
-    isRefreshing = false;
   }
 
   float sign(float x) { return float((0 < x) - (x < 0)); }
@@ -278,9 +268,6 @@ template<size_t tableSize, size_t nPeak> struct WaveTable {
   }
 };
 
-template<size_t tableSize, size_t nPeak>
-std::mutex WaveTable<tableSize, nPeak>::fftwMutex;
-
 template<size_t tableSize> struct TableOsc {
   static constexpr size_t paddedLast = tableSize + 1;
   float phase = 1; // table index starts from 1. 0 is padded index.
@@ -574,4 +561,5 @@ public:
   }
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
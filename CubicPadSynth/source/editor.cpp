@@ -737,6 +737,12 @@ Press following button to apply changes.
     pluginNameTextSize, ssPluginName.str());
   tabview->addWidget(tabInfo, pluginNameTextView);
 
+  tabview->addWidget(
+    tabInfo,
+    addDSPLoadView(
+      tabInfoLeft1, tabInfoBottom - 8 * uiMargin - int(sc * 80), int(sc * 240),
+      int(sc * 60), infoTextSize));
+
   tabview->addWidget(
     tabInfo,
     addTextView(
@@ -22,7 +22,7 @@ namespace Synth {
 
 PlugProcessor::PlugProcessor()
 {
-  dsp = std::make_unique<DSPCore_FixedInstruction>();
+  dsp = UHHYOU_SIMD_DISPATCH(makeDSPCore_);
 
   setControllerClass(ControllerUID);
 }
@@ -80,20 +80,7 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
   if (dsp == nullptr) return kNotInitialized;
 
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp->param.value.size()) dsp->param.value[id]->setFromNormalized(value);
-    }
-  }
+  processDriver.prepare(data, dsp->param);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -115,43 +102,40 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   if (data.outputs[0].numChannels < 2) return kResultOk;
   if (data.symbolicSampleSize == Vst::kSample64) return kResultOk;
 
-  if (data.inputEvents != nullptr) handleEvent(data);
-
   float *out0 = data.outputs[0].channelBuffers32[0];
   float *out1 = data.outputs[0].channelBuffers32[1];
-  size_t length = data.numSamples < 0 ? 0 : size_t(data.numSamples);
-  dsp->process(length, out0, out1);
+  processDriver.process(
+    data.numSamples, dsp->param, [&]() { dsp->setParameters(tempo); },
+    [&](Vst::Event &event) { handleEvent(event); },
+    [&](int32 offset, int32 length) {
+      dsp->process(size_t(length), out0 + offset, out1 + offset);
+    });
 
   return kResultOk;
 }
 
-void PlugProcessor::handleEvent(Vst::ProcessData &data)
+void PlugProcessor::handleEvent(Vst::Event &event)
 {
   if (dsp == nullptr) return;
 
-  for (int32 index = 0; index < data.inputEvents->getEventCount(); ++index) {
-    Vst::Event event;
-    if (data.inputEvents->getEvent(index, event) != kResultOk) continue;
-    switch (event.type) {
-      case Vst::Event::kNoteOnEvent: {
-        // List of DAW that don't support note ID. Probably more.
-        // - Ableton Live 10.1.6
-        // - PreSonus Studio One 4.6.1
-        auto noteId
-          = event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId;
-        dsp->pushMidiNote(
-          true, event.sampleOffset, noteId, event.noteOn.pitch, event.noteOn.tuning,
-          event.noteOn.velocity);
-      } break;
-
-      case Vst::Event::kNoteOffEvent: {
-        auto noteId
-          = event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId;
-        dsp->pushMidiNote(false, event.sampleOffset, noteId, 0, 0, 0);
-      } break;
-
-        // Add other event type here.
-    }
+  switch (event.type) {
+    case Vst::Event::kNoteOnEvent: {
+      // List of DAW that don't support note ID. Probably more.
+      // - Ableton Live 10.1.6
+      // - PreSonus Studio One 4.6.1
+      auto noteId = event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId;
+      dsp->pushMidiNote(
+        true, event.sampleOffset, noteId, event.noteOn.pitch, event.noteOn.tuning,
+        event.noteOn.velocity);
+    } break;
+
+    case Vst::Event::kNoteOffEvent: {
+      auto noteId
+        = event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId;
+      dsp->pushMidiNote(false, event.sampleOffset, noteId, 0, 0, 0);
+    } break;
+
+      // Add other event type here.
   }
 }
 
@@ -173,14 +157,14 @@ tresult PlugProcessor::receiveText(const char8 *text)
   if (dsp == nullptr) return kNotInitialized;
 
   if (std::strcmp(text, "padsynth") == 0) {
-    dsp->refreshTable();
+    dsp->requestTableRefresh();
   } else if (std::strcmp(text, "lfo") == 0) {
-    dsp->refreshLfo();
+    dsp->requestLfoRefresh();
   } else {
     // This else condition is band-aid solution.
     // FL Studio 20.6.2 sends empty text to this method.
-    dsp->refreshTable();
-    dsp->refreshLfo();
+    dsp->requestTableRefresh();
+    dsp->requestLfoRefresh();
   }
   return kResultOk;
 }
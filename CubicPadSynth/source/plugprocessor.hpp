@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 #include <memory>
@@ -43,11 +45,12 @@ public:
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
 protected:
   uint64_t lastState = 0;
   float tempo = 120.0f;
+  ProcessDriver processDriver;
   std::unique_ptr<DSPInterface> dsp;
 };
 
@@ -62,7 +62,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = sampleRate;
   upRate = sampleRate * upFold;
 
-  SmootherCommon<double>::setTime(double(0.2));
+  smootherContext.setTime(double(0.2));
   baseSampleRateKp = EMAFilter<double>::secondToP(sampleRate, double(0.2));
 
   releaseSmoother.setup(double(2) * upRate);
@@ -144,7 +144,7 @@ void DSPCore::setup(double sampleRate)
 void DSPCore::updateUpRate()
 {
   upRate = sampleRate * fold[overSampling];
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
   spreader.updateBaseTime(spreaderMaxTimeSecond * upRate);
 }
 
@@ -175,7 +175,7 @@ void DSPCore::updateDelayTime()
 
 void DSPCore::reset()
 {
-  midiNotes.resize(0);
+  midiNotes.clear();
   noteStack.resize(0);
 
   overSampling = param.value[ParameterID::ID::overSampling]->getInt();
@@ -319,8 +319,8 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   double frame = 0;
   for (size_t i = 0; i < length; ++i) {
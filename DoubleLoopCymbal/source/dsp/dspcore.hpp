@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
@@ -25,11 +26,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   bool isPlaying = false;
@@ -61,21 +58,17 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id, it->velocity);
-      midiNotes.erase(it);
+        noteOff(note.id, note.velocity);
     }
   }
 
@@ -85,13 +78,14 @@ private:
   double calcNotePitch(double note);
   double processFrame(const std::array<double, 2> &externalInput);
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   static constexpr size_t upFold = 2;
   static constexpr std::array<size_t, 2> fold{1, upFold};
   size_t overSampling = 2;
   double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100.0;
 
   double noteNumber = 60.0;
@@ -99,25 +93,25 @@ private:
   double pitchSmoothingKp = 1.0;
   ExpSmootherLocal<double> interpPitch;
 
-  ExpSmoother<double> externalInputGain;
-  ExpSmoother<double> impactTextureMix;
-  ExpSmoother<double> impactHighpassCutoff;
-  ExpSmoother<double> halfClosedGain;
-  ExpSmoother<double> halfClosedSustain;
-  ExpSmoother<double> halfClosedDensity;
-  ExpSmoother<double> halfClosedHighpassCutoff;
-  ExpSmoother<double> closingHighpassCutoff;
-  ExpSmoother<double> delayTimeModAmount;
-  ExpSmoother<double> allpassLoopGain;
-  ExpSmoother<double> allpassFeed1;
-  ExpSmoother<double> allpassFeed2;
-  ExpSmoother<double> allpassMixSpike;
-  ExpSmoother<double> allpassMixAltSign;
-  ExpSmoother<double> highShelfCutoff;
-  ExpSmoother<double> highShelfGain;
-  ExpSmoother<double> lowShelfCutoff;
-  ExpSmoother<double> lowShelfGain;
-  ExpSmoother<double> outputGain;
+  ExpSmoother<double> externalInputGain{smootherContext};
+  ExpSmoother<double> impactTextureMix{smootherContext};
+  ExpSmoother<double> impactHighpassCutoff{smootherContext};
+  ExpSmoother<double> halfClosedGain{smootherContext};
+  ExpSmoother<double> halfClosedSustain{smootherContext};
+  ExpSmoother<double> halfClosedDensity{smootherContext};
+  ExpSmoother<double> halfClosedHighpassCutoff{smootherContext};
+  ExpSmoother<double> closingHighpassCutoff{smootherContext};
+  ExpSmoother<double> delayTimeModAmount{smootherContext};
+  ExpSmoother<double> allpassLoopGain{smootherContext};
+  ExpSmoother<double> allpassFeed1{smootherContext};
+  ExpSmoother<double> allpassFeed2{smootherContext};
+  ExpSmoother<double> allpassMixSpike{smootherContext};
+  ExpSmoother<double> allpassMixAltSign{smootherContext};
+  ExpSmoother<double> highShelfCutoff{smootherContext};
+  ExpSmoother<double> highShelfGain{smootherContext};
+  ExpSmoother<double> lowShelfCutoff{smootherContext};
+  ExpSmoother<double> lowShelfGain{smootherContext};
+  ExpSmoother<double> outputGain{smootherContext};
 
   bool useExternalInput = false;
   double impactHighpassScaler = double(1);
@@ -10,8 +10,8 @@
 #include <algorithm>
 #include <numeric>
 
-#define NOTE_NAME Note_FixedInstruction
-#define DSPCORE_NAME DSPCore_FixedInstruction
+#define NOTE_NAME UHHYOU_SIMD_NAME(Note_)
+#define DSPCORE_NAME UHHYOU_SIMD_NAME(DSPCore_)
 
 inline float clamp(float value, float min, float max)
 {
@@ -194,16 +194,16 @@ template<typename Sample> std::array<Sample, 2> NOTE_NAME<Sample>::process()
   return frame;
 }
 
-DSPCORE_NAME::DSPCORE_NAME() { midiNotes.reserve(128); }
+DSPCORE_NAME::DSPCORE_NAME() {}
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   interpPhaserPhase.setRange(float(twopi));
 
@@ -240,7 +240,7 @@ void DSPCORE_NAME::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   interpMasterGain.push(
     param.value[ID::gain]->getFloat() * param.value[ID::gainBoost]->getFloat());
@@ -270,7 +270,7 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   std::array<float, 2> frame{};
   for (uint32_t i = 0; i < length; ++i) {
@@ -397,3 +397,8 @@ void DSPCORE_NAME::noteOff(int32_t noteId)
 
   notes[i].release();
 }
+
+std::unique_ptr<DSPInterface> UHHYOU_SIMD_NAME(makeDSPCore_)()
+{
+  return std::make_unique<DSPCORE_NAME>();
+}
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "noise.hpp"
@@ -14,6 +16,7 @@
 
 #include <array>
 #include <cmath>
+#include <memory>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
@@ -80,7 +83,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   virtual void pushMidiNote(
     bool isNoteOn,
@@ -127,27 +130,23 @@ transitionBuffer is used to store a release of a note to reduce pop noise.
       note.pitch = pitch;                                                                \
       note.tuning = tuning;                                                              \
       note.velocity = velocity;                                                          \
-      midiNotes.push_back(note);                                                         \
+      midiNotes.push(note);                                                              \
     }                                                                                    \
                                                                                          \
     void processMidiNote(uint32_t frame) override                                        \
     {                                                                                    \
-      while (true) {                                                                     \
-        auto it                                                                          \
-          = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {   \
-              return nt.frame == frame;                                                  \
-            });                                                                          \
-        if (it == std::end(midiNotes)) return;                                           \
-        if (it->isNoteOn)                                                                \
-          noteOn(it->id, it->pitch, it->tuning, it->velocity);                           \
+      MidiNote note;                                                                     \
+      while (midiNotes.pop(frame, note)) {                                               \
+        if (note.isNoteOn)                                                               \
+          noteOn(note.id, note.pitch, note.tuning, note.velocity);                       \
         else                                                                             \
-          noteOff(it->id);                                                               \
-        midiNotes.erase(it);                                                             \
+          noteOff(note.id);                                                              \
       }                                                                                  \
     }                                                                                    \
                                                                                          \
   private:                                                                               \
     float sampleRate = 44100.0f;                                                         \
+    SmootherContext<float> smootherContext;                                              \
                                                                                          \
     White16 rng{0};                                                                      \
     std::array<Thiran2Phaser16, 2> phaser;                                               \
@@ -156,14 +155,14 @@ transitionBuffer is used to store a release of a note to reduce pop noise.
     std::array<Note_##INSTRSET<float>, maxVoice> notes;                                  \
     float lastNoteFreq = 1.0f;                                                           \
                                                                                          \
-    LinearSmoother<float> interpMasterGain;                                              \
-    LinearSmoother<float> interpPhaserMix;                                               \
-    LinearSmoother<float> interpPhaserFrequency;                                         \
-    LinearSmoother<float> interpPhaserFeedback;                                          \
-    LinearSmoother<float> interpPhaserRange;                                             \
-    LinearSmoother<float> interpPhaserMin;                                               \
-    RotarySmoother<float> interpPhaserPhase;                                             \
-    LinearSmoother<float> interpPhaserOffset;                                            \
+    LinearSmoother<float> interpMasterGain{smootherContext};                             \
+    LinearSmoother<float> interpPhaserMix{smootherContext};                              \
+    LinearSmoother<float> interpPhaserFrequency{smootherContext};                        \
+    LinearSmoother<float> interpPhaserFeedback{smootherContext};                         \
+    LinearSmoother<float> interpPhaserRange{smootherContext};                            \
+    LinearSmoother<float> interpPhaserMin{smootherContext};                              \
+    RotarySmoother<float> interpPhaserPhase{smootherContext};                            \
+    LinearSmoother<float> interpPhaserOffset{smootherContext};                           \
                                                                                          \
     std::vector<std::array<float, 2>> transitionBuffer{};                                \
     bool isTransitioning = false;                                                        \
@@ -171,5 +170,11 @@ transitionBuffer is used to store a release of a note to reduce pop noise.
     size_t trStop = 0;                                                                   \
   };
 
-NOTE_CLASS(FixedInstruction)
-DSPCORE_CLASS(FixedInstruction)
+UHHYOU_SIMD_APPLY(NOTE_CLASS)
+UHHYOU_SIMD_APPLY(DSPCORE_CLASS)
+
+// Variant of current translation unit. Tests use this without dispatch.
+using DSPCore_FixedInstruction = UHHYOU_SIMD_NAME(DSPCore_);
+
+// Defined in `dspcore.cpp` for each variant. Use `UHHYOU_SIMD_DISPATCH(makeDSPCore_)`.
+UHHYOU_SIMD_DECLARE_FACTORY(std::unique_ptr<DSPInterface>, makeDSPCore_)
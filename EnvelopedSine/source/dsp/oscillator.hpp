@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../lib/juce_FastMathApproximations.h"
 #include "../../../lib/vcl.hpp"
 #include "../../../lib/vcl/vectormath_exp.h"
@@ -12,6 +13,7 @@
 #include <array>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 template<size_t size> struct alignas(64) QuadOscExpAD {
   std::array<Vec16f, size> frequency{};
@@ -118,4 +120,5 @@ template<size_t size> struct alignas(64) QuadOscExpAD {
   }
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
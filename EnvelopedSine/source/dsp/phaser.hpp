@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../lib/juce_FastMathApproximations.h"
 #include "../../../lib/vcl.hpp"
 
@@ -10,6 +11,7 @@
 #include <cmath>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 // Order 2 Thiran all-pass filter.
 template<typename Sample> struct ThiranAllpass2 {
@@ -191,4 +193,5 @@ struct Thiran2Phaser16 {
   }
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
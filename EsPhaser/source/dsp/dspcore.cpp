@@ -10,14 +10,14 @@
 #include <algorithm>
 #include <numeric>
 
-#define DSPCORE_NAME DSPCore_FixedInstruction
+#define DSPCORE_NAME UHHYOU_SIMD_NAME(DSPCore_)
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   interpPhase.setRange(float(twopi));
 
@@ -27,7 +27,7 @@ void DSPCORE_NAME::setup(double sampleRate)
 }
 
 #define ASSIGN_PARAMETER(METHOD)                                                         \
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());               \
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());                      \
                                                                                          \
   interpMix.METHOD(param.value[ID::mix]->getFloat());                                    \
   interpFrequency.METHOD(                                                                \
@@ -79,7 +79,7 @@ void DSPCORE_NAME::process(
   ScopedNoDenormals scopedDenormals;
 
   auto len_f = float(length);
-  SmootherCommon<float>::setBufferSize(float(len_f));
+  smootherContext.setBufferSize(float(len_f));
   phaser[0].interpStage.setBufferSize(float(len_f));
   phaser[1].interpStage.setBufferSize(float(len_f));
 
@@ -103,3 +103,8 @@ void DSPCORE_NAME::process(
     out1[i] = in1[i] + mix * (phaser1 - in1[i]);
   }
 }
+
+std::unique_ptr<DSPInterface> UHHYOU_SIMD_NAME(makeDSPCore_)()
+{
+  return std::make_unique<DSPCORE_NAME>();
+}
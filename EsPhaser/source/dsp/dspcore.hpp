@@ -4,12 +4,14 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "phaser.hpp"
 
 #include <array>
 #include <cmath>
+#include <memory>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
@@ -46,18 +48,25 @@ public:
                                                                                          \
   private:                                                                               \
     float sampleRate = 44100.0f;                                                         \
+    SmootherContext<float> smootherContext;                                              \
                                                                                          \
     std::array<Thiran2Phaser, 2> phaser;                                                 \
                                                                                          \
-    LinearSmoother<float> interpMix;                                                     \
-    LinearSmoother<float> interpFrequency;                                               \
-    LinearSmoother<float> interpFreqSpread;                                              \
-    LinearSmoother<float> interpFeedback;                                                \
-    LinearSmoother<float> interpRange;                                                   \
-    LinearSmoother<float> interpMin;                                                     \
-    RotarySmoother<float> interpPhase;                                                   \
-    LinearSmoother<float> interpStereoOffset;                                            \
-    LinearSmoother<float> interpCascadeOffset;                                           \
+    LinearSmoother<float> interpMix{smootherContext};                                    \
+    LinearSmoother<float> interpFrequency{smootherContext};                              \
+    LinearSmoother<float> interpFreqSpread{smootherContext};                             \
+    LinearSmoother<float> interpFeedback{smootherContext};                               \
+    LinearSmoother<float> interpRange{smootherContext};                                  \
+    LinearSmoother<float> interpMin{smootherContext};                                    \
+    RotarySmoother<float> interpPhase{smootherContext};                                  \
+    LinearSmoother<float> interpStereoOffset{smootherContext};                           \
+    LinearSmoother<float> interpCascadeOffset{smootherContext};                          \
   };
 
-DSPCORE_CLASS(FixedInstruction)
+UHHYOU_SIMD_APPLY(DSPCORE_CLASS)
+
+// Variant of current translation unit. Tests use this without dispatch.
+using DSPCore_FixedInstruction = UHHYOU_SIMD_NAME(DSPCore_);
+
+// Defined in `dspcore.cpp` for each variant. Use `UHHYOU_SIMD_DISPATCH(makeDSPCore_)`.
+UHHYOU_SIMD_DECLARE_FACTORY(std::unique_ptr<DSPInterface>, makeDSPCore_)
@@ -6,6 +6,7 @@
 #include "../../../lib/vcl.hpp"
 #include "../../../lib/vcl/vectormath_trig.h"
 
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/juce_FastMathApproximations.h"
 
@@ -13,6 +14,7 @@
 #include <iostream>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 // Old implementation of LinearSmoother in `common/smoother.hpp`.
 // EsPhaser relies on buggy behavior of this old smoother.
@@ -196,4 +198,5 @@ struct alignas(64) Thiran2Phaser {
   }
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 #include <memory>
@@ -51,6 +53,7 @@ protected:
 
   uint64_t lastState = 0;
   uint32_t wasBypassing = 0;
+  ProcessDriver processDriver;
   std::unique_ptr<DSPInterface> dsp;
 };
 
@@ -9,6 +9,9 @@
 #include <limits>
 #include <numeric>
 
+// Same as the LFO step of former versions that ran once per host block of 512 samples.
+constexpr float lfoIntervalSeconds = 512.0f / 48000.0f;
+
 template<typename T> T lerp(T a, T b, T t) { return a + t * (b - a); }
 
 template<typename T> inline T calcNotePitch(T note)
@@ -21,50 +24,178 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
-
-  for (size_t idx = 0; idx < nDelay; ++idx) {
-    lowpassLfoTime[0][idx].setCutoff(sampleRate, 1.0f);
-    lowpassLfoTime[1][idx].setCutoff(sampleRate, 1.0f);
-  }
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   gate.setup(sampleRate, 0.001f);
 
-  for (auto &fdn : feedbackDelayNetwork) fdn.setup(sampleRate, 1.0f);
+  matrixFadeLength = std::max(size_t(1), size_t(this->sampleRate * 0.01f));
+  engineFadeLength = std::max(size_t(1), size_t(this->sampleRate * 0.01f));
+  lfoInterval
+    = std::max(size_t(1), size_t(std::lround(this->sampleRate * lfoIntervalSeconds)));
+
+  engineTask.wait();
+  engineTask.poll();
+  isEngineRequested = false;
+  isEngineReady = false;
+  isEngineRetired = false;
+  engineFadeCounter = 0;
+  nextEngine = EngineVariant{};
+  retiredEngine = EngineVariant{};
+
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+  previousSeed = pv[ID::seed]->getInt();
+  previousMatrixType = pv[ID::matrixType]->getInt();
+  maxEngineSizeIndex = getMaxEngineSizeIndex();
+  engineSizeIndex = std::min(size_t(pv[ID::fdnSize]->getInt()), maxEngineSizeIndex);
+  nextEngineSizeIndex = engineSizeIndex;
+  engine = makeEngine(engineSizeIndex);
+  std::visit(
+    [&](auto &eng) { eng->setup(this->sampleRate, {previousMatrixType, previousSeed}); },
+    engine);
 
   reset();
   startup();
 }
 
+DSPCore::EngineVariant DSPCore::makeEngine(size_t sizeIndex)
+{
+  switch (sizeIndex) {
+    case 0:
+      return std::make_unique<FdnEngine<8>>();
+    case 1:
+      return std::make_unique<FdnEngine<16>>();
+    case 2:
+      return std::make_unique<FdnEngine<32>>();
+    case 4:
+      return std::make_unique<FdnEngine<128>>();
+    case 5:
+      return std::make_unique<FdnEngine<256>>();
+    default:
+      break;
+  }
+  return std::make_unique<FdnEngine<64>>();
+}
+
+/**
+Each line holds 1 second of delay, rounded up to power of 2 frames. Sizes above 64 are
+limited so that the buffers don't exceed 256 lines at 48 kHz, which is 64 MiB per channel.
+*/
+size_t DSPCore::getMaxEngineSizeIndex() const
+{
+  constexpr size_t maxLineFrames = size_t(256) << 16;
+  const auto frames = std::bit_ceil(size_t(sampleRate) + 1);
+  size_t index = 5;
+  while (index > 3 && lineCount(index) * frames > maxLineFrames) --index;
+  return index;
+}
+
+// Runs on the worker thread.
+void DSPCore::buildEngine()
+{
+  retiredEngine = EngineVariant{};
+  if (!isEngineRequested) return;
+
+  nextEngine = makeEngine(nextEngineSizeIndex);
+  std::visit([&](auto &eng) { eng->setup(sampleRate, nextMatrixInput); }, nextEngine);
+}
+
+void DSPCore::swapEngine()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  std::swap(engine, nextEngine);
+  retiredEngine = std::move(nextEngine);
+  nextEngine = EngineVariant{};
+  isEngineRetired = true;
+  isEngineReady = false;
+  engineSizeIndex = nextEngineSizeIndex;
+
+  matrixFadeCounter = 0;
+  crossBuffer.fill(0);
+  isCutoffChanged = true;
+
+  fillDelayTime();
+  FeedbackMatrixInput matrixInput{previousMatrixType, previousSeed};
+  std::visit(
+    [&](auto &eng) {
+      eng->resetLfo(rng);
+      eng->setRate(pv[ID::delayTimeInterpRate]->getFloat());
+      eng->resetDelayTime(delayTime, delayTimeLfo);
+      eng->prepare(sampleRate, pv[ID::splitRotationHz]->getFloat());
+      if (eng->matrixInput != matrixInput) eng->requestMatrix(matrixInput);
+    },
+    engine);
+}
+
 size_t DSPCore::getLatency() { return 0; }
 
+size_t DSPCore::getTailLength()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  // Non-orthogonal matrices may amplify the loop signal, and their gain isn't bounded
+  // cheaply. The silence detector measures the output for them. See `getLoopLength()`.
+  if (!FeedbackMatrixType::isOrthogonal(pv[ID::matrixType]->getInt())) {
+    return infiniteTail;
+  }
+
+  // Orthogonal matrix keeps the L2 norm, and the lowpass and highpass in the loop have
+  // gains at most 1. Therefore a round trip of the longest delay scales the loop signal
+  // by at most `feedback`. For full scale input, the L2 norm of the loop signal is
+  // bounded by `sqrt(nLine) / (1 - feedback)`, and the output is the sum of the lines.
+  // The engine may be swapped to the requested size, so the larger one is used.
+  auto nLine = lineCount(std::max(
+    engineSizeIndex, std::min(size_t(pv[ID::fdnSize]->getInt()), maxEngineSizeIndex)));
+  auto feedback = std::abs(pv[ID::feedback]->getFloat());
+  auto peak = std::abs(pv[ID::wet]->getFloat()) * float(nLine) / (1.0f - feedback);
+  return feedbackTailLength(float(getLoopLength()), feedback, peak);
+}
+
+size_t DSPCore::getLoopLength()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  auto timeMul = pv[ID::timeMultiplier]->getFloat() * notePitchMultiplier;
+  float maxTime = 0;
+  for (size_t idx = 0; idx < nDelay; ++idx) {
+    maxTime = std::max(
+      maxTime,
+      timeMul * pv[ID::delayTime0 + idx]->getFloat()
+        + pv[ID::timeLfoAmount0 + idx]->getFloat());
+  }
+  return size_t(std::ceil(sampleRate * std::min(maxTime, 1.0f)));
+}
+
 #define ASSIGN_PARAMETER(METHOD)                                                         \
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  for (auto &fdn : feedbackDelayNetwork) {                                               \
-    fdn.rate = pv[ID::delayTimeInterpRate]->getFloat();                                  \
-  }                                                                                      \
+  fillDelayTime();                                                                       \
+  std::visit(                                                                            \
+    [&](auto &eng) {                                                                     \
+      eng->setRate(pv[ID::delayTimeInterpRate]->getFloat());                             \
+      eng->METHOD##DelayTime(delayTime, delayTimeLfo);                                   \
+    },                                                                                   \
+    engine);                                                                             \
                                                                                          \
-  auto timeMul = pv[ID::timeMultiplier]->getFloat() * notePitchMultiplier;               \
   for (size_t idx = 0; idx < nDelay; ++idx) {                                            \
-    auto time = timeMul * sampleRate * pv[ID::delayTime0 + idx]->getFloat();             \
-    auto timeLfo = sampleRate * pv[ID::timeLfoAmount0 + idx]->getFloat();                \
-                                                                                         \
-    feedbackDelayNetwork[0].delayTimeSample[idx].METHOD(                                 \
-      time + timeLfo * lowpassLfoTime[0][idx].value);                                    \
-    feedbackDelayNetwork[1].delayTimeSample[idx].METHOD(                                 \
-      time + timeLfo * lowpassLfoTime[1][idx].value);                                    \
-                                                                                         \
-    auto &&lowpassCutoffHz = pv[ID::lowpassCutoffHz0 + idx]->getFloat();                 \
-    interpLowpassCutoff[idx].METHOD(                                                     \
-      lowpassCutoffHz >= Scales::lowpassCutoffHz.getMax()                                \
-        ? 1.0f                                                                           \
-        : float(EMAFilter<double>::cutoffToP(sampleRate, lowpassCutoffHz)));             \
-    auto &&highpassCutoffHz = pv[ID::highpassCutoffHz0 + idx]->getFloat();               \
-    interpHighpassCutoff[idx].METHOD(                                                    \
-      float(EMAFilter<double>::cutoffToP(sampleRate, highpassCutoffHz)));                \
+    if (param.changed.test(ID::lowpassCutoffHz0 + idx)) {                                \
+      auto &&lowpassCutoffHz = pv[ID::lowpassCutoffHz0 + idx]->getFloat();               \
+      interpLowpassCutoff[idx].METHOD(                                                   \
+        lowpassCutoffHz >= Scales::lowpassCutoffHz.getMax()                              \
+          ? 1.0f                                                                         \
+          : float(EMAFilter<double>::cutoffToP(sampleRate, lowpassCutoffHz)));           \
+    }                                                                                    \
+    if (param.changed.test(ID::highpassCutoffHz0 + idx)) {                               \
+      auto &&highpassCutoffHz = pv[ID::highpassCutoffHz0 + idx]->getFloat();             \
+      interpHighpassCutoff[idx].METHOD(                                                  \
+        float(EMAFilter<double>::cutoffToP(sampleRate, highpassCutoffHz)));              \
+    }                                                                                    \
   }                                                                                      \
   interpSplitPhaseOffset.METHOD(pv[ID::splitPhaseOffset]->getFloat());                   \
   interpSplitSkew.METHOD(std::pow(2.0f, pv[ID::splitSkew]->getFloat()) - 1.0f);          \
@@ -83,17 +214,18 @@ void DSPCore::reset()
   noteStack.clear();
   notePitchMultiplier = float(1);
 
-  std::uniform_real_distribution<float> timeLfoDist(0.0f, 1.0f);
-  for (size_t idx = 0; idx < nDelay; ++idx) {
-    lowpassLfoTime[0][idx].reset(timeLfoDist(rng));
-    lowpassLfoTime[1][idx].reset(timeLfoDist(rng));
-  }
+  lfoCounter = 0;
+  std::visit([&](auto &eng) { eng->resetLfo(rng); }, engine);
 
+  param.changed.markAll();
   ASSIGN_PARAMETER(reset);
 
   crossBuffer.fill(0);
   gate.reset();
-  for (auto &fdn : feedbackDelayNetwork) fdn.reset();
+  std::visit([](auto &eng) { eng->reset(); }, engine);
+  isCutoffChanged = true;
+  matrixFadeCounter = 0;
+  engineFadeCounter = 0;
   startup();
 }
 
@@ -101,34 +233,39 @@ void DSPCore::startup() {}
 
 void DSPCore::setParameters()
 {
-  std::uniform_real_distribution<float> timeLfoDist(0.0f, 1.0f);
-  for (size_t idx = 0; idx < nDelay; ++idx) {
-    lowpassLfoTime[0][idx].process(timeLfoDist(rng));
-    lowpassLfoTime[1][idx].process(timeLfoDist(rng));
-  }
-
   ASSIGN_PARAMETER(push);
 
-  auto &&splitRotationHz = pv[ID::splitRotationHz]->getFloat();
-  for (auto &fdn : feedbackDelayNetwork) fdn.prepare(sampleRate, splitRotationHz);
+  if (param.changed.test(ID::splitRotationHz)) {
+    auto &&splitRotationHz = pv[ID::splitRotationHz]->getFloat();
+    std::visit([&](auto &eng) { eng->prepare(sampleRate, splitRotationHz); }, engine);
+  }
 
   unsigned seed = pv[ID::seed]->getInt();
   unsigned matrixType = pv[ID::matrixType]->getInt();
   if (
-    prepareRefresh || (!isMatrixRefeshed && pv[ID::refreshMatrix]->getInt())
-    || seed != previousSeed || previousMatrixType != matrixType)
+    (!isMatrixRefeshed && pv[ID::refreshMatrix]->getInt()) || seed != previousSeed
+    || previousMatrixType != matrixType)
   {
     previousSeed = seed;
     previousMatrixType = matrixType;
-
-    pcg64 matrixRng{seed};
-    std::uniform_int_distribution<unsigned> seedDist{
-      0, std::numeric_limits<unsigned>::max()};
-    feedbackDelayNetwork[0].randomizeMatrix(matrixType, seedDist(matrixRng));
-    feedbackDelayNetwork[1].randomizeMatrix(matrixType, seedDist(matrixRng));
+    std::visit([&](auto &eng) { eng->requestMatrix({matrixType, seed}); }, engine);
   }
   isMatrixRefeshed = pv[ID::refreshMatrix]->getInt();
-  prepareRefresh = false;
+
+  size_t sizeIndex = std::min(size_t(pv[ID::fdnSize]->getInt()), maxEngineSizeIndex);
+  if (
+    sizeIndex != engineSizeIndex && !isEngineRequested && !isEngineReady
+    && !engineTask.isBusy())
+  {
+    nextEngineSizeIndex = sizeIndex;
+    nextMatrixInput = {previousMatrixType, previousSeed};
+    isEngineRequested = true;
+    if (engineTask.submit()) {
+      isEngineRetired = false;
+    } else {
+      isEngineRequested = false;
+    }
+  }
 }
 
 void DSPCore::process(
@@ -136,39 +273,99 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
+
+  if (engineTask.poll() && isEngineRequested) {
+    isEngineRequested = false;
+    isEngineReady = true;
+    engineFadeCounter = engineFadeLength;
+  }
+  if (isEngineReady && engineFadeCounter == 0 && !engineTask.isBusy()) swapEngine();
+  if (isEngineRetired && engineTask.submit()) isEngineRetired = false;
+
+  // The LFO steps by elapsed samples, so that its rate doesn't depend on how the host
+  // block is split into sub-blocks.
+  lfoCounter += length;
+  std::visit(
+    [&](auto &eng) {
+      for (; lfoCounter >= lfoInterval; lfoCounter -= lfoInterval) eng->processLfo(rng);
+      eng->pushDelayTime(delayTime, delayTimeLfo);
+    },
+    engine);
+  std::visit(
+    [&](auto &eng) { processEngine(*eng, length, in0, in1, out0, out1); }, engine);
+}
+
+template<size_t nLine>
+void DSPCore::processEngine(
+  FdnEngine<nLine> &eng,
+  const size_t length,
+  const float *in0,
+  const float *in1,
+  float *out0,
+  float *out1)
+{
+  if (eng.matrix.update()) matrixFadeCounter = matrixFadeLength;
+  const auto &matrix = eng.matrix.front();
+  const auto &previousMatrix = eng.matrix.previous();
+  auto &fdn = eng.fdn;
+
+  for (size_t start = 0; start < length; start += controlBlockSize) {
+    const size_t blockLength = std::min(controlBlockSize, length - start);
+    interpSplitPhaseOffset.processBlock(blockSplitPhaseOffset.data(), blockLength);
+    interpSplitSkew.processBlock(blockSplitSkew.data(), blockLength);
+    interpStereoCross.processBlock(blockStereoCross.data(), blockLength);
+    interpFeedback.processBlock(blockFeedback.data(), blockLength);
+    interpDry.processBlock(blockDry.data(), blockLength);
+    interpWet.processBlock(blockWet.data(), blockLength);
+
+    for (size_t j = 0; j < blockLength; ++j) {
+      const size_t i = start + j;
+      processMidiNote(i);
+
+      // Remapping to the lines is skipped once the smoothers settle.
+      for (size_t idx = 0; idx < nDelay; ++idx) {
+        auto lp = interpLowpassCutoff[idx].process();
+        auto hp = interpHighpassCutoff[idx].process();
+        isCutoffChanged |= lp != lowpassKp[idx] || hp != highpassKp[idx];
+        lowpassKp[idx] = lp;
+        highpassKp[idx] = hp;
+      }
+      if (isCutoffChanged) {
+        eng.setCutoff(lowpassKp, highpassKp);
+        isCutoffChanged = false;
+      }
 
-  for (size_t i = 0; i < length; ++i) {
-    processMidiNote(i);
+      auto gateOut = gate.process(std::max(std::fabs(in0[i]), std::fabs(in1[i])));
+      auto stereoCross
+        = std::min(1.0f, blockStereoCross[j] + (1.0f - blockStereoCross[j]) * gateOut);
 
-    for (size_t idx = 0; idx < nDelay; ++idx) {
-      auto lowpassCutoff = interpLowpassCutoff[idx].process();
-      auto highpassCutoff = interpHighpassCutoff[idx].process();
-      for (auto &fdn : feedbackDelayNetwork) {
-        fdn.lowpassKp[idx] = lowpassCutoff;
-        fdn.highpassKp[idx] = highpassCutoff;
+      float matrixFade = 1.0f;
+      if (matrixFadeCounter > 0) {
+        --matrixFadeCounter;
+        matrixFade = 1.0f - float(matrixFadeCounter) / float(matrixFadeLength);
+        if (matrixFadeCounter == 0) eng.matrix.release();
       }
-    }
 
-    auto splitPhaseOffset = interpSplitPhaseOffset.process();
-    auto splitSkew = interpSplitSkew.process();
-    auto stereoCross = interpStereoCross.process();
-    auto feedback = interpFeedback.process();
-
-    auto gateOut = gate.process(std::max(std::fabs(in0[i]), std::fabs(in1[i])));
-    stereoCross = std::min(1.0f, stereoCross + (1.0f - stereoCross) * gateOut);
-
-    auto fdnBuf0 = feedbackDelayNetwork[0].preProcess(splitPhaseOffset, splitSkew);
-    auto fdnBuf1 = feedbackDelayNetwork[1].preProcess(splitPhaseOffset, splitSkew);
-    crossBuffer[0]
-      = feedbackDelayNetwork[0].process(in0[i], fdnBuf1, stereoCross, feedback);
-    crossBuffer[1]
-      = feedbackDelayNetwork[1].process(in1[i], fdnBuf0, stereoCross, feedback);
-
-    auto dry = interpDry.process();
-    auto wet = interpWet.process();
-    out0[i] = dry * in0[i] + wet * crossBuffer[0];
-    out1[i] = dry * in1[i] + wet * crossBuffer[1];
+      auto fdnBuf0 = fdn[0].preProcess(
+        matrix[0], previousMatrix[0], matrixFade, blockSplitPhaseOffset[j],
+        blockSplitSkew[j]);
+      auto fdnBuf1 = fdn[1].preProcess(
+        matrix[1], previousMatrix[1], matrixFade, blockSplitPhaseOffset[j],
+        blockSplitSkew[j]);
+      crossBuffer[0] = fdn[0].process(in0[i], fdnBuf1, stereoCross, blockFeedback[j]);
+      crossBuffer[1] = fdn[1].process(in1[i], fdnBuf0, stereoCross, blockFeedback[j]);
+
+      auto wet = blockWet[j];
+      if (isEngineReady) {
+        // Fading out before swapping to the engine of another size.
+        if (engineFadeCounter > 0) --engineFadeCounter;
+        wet *= float(engineFadeCounter) / float(engineFadeLength);
+      }
+
+      out0[i] = blockDry[j] * in0[i] + wet * crossBuffer[0];
+      out1[i] = blockDry[j] * in1[i] + wet * crossBuffer[1];
+    }
   }
 }
 
@@ -196,19 +393,20 @@ void DSPCore::noteOff(int_fast32_t noteId)
   updateDelayTime();
 }
 
-void DSPCore::updateDelayTime()
+void DSPCore::fillDelayTime()
 {
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
   auto timeMul = pv[ID::timeMultiplier]->getFloat() * notePitchMultiplier;
   for (size_t idx = 0; idx < nDelay; ++idx) {
-    auto time = timeMul * sampleRate * pv[ID::delayTime0 + idx]->getFloat();
-    auto timeLfo = sampleRate * pv[ID::timeLfoAmount0 + idx]->getFloat();
-
-    feedbackDelayNetwork[0].delayTimeSample[idx].push(
-      time + timeLfo * lowpassLfoTime[0][idx].value);
-    feedbackDelayNetwork[1].delayTimeSample[idx].push(
-      time + timeLfo * lowpassLfoTime[1][idx].value);
+    delayTime[idx] = timeMul * sampleRate * pv[ID::delayTime0 + idx]->getFloat();
+    delayTimeLfo[idx] = sampleRate * pv[ID::timeLfoAmount0 + idx]->getFloat();
   }
 }
+
+void DSPCore::updateDelayTime()
+{
+  fillDelayTime();
+  std::visit([&](auto &eng) { eng->pushDelayTime(delayTime, delayTimeLfo); }, engine);
+}
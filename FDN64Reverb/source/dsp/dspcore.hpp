@@ -3,16 +3,166 @@
 
 #pragma once
 
+#include "../../../common/backgroundjob.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/silence.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "fdnreverb.hpp"
 
 #include <array>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <variant>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
 
+struct FeedbackMatrixInput {
+  unsigned matrixType = 0;
+  unsigned seed = 0;
+
+  bool operator==(const FeedbackMatrixInput &) const = default;
+};
+
+/**
+FDN and its per line states for `nLine` delays. Parameters are defined for `nDelay` lines,
+and they are linearly interpolated to `nLine` lines. When `nLine == nDelay`, the
+parameters are used as is.
+
+Not realtime safe to construct or `setup()`. Allocates.
+*/
+template<size_t nLine> struct FdnEngine {
+  using MatrixPair = std::array<FeedbackMatrix<float, nLine>, 2>;
+
+  std::array<FeedbackDelayNetwork<float, nLine>, 2> fdn;
+  std::array<std::array<EMAFilter<float>, nLine>, 2> lowpassLfoTime;
+
+  std::array<size_t, nLine> paramIndex{};
+  std::array<float, nLine> paramFraction{};
+
+  FeedbackMatrixInput matrixInput;
+  BackgroundDoubleBuffer<MatrixPair, FeedbackMatrixInput> matrix{buildMatrix};
+
+  static void buildMatrix(MatrixPair &pair, const FeedbackMatrixInput &input)
+  {
+    pcg64 matrixRng{input.seed};
+    std::uniform_int_distribution<unsigned> seedDist{
+      0, std::numeric_limits<unsigned>::max()};
+    pair[0].randomize(input.matrixType, seedDist(matrixRng));
+    pair[1].randomize(input.matrixType, seedDist(matrixRng));
+  }
+
+  void setup(float sampleRate, FeedbackMatrixInput input)
+  {
+    for (size_t line = 0; line < nLine; ++line) {
+      paramIndex[line] = line * nDelay / nLine;
+      paramFraction[line] = float(line * nDelay % nLine) / float(nLine);
+
+      lowpassLfoTime[0][line].setCutoff(sampleRate, 1.0f);
+      lowpassLfoTime[1][line].setCutoff(sampleRate, 1.0f);
+    }
+
+    for (auto &fd : fdn) fd.setup(sampleRate, 1.0f);
+
+    matrixInput = input;
+    matrix.reset(input);
+  }
+
+  void reset()
+  {
+    for (auto &fd : fdn) fd.reset();
+    matrix.release();
+  }
+
+  void requestMatrix(FeedbackMatrixInput input)
+  {
+    matrixInput = input;
+    matrix.request(input);
+  }
+
+  inline float remap(const std::array<float, nDelay> &value, size_t line) const
+  {
+    const auto i0 = paramIndex[line];
+    const auto i1 = std::min(i0 + 1, nDelay - 1);
+    return value[i0] + paramFraction[line] * (value[i1] - value[i0]);
+  }
+
+  template<typename Rng> void resetLfo(Rng &rng)
+  {
+    std::uniform_real_distribution<float> timeLfoDist(0.0f, 1.0f);
+    for (size_t line = 0; line < nLine; ++line) {
+      lowpassLfoTime[0][line].reset(timeLfoDist(rng));
+      lowpassLfoTime[1][line].reset(timeLfoDist(rng));
+    }
+  }
+
+  template<typename Rng> void processLfo(Rng &rng)
+  {
+    std::uniform_real_distribution<float> timeLfoDist(0.0f, 1.0f);
+    for (size_t line = 0; line < nLine; ++line) {
+      lowpassLfoTime[0][line].process(timeLfoDist(rng));
+      lowpassLfoTime[1][line].process(timeLfoDist(rng));
+    }
+  }
+
+  void prepare(float sampleRate, float splitRotationHz)
+  {
+    for (auto &fd : fdn) fd.prepare(sampleRate, splitRotationHz);
+  }
+
+  void setRate(float rate)
+  {
+    for (auto &fd : fdn) fd.rate = rate;
+  }
+
+  template<bool isReset>
+  void setDelayTime(
+    const std::array<float, nDelay> &time, const std::array<float, nDelay> &timeLfo)
+  {
+    for (size_t line = 0; line < nLine; ++line) {
+      auto lineTime = remap(time, line);
+      auto lineTimeLfo = remap(timeLfo, line);
+      for (size_t ch = 0; ch < fdn.size(); ++ch) {
+        auto value = lineTime + lineTimeLfo * lowpassLfoTime[ch][line].value;
+        if constexpr (isReset) {
+          fdn[ch].delayTimeSample[line].reset(value);
+        } else {
+          fdn[ch].delayTimeSample[line].push(value);
+        }
+      }
+    }
+  }
+
+  void resetDelayTime(
+    const std::array<float, nDelay> &time, const std::array<float, nDelay> &timeLfo)
+  {
+    setDelayTime<true>(time, timeLfo);
+  }
+
+  void pushDelayTime(
+    const std::array<float, nDelay> &time, const std::array<float, nDelay> &timeLfo)
+  {
+    setDelayTime<false>(time, timeLfo);
+  }
+
+  void setCutoff(
+    const std::array<float, nDelay> &lowpassKp,
+    const std::array<float, nDelay> &highpassKp)
+  {
+    for (size_t line = 0; line < nLine; ++line) {
+      auto lineLowpassKp = remap(lowpassKp, line);
+      auto lineHighpassKp = remap(highpassKp, line);
+      for (auto &fd : fdn) {
+        fd.lowpassKp[line] = lineLowpassKp;
+        fd.highpassKp[line] = lineHighpassKp;
+      }
+    }
+  }
+};
+
 class DSPCore {
 public:
   struct NoteInfo {
@@ -23,11 +173,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
 
@@ -35,6 +181,8 @@ public:
   void reset();
   void startup();
   size_t getLatency();
+  size_t getTailLength();
+  size_t getLoopLength();
   void setParameters();
   void process(
     const size_t length, const float *in0, const float *in1, float *out0, float *out1);
@@ -55,51 +203,109 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
+  using EngineVariant = std::variant<
+    std::unique_ptr<FdnEngine<8>>,
+    std::unique_ptr<FdnEngine<16>>,
+    std::unique_ptr<FdnEngine<32>>,
+    std::unique_ptr<FdnEngine<64>>,
+    std::unique_ptr<FdnEngine<128>>,
+    std::unique_ptr<FdnEngine<256>>>;
+
+  static EngineVariant makeEngine(size_t sizeIndex);
+  static size_t lineCount(size_t sizeIndex) { return size_t(8) << sizeIndex; }
+  size_t getMaxEngineSizeIndex() const;
+  void buildEngine();
+  void swapEngine();
+  void fillDelayTime();
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  template<size_t nLine>
+  void processEngine(
+    FdnEngine<nLine> &eng,
+    const size_t length,
+    const float *in0,
+    const float *in1,
+    float *out0,
+    float *out1);
+
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
-  bool prepareRefresh = true;
   bool isMatrixRefeshed = false;
   unsigned previousSeed = 0;
   unsigned previousMatrixType = 0;
   pcg64 rng;
 
+  // Delay time LFO steps once per `lfoInterval` samples.
+  size_t lfoInterval = 1;
+  size_t lfoCounter = 0;
+
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   std::array<float, 2> crossBuffer{};
 
-  std::array<std::array<EMAFilter<float>, nDelay>, 2> lowpassLfoTime;
+  std::array<ExpSmoother<float>, nDelay> interpLowpassCutoff
+    = makeSmootherArray<ExpSmoother<float>, nDelay>(smootherContext);
+  std::array<ExpSmoother<float>, nDelay> interpHighpassCutoff
+    = makeSmootherArray<ExpSmoother<float>, nDelay>(smootherContext);
+  RotarySmoother<float> interpSplitPhaseOffset{smootherContext};
+  ExpSmoother<float> interpSplitSkew{smootherContext};
+  ExpSmoother<float> interpStereoCross{smootherContext};
+  ExpSmoother<float> interpFeedback{smootherContext};
+  ExpSmoother<float> interpDry{smootherContext};
+  ExpSmoother<float> interpWet{smootherContext};
+
+  // Smoothers above are filled for each control block, then read in the sample loop.
+  static constexpr size_t controlBlockSize = 64;
+  std::array<float, controlBlockSize> blockSplitPhaseOffset{};
+  std::array<float, controlBlockSize> blockSplitSkew{};
+  std::array<float, controlBlockSize> blockStereoCross{};
+  std::array<float, controlBlockSize> blockFeedback{};
+  std::array<float, controlBlockSize> blockDry{};
+  std::array<float, controlBlockSize> blockWet{};
 
-  std::array<ExpSmoother<float>, nDelay> interpLowpassCutoff;
-  std::array<ExpSmoother<float>, nDelay> interpHighpassCutoff;
-  RotarySmoother<float> interpSplitPhaseOffset;
-  ExpSmoother<float> interpSplitSkew;
-  ExpSmoother<float> interpStereoCross;
-  ExpSmoother<float> interpFeedback;
-  ExpSmoother<float> interpDry;
-  ExpSmoother<float> interpWet;
+  // Per parameter values before remapping to the lines of current engine.
+  std::array<float, nDelay> delayTime{};
+  std::array<float, nDelay> delayTimeLfo{};
+  std::array<float, nDelay> lowpassKp{};
+  std::array<float, nDelay> highpassKp{};
+  bool isCutoffChanged = true;
 
   EasyGate<float> gate;
-  std::array<FeedbackDelayNetwork<float, nDelay>, 2> feedbackDelayNetwork;
+
+  // Matrices are built on a worker thread, then crossfaded over `matrixFadeLength`.
+  size_t matrixFadeLength = 1;
+  size_t matrixFadeCounter = 0;
+
+  // Engine of the other size is built on a worker thread. The wet signal fades out over
+  // `engineFadeLength`, then engines are swapped. The old engine is freed on the worker.
+  size_t engineSizeIndex = 3;
+  size_t nextEngineSizeIndex = 3;
+  size_t maxEngineSizeIndex = 5;
+  FeedbackMatrixInput nextMatrixInput;
+  bool isEngineRequested = false;
+  bool isEngineReady = false;
+  bool isEngineRetired = false;
+  size_t engineFadeLength = 1;
+  size_t engineFadeCounter = 0;
+  EngineVariant engine = makeEngine(engineSizeIndex);
+  EngineVariant nextEngine;
+  EngineVariant retiredEngine;
+  BackgroundTask engineTask{[this]() { buildEngine(); }};
 };
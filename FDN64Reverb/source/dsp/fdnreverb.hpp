@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/delay.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../../../lib/pcg-cpp/pcg_random.hpp"
 #include "matrixtype.hpp"
@@ -51,44 +52,6 @@ public:
   }
 };
 
-template<typename Sample> class Delay {
-public:
-  int wptr = 0;
-  std::vector<Sample> buf;
-
-  void setup(Sample sampleRate, Sample maxTime)
-  {
-    auto &&size = size_t(sampleRate * maxTime) + 2;
-    buf.resize(size < 4 ? 4 : size);
-
-    reset();
-  }
-
-  void reset() { std::fill(buf.begin(), buf.end(), Sample(0)); }
-
-  Sample process(Sample input, Sample timeInSample)
-  {
-    const int bufSize = int(buf.size());
-
-    // Set delay time.
-    Sample clamped = std::clamp(timeInSample, Sample(0), Sample(bufSize - 1));
-    int timeInt = int(clamped);
-    Sample rFraction = clamped - Sample(timeInt);
-
-    int rptr0 = wptr - timeInt;
-    int rptr1 = rptr0 - 1;
-    if (rptr0 < 0) rptr0 += bufSize; // Unsigned negative overflow case.
-    if (rptr1 < 0) rptr1 += bufSize; // Unsigned negative overflow case.
-
-    // Write to buffer.
-    buf[wptr] = input;
-    if (++wptr >= bufSize) wptr = 0;
-
-    // Read from buffer.
-    return buf[rptr0] + rFraction * (buf[rptr1] - buf[rptr0]);
-  }
-};
-
 // Integer sample delay.
 template<typename Sample> class IntDelay {
 private:
@@ -268,27 +231,29 @@ public:
 };
 
 /**
-If `length` is too long, compiler might silently fail to allocate stack.
+Feedback matrix of `FeedbackDelayNetwork`. Separated from the network, so that a new
+matrix can be built off the audio thread and crossfaded with the old one.
 */
-template<typename Sample, size_t length> class FeedbackDelayNetwork {
+template<typename Sample, size_t length> class FeedbackMatrix {
 private:
+  // Non-zero pattern of `matrix`, used to pick a faster kernel in `multiply`.
+  enum class MatrixStructure {
+    dense,
+    hadamard,        // Sylvester's construction. Fast Walsh-Hadamard transform.
+    rankOne,         // `u * u^T - I`. Used by `circulant*` types.
+    schroeder,       // Diagonal, except last 2 rows.
+    absorbent,       // Half size orthogonal matrix and diagonals.
+  };
+
   std::array<std::array<Sample, length>, length> matrix{};
-  std::array<std::array<Sample, length>, 2> buf{};
-  std::array<Delay<Sample>, length> delay;
-  std::array<DoubleEMAFilterKp<Sample>, length> lowpass;
-  std::array<EMAHighpass<Sample>, length> highpass;
 
-  std::array<Sample, length> splitGain{};
-  size_t cycle = 100000;
-  size_t counter = 0;
-  size_t bufIndex = 0;
+  // `matrixTransposed[j]` is the column `j` of `matrix`. Products are computed as a sum
+  // of columns, so the inner loops are contiguous and free of horizontal reduction.
+  alignas(64) std::array<std::array<Sample, length>, length> matrixTransposed{};
 
+  MatrixStructure structure = MatrixStructure::dense;
+  std::array<Sample, length> rankOneVector{};
 public:
-  Sample rate = Sample(1);
-  std::array<RateLimiter<Sample>, length> delayTimeSample;
-  std::array<Sample, length> lowpassKp{};
-  std::array<Sample, length> highpassKp{};
-
   /**
   Randomize `H` as orthogonal matrix. This algorithm is ported from
   `scipy.stats.ortho_group` in SciPy v1.8.0.
@@ -403,13 +368,13 @@ public:
     std::uniform_real_distribution<Sample> dist{Sample(0), Sample(1)};
 
     size_t left = 0;
-    if (band >= length) {
-      band = length;
+    if (band >= dim) {
+      band = dim;
     } else {
       left = 1;
     }
 
-    std::array<Sample, length> source{};
+    std::array<Sample, dim> source{};
     Sample sum = 0;
     do {
       sum = 0;
@@ -421,11 +386,11 @@ public:
 
     Sample scale = Sample(2) / sum;
 
-    std::array<Sample, length> squared;
-    for (size_t i = 0; i < length; ++i) squared[i] = std::sqrt(source[i]);
+    std::array<Sample, dim> squared;
+    for (size_t i = 0; i < dim; ++i) squared[i] = std::sqrt(source[i]);
 
-    for (size_t row = 0; row < length; ++row) {
-      for (size_t col = 0; col < length; ++col) {
+    for (size_t row = 0; row < dim; ++row) {
+      for (size_t col = 0; col < dim; ++col) {
         mat[row][col] = row == col ? scale * source[row] - Sample(1)
                                    : scale * squared[row] * squared[col];
       }
@@ -446,10 +411,10 @@ public:
 
     mat.fill({});
 
-    for (size_t row = 0; row < length; ++row) {
-      for (size_t col = row; col < length; ++col) mat[row][col] = dist(rng);
+    for (size_t row = 0; row < dim; ++row) {
+      for (size_t col = row; col < dim; ++col) mat[row][col] = dist(rng);
     }
-    for (size_t col = 0; col < length; ++col) {
+    for (size_t col = 0; col < dim; ++col) {
       Sample sum = 0;
       for (size_t row = 0; row < col + 1; ++row) sum += mat[row][col];
       Sample scale = Sample(2) / sum;
@@ -473,15 +438,15 @@ public:
 
     mat.fill({});
 
-    for (size_t row = 0; row < length; ++row) {
+    for (size_t row = 0; row < dim; ++row) {
       for (size_t col = 0; col < row + 1; ++col) mat[row][col] = dist(rng);
     }
-    for (size_t col = 0; col < length; ++col) {
+    for (size_t col = 0; col < dim; ++col) {
       Sample sum = 0;
-      for (size_t row = col; row < length; ++row) sum += mat[row][col];
+      for (size_t row = col; row < dim; ++row) sum += mat[row][col];
       Sample scale = Sample(2) / sum;
       mat[col][col] = scale * mat[col][col] - Sample(1);
-      for (size_t row = col + 1; row < length; ++row) mat[row][col] *= scale;
+      for (size_t row = col + 1; row < dim; ++row) mat[row][col] *= scale;
     }
   }
 
@@ -515,8 +480,7 @@ public:
   void randomSchroeder(
     unsigned seed, Sample low, Sample high, std::array<std::array<Sample, dim>, dim> &mat)
   {
-    static_assert(
-      length >= 2, "FeedbackDelayNetwork::randomSchroeder(): length must be >= 2.");
+    static_assert(dim >= 2, "FeedbackDelayNetwork::randomSchroeder(): dim must be >= 2.");
 
     pcg64 rng{};
     rng.seed(seed);
@@ -525,18 +489,18 @@ public:
 
     mat.fill({});
 
-    for (size_t idx = 0; idx < length; ++idx) mat[idx][idx] = dist(rng);
+    for (size_t idx = 0; idx < dim; ++idx) mat[idx][idx] = dist(rng);
 
-    auto &&paraGain = mat[length - 2][length - 2];
+    auto &&paraGain = mat[dim - 2][dim - 2];
     auto &&lastGain = Sample(1) - paraGain * paraGain;
-    auto scale2 = Sample(2) / (Sample(length - 2) + paraGain);
+    auto scale2 = Sample(2) / (Sample(dim - 2) + paraGain);
     auto scale1 = Sample(2)
-      / (Sample(length - 2) * paraGain + lastGain + matrix[length - 1][length - 1]);
-    for (size_t col = 0; col < length - 1; ++col) {
-      mat[length - 2][col] = scale2;
-      mat[length - 1][col] = -paraGain * scale1;
+      / (Sample(dim - 2) * paraGain + lastGain + mat[dim - 1][dim - 1]);
+    for (size_t col = 0; col < dim - 1; ++col) {
+      mat[dim - 2][col] = scale2;
+      mat[dim - 1][col] = -paraGain * scale1;
     }
-    mat[length - 1][length - 2] = lastGain * scale1;
+    mat[dim - 1][dim - 2] = lastGain * scale1;
   }
 
   /**
@@ -561,10 +525,9 @@ public:
   void randomAbsorbent(
     unsigned seed, Sample low, Sample high, std::array<std::array<Sample, dim>, dim> &mat)
   {
+    static_assert(dim >= 2, "FeedbackDelayNetwork::randomAbsorbent(): dim must be >= 2.");
     static_assert(
-      length >= 2, "FeedbackDelayNetwork::randomAbsorbent(): length must be >= 2.");
-    static_assert(
-      length % 2 == 0, "FeedbackDelayNetwork::randomAbsorbent(): length must be even.");
+      dim % 2 == 0, "FeedbackDelayNetwork::randomAbsorbent(): dim must be even.");
 
     pcg64 rng{};
     rng.seed(seed);
@@ -573,7 +536,7 @@ public:
     std::uniform_int_distribution<unsigned> seeder{
       0, std::numeric_limits<unsigned>::max()};
 
-    constexpr size_t half = length / 2;
+    constexpr size_t half = dim / 2;
 
     mat.fill({});
 
@@ -668,20 +631,26 @@ public:
     }
   }
 
-  void randomizeMatrix(unsigned matrixType, unsigned seed)
+  void randomize(unsigned matrixType, unsigned seed)
   {
+    structure = MatrixStructure::dense;
     if (matrixType == FeedbackMatrixType::specialOrthogonal) {
       randomSpecialOrthogonal(seed, matrix);
     } else if (matrixType == FeedbackMatrixType::circulantOrthogonal) {
       randomCirculantOrthogonal(seed, length, matrix);
+      structure = MatrixStructure::rankOne;
     } else if (matrixType == FeedbackMatrixType::circulant4) {
       randomCirculantOrthogonal(seed, 4, matrix);
+      structure = MatrixStructure::rankOne;
     } else if (matrixType == FeedbackMatrixType::circulant8) {
       randomCirculantOrthogonal(seed, 8, matrix);
+      structure = MatrixStructure::rankOne;
     } else if (matrixType == FeedbackMatrixType::circulant16) {
       randomCirculantOrthogonal(seed, 16, matrix);
+      structure = MatrixStructure::rankOne;
     } else if (matrixType == FeedbackMatrixType::circulant32) {
       randomCirculantOrthogonal(seed, 32, matrix);
+      structure = MatrixStructure::rankOne;
     } else if (matrixType == FeedbackMatrixType::upperTriangularPositive) {
       randomUpperTriangular(seed, 0, Sample(1), matrix);
     } else if (matrixType == FeedbackMatrixType::upperTriangularNegative) {
@@ -692,24 +661,151 @@ public:
       randomLowerTriangular(seed, Sample(-1), 0, matrix);
     } else if (matrixType == FeedbackMatrixType::schroederPositive) {
       randomSchroeder(seed, 0, Sample(1), matrix);
+      structure = MatrixStructure::schroeder;
     } else if (matrixType == FeedbackMatrixType::schroederNegative) {
       randomSchroeder(seed, Sample(-1), 0, matrix);
+      structure = MatrixStructure::schroeder;
     } else if (matrixType == FeedbackMatrixType::absorbentPositive) {
       randomAbsorbent(seed, 0, Sample(1), matrix);
+      structure = MatrixStructure::absorbent;
     } else if (matrixType == FeedbackMatrixType::absorbentNegative) {
       randomAbsorbent(seed, Sample(-1), 0, matrix);
+      structure = MatrixStructure::absorbent;
     } else if (matrixType == FeedbackMatrixType::hadamard) {
       constructHadamardSylvester(matrix);
+      structure = MatrixStructure::hadamard;
     } else if (matrixType == FeedbackMatrixType::conference) {
       constructConference(matrix);
     } else { // matrixType == FeedbackMatrixType::orthogonal, or default.
       randomOrthogonal(seed, matrix);
     }
+
+    // `randomCirculantOrthogonal` makes `s * v * v^T - I`. Diagonal is `s * v[i]^2 - 1`,
+    // so `u = sqrt(s) * v` is recovered from it.
+    if (structure == MatrixStructure::rankOne) {
+      for (size_t i = 0; i < length; ++i) {
+        rankOneVector[i] = std::sqrt(std::max(Sample(0), matrix[i][i] + Sample(1)));
+      }
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+      for (size_t j = 0; j < length; ++j) matrixTransposed[j][i] = matrix[i][j];
+    }
+  }
+
+  /**
+  `y = matrix * x`. Skips the zeros of `matrix` based on `structure`. Dense product is
+  `length^2` multiply-adds, while Hadamard is `length * log2(length)` additions, rank one
+  is `2 * length`, and absorbent is about a quarter.
+
+  Triangular matrices use the dense kernel. Skipping the zero half shortens the inner
+  loops to varying lengths, and that was slower than the full vectorized columns.
+  */
+  void multiply(const std::array<Sample, length> &x, std::array<Sample, length> &y) const
+  {
+    switch (structure) {
+      case MatrixStructure::hadamard: {
+        y = x;
+        for (size_t h = 1; h < length; h *= 2) {
+          for (size_t i = 0; i < length; i += 2 * h) {
+            for (size_t j = i; j < i + h; ++j) {
+              const auto a = y[j];
+              const auto b = y[j + h];
+              y[j] = a + b;
+              y[j + h] = a - b;
+            }
+          }
+        }
+        const auto scale = matrix[0][0];
+        for (auto &value : y) value *= scale;
+      } break;
+
+      case MatrixStructure::rankOne: {
+        Sample dot = 0;
+        for (size_t i = 0; i < length; ++i) dot += rankOneVector[i] * x[i];
+        for (size_t i = 0; i < length; ++i) y[i] = rankOneVector[i] * dot - x[i];
+      } break;
+
+      case MatrixStructure::schroeder: {
+        for (size_t i = 0; i < length - 2; ++i) y[i] = matrix[i][i] * x[i];
+        for (size_t i = length - 2; i < length; ++i) {
+          Sample sum = 0;
+          for (size_t j = 0; j < length; ++j) sum += matrix[i][j] * x[j];
+          y[i] = sum;
+        }
+      } break;
+
+      case MatrixStructure::absorbent: {
+        // Top: `A * (x_bottom - G * x_top)`. Bottom: `(I - G^2) * x_top + G * x_bottom`.
+        constexpr size_t half = length / 2;
+        std::array<Sample, half> t;
+        for (size_t j = 0; j < half; ++j) {
+          t[j] = x[half + j] - matrix[half + j][half + j] * x[j];
+        }
+        std::array<Sample, half> sum{};
+        for (size_t j = 0; j < half; ++j) {
+          const auto &column = matrixTransposed[half + j];
+          const auto tj = t[j];
+          for (size_t i = 0; i < half; ++i) sum[i] += column[i] * tj;
+        }
+        std::copy(sum.begin(), sum.end(), y.begin());
+        for (size_t j = 0; j < half; ++j) {
+          y[half + j]
+            = matrix[half + j][j] * x[j] + matrix[half + j][half + j] * x[half + j];
+        }
+      } break;
+
+      default: {
+        std::array<Sample, length> sum{};
+        for (size_t j = 0; j < length; ++j) {
+          const auto &column = matrixTransposed[j];
+          const auto xj = x[j];
+          for (size_t i = 0; i < length; ++i) sum[i] += column[i] * xj;
+        }
+        y = sum;
+      } break;
+    }
   }
+};
+
+/**
+If `length` is too long, compiler might silently fail to allocate stack.
+*/
+template<typename Sample, size_t length> class FeedbackDelayNetwork {
+private:
+  std::array<std::array<Sample, length>, 2> buf{};
+  ParallelDelay<Sample, length> delay;
+  std::array<DoubleEMAFilterKp<Sample>, length> lowpass;
+  std::array<EMAHighpass<Sample>, length> highpass;
+
+  // Split gain is computed every `splitGainInterval` samples, and linearly interpolated
+  // in between.
+  static constexpr size_t splitGainInterval = 16;
+  std::array<Sample, length> splitGain{};
+  std::array<Sample, length> splitGainDelta{};
+  std::array<Sample, length> splitSin{};
+  std::array<Sample, length> splitCos{};
+  size_t splitGainCounter = 0;
+  bool isSplitGainReset = true;
+  size_t cycle = 100000;
+  size_t counter = 0;
+  size_t bufIndex = 0;
+
+public:
+  Sample rate = Sample(1);
+  std::array<RateLimiter<Sample>, length> delayTimeSample;
+  std::array<Sample, length> lowpassKp{};
+  std::array<Sample, length> highpassKp{};
 
   void setup(Sample sampleRate, Sample maxTime)
   {
-    for (auto &dl : delay) dl.setup(sampleRate, maxTime);
+    delay.setup(sampleRate * maxTime);
+
+    for (size_t idx = 0; idx < length; ++idx) {
+      auto phase = Sample(twopi) * Sample(idx) / Sample(length);
+      splitSin[idx] = std::sin(phase);
+      splitCos[idx] = std::cos(phase);
+    }
 
     lowpassKp.fill(Sample(1));
     highpassKp.fill(Sample(0.0006542843087824565)); // 5Hz cutoff when fs=48000Hz.
@@ -727,39 +823,96 @@ public:
   void reset()
   {
     buf.fill({});
-    for (auto &dl : delay) dl.reset();
+    delay.reset();
     for (auto &lp : lowpass) lp.reset();
     for (auto &hp : highpass) hp.reset();
 
+    splitGainDelta.fill({});
+    splitGainCounter = 0;
+    isSplitGainReset = true;
     counter = 0;
   }
 
   /**
   `offset` is normalized phase in [0, 1].
   `skew` >= 0.
+
+  `sin(2 pi (offset + idx / length))` is expanded with the angle sum identity, so only
+  one pair of `sin` and `cos` is computed for all indices.
   */
-  void fillSplitGain(Sample offset, Sample skew)
+  void fillSplitGain(Sample offset, Sample skew, std::array<Sample, length> &gain)
   {
-    for (size_t idx = 0; idx < splitGain.size(); ++idx) {
-      auto phase = offset + Sample(idx) / Sample(splitGain.size());
-      splitGain[idx] = std::exp(skew * std::sin(Sample(twopi) * phase));
+    const auto sinOffset = std::sin(Sample(twopi) * offset);
+    const auto cosOffset = std::cos(Sample(twopi) * offset);
+    for (size_t idx = 0; idx < length; ++idx) {
+      auto sn = sinOffset * splitCos[idx] + cosOffset * splitSin[idx];
+      gain[idx] = std::exp(skew * sn);
     }
-    auto sum = std::accumulate(splitGain.begin(), splitGain.end(), Sample(0));
-    for (auto &value : splitGain) value /= sum;
+    auto sum = std::accumulate(gain.begin(), gain.end(), Sample(0));
+    for (auto &value : gain) value /= sum;
   }
 
-  Sample preProcess(Sample splitPhaseOffset, Sample splitSkew)
+  /**
+  `matrixFade` in [0, 1] crossfades the output of `previous` to `matrix`. `previous` isn't
+  read when `matrixFade` is 1.
+
+  Gain of the crossfade is limited to 2, which is enough for uncorrelated outputs
+  (`sqrt(2)` at the middle). Outputs of 2 matrices with opposite signs lose some energy.
+  */
+  Sample preProcess(
+    const FeedbackMatrix<Sample, length> &matrix,
+    const FeedbackMatrix<Sample, length> &previous,
+    Sample matrixFade,
+    Sample splitPhaseOffset,
+    Sample splitSkew)
   {
     if (++counter >= cycle) counter = 0;
 
-    fillSplitGain(splitPhaseOffset + Sample(counter) / Sample(cycle), splitSkew);
+    if (isSplitGainReset) {
+      isSplitGainReset = false;
+      fillSplitGain(
+        splitPhaseOffset + Sample(counter) / Sample(cycle), splitSkew, splitGain);
+    }
+    for (size_t idx = 0; idx < length; ++idx) splitGain[idx] += splitGainDelta[idx];
+    if (splitGainCounter == 0) {
+      splitGainCounter = splitGainInterval;
+
+      // Target is the exact value at the next update.
+      std::array<Sample, length> target;
+      auto ahead = (counter + splitGainInterval) % cycle;
+      fillSplitGain(splitPhaseOffset + Sample(ahead) / Sample(cycle), splitSkew, target);
+      for (size_t idx = 0; idx < length; ++idx) {
+        splitGainDelta[idx] = (target[idx] - splitGain[idx]) / Sample(splitGainInterval);
+      }
+    }
+    --splitGainCounter;
 
     bufIndex ^= 1;
     auto &front = buf[bufIndex];
     auto &back = buf[bufIndex ^ 1];
-    front.fill(0);
-    for (size_t i = 0; i < length; ++i) {
-      for (size_t j = 0; j < length; ++j) front[i] += matrix[i][j] * back[j];
+    matrix.multiply(back, front);
+    if (matrixFade < Sample(1)) {
+      // Mix of 2 different orthogonal transforms loses energy. The mix is rescaled to the
+      // interpolated norm, so the decay doesn't change during crossfade.
+      std::array<Sample, length> faded;
+      previous.multiply(back, faded);
+      Sample normPrevious = 0;
+      Sample normCurrent = 0;
+      Sample normMix = 0;
+      for (size_t idx = 0; idx < length; ++idx) {
+        normPrevious += faded[idx] * faded[idx];
+        normCurrent += front[idx] * front[idx];
+        front[idx] = faded[idx] + matrixFade * (front[idx] - faded[idx]);
+        normMix += front[idx] * front[idx];
+      }
+      normPrevious = std::sqrt(normPrevious);
+      normCurrent = std::sqrt(normCurrent);
+      normMix = std::sqrt(normMix);
+      if (normMix > 0) {
+        auto target = normPrevious + matrixFade * (normCurrent - normPrevious);
+        auto gain = std::min(target / normMix, Sample(2));
+        for (auto &value : front) value *= gain;
+      }
     }
     return std::accumulate(front.begin(), front.end(), Sample(0));
   }
@@ -769,11 +922,16 @@ public:
     auto &front = buf[bufIndex];
 
     crossIn /= -Sample(length);
+    std::array<Sample, length> sig;
+    std::array<Sample, length> time;
     for (size_t idx = 0; idx < length; ++idx) {
       auto crossed = front[idx] + stereoCross * (crossIn - front[idx]);
-      auto sig = splitGain[idx] * input + feedback * crossed;
-      auto delayed = delay[idx].process(sig, delayTimeSample[idx].process(rate));
-      auto lowpassed = lowpass[idx].process(delayed, lowpassKp[idx]);
+      sig[idx] = splitGain[idx] * input + feedback * crossed;
+      time[idx] = delayTimeSample[idx].process(rate);
+    }
+    auto delayed = delay.process(sig, time);
+    for (size_t idx = 0; idx < length; ++idx) {
+      auto lowpassed = lowpass[idx].process(delayed[idx], lowpassKp[idx]);
       front[idx] = highpass[idx].process(lowpassed, highpassKp[idx]);
     }
 
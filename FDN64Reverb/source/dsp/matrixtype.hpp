@@ -26,6 +26,27 @@ enum FeedbackMatrixType : unsigned {
   conference,
   FeedbackMatrixType_ENUM_LENGTH,
 };
+
+/**
+Returns true when `type` makes orthogonal matrices. Other types may amplify the signal in
+a round trip of the loop.
+*/
+inline bool isOrthogonal(unsigned type)
+{
+  switch (type) {
+    case upperTriangularPositive:
+    case upperTriangularNegative:
+    case lowerTriangularPositive:
+    case lowerTriangularNegative:
+    case schroederPositive:
+    case schroederNegative:
+    case absorbentPositive:
+    case absorbentNegative:
+      return false;
+  }
+  return true;
+}
+
 } // namespace FeedbackMatrixType
 
 } // namespace SomeDSP
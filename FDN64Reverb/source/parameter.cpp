@@ -18,6 +18,7 @@ SemitoneScale<double> Scales::lowpassCutoffHz(33.0, 136.0, false);
 SemitoneScale<double> Scales::highpassCutoffHz(-37.0, 57.0, true);
 UIntScale<double>
   Scales::matrixType(FeedbackMatrixType::FeedbackMatrixType_ENUM_LENGTH - 1);
+UIntScale<double> Scales::fdnSize(5);
 DecibelScale<double> Scales::gateThreshold(-140.0, 0.0, true);
 DecibelScale<double> Scales::dry(-60.0, 24.0, true);
 DecibelScale<double> Scales::wet(-60.0, 60.0, true);
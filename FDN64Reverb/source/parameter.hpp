@@ -47,6 +47,8 @@ enum ID {
 
   refreshMatrix,
 
+  fdnSize,
+
   ID_ENUM_LENGTH,
   ID_ENUM_GUI_START = ID_ENUM_LENGTH,
 };
@@ -59,6 +61,7 @@ struct Scales {
   static SomeDSP::SemitoneScale<double> lowpassCutoffHz;
   static SomeDSP::SemitoneScale<double> highpassCutoffHz;
   static SomeDSP::UIntScale<double> matrixType;
+  static SomeDSP::UIntScale<double> fdnSize;
   static SomeDSP::DecibelScale<double> gateThreshold;
   static SomeDSP::DecibelScale<double> dry;
   static SomeDSP::DecibelScale<double> wet;
@@ -75,6 +78,7 @@ struct GlobalParameter : public ParameterInterface {
   GlobalParameter()
   {
     value.resize(ParameterID::ID_ENUM_LENGTH);
+    changed.resize(ParameterID::ID_ENUM_LENGTH);
 
     using Info = Vst::ParameterInfo;
     using ID = ParameterID::ID;
@@ -140,6 +144,9 @@ struct GlobalParameter : public ParameterInterface {
     value[ID::refreshMatrix] = std::make_unique<UIntValue>(
       0, Scales::boolScale, "refreshMatrix", Info::kCanAutomate);
 
+    value[ID::fdnSize]
+      = std::make_unique<UIntValue>(3, Scales::fdnSize, "fdnSize", Info::kCanAutomate);
+
     for (size_t id = 0; id < value.size(); ++id) value[id]->setId(Vst::ParamID(id));
   }
 
@@ -151,9 +158,15 @@ struct GlobalParameter : public ParameterInterface {
   tresult setState(IBStream *stream)
   {
     IBStreamer streamer(stream, kLittleEndian);
-    for (auto &val : value)
-      if (val->setState(streamer)) return kResultFalse;
-    return kResultOk;
+    tresult result = kResultOk;
+    for (auto &val : value) {
+      if (val->setState(streamer)) {
+        result = kResultFalse;
+        break;
+      }
+    }
+    changed.postMarkAll();
+    return result;
   }
 
   tresult getState(IBStream *stream)
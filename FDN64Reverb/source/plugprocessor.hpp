@@ -10,6 +10,9 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+#include "../../common/silencedetector.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -29,6 +32,7 @@ public:
 
   tresult PLUGIN_API setupProcessing(Vst::ProcessSetup &setup) SMTG_OVERRIDE;
   tresult PLUGIN_API setActive(TBool state) SMTG_OVERRIDE;
+  uint32 PLUGIN_API getTailSamples() SMTG_OVERRIDE;
   tresult PLUGIN_API process(Vst::ProcessData &data) SMTG_OVERRIDE;
 
   tresult PLUGIN_API setState(IBStream *state) SMTG_OVERRIDE;
@@ -42,7 +46,7 @@ public:
   void processBypass(Vst::ProcessData &data);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
@@ -51,6 +55,8 @@ protected:
 
   uint64_t lastState = 0;
   uint32_t wasBypassing = 0;
+  ProcessDriver processDriver;
+  SilenceDetector silenceDetector;
   DSPCore dsp;
 };
 
@@ -92,6 +92,11 @@ public:
   std::array<Sample, matrixSize> delayOut{};
   std::array<std::array<Sample, matrixSize>, matrixSize> matrix;
 
+  explicit FeedbackDelayNetwork(const SmootherContext<Sample> &context)
+    : delayTime(makeSmootherArray<LinearSmoother<Sample>, matrixSize>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime = 0.5)
   {
     this->sampleRate = sampleRate;
@@ -141,6 +146,8 @@ public:
   LinearSmoother<Sample> delayTime;
   Sample maxTime = 0;
 
+  explicit LongAllpass(const SmootherContext<Sample> &context) : delayTime(context) {}
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     delay.setup(sampleRate, maxTime, maxTime);
@@ -175,6 +182,11 @@ template<typename Sample, size_t nAllpass> class SerialAllpass {
 public:
   std::array<LongAllpass<Sample>, nAllpass> allpass;
 
+  explicit SerialAllpass(const SmootherContext<Sample> &context)
+    : allpass(makeSmootherArray<LongAllpass<Sample>, nAllpass>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
@@ -18,16 +18,16 @@ inline float midiNoteToFrequency(float pitch, float tuning)
 
 float paramToPitch(float bend) { return powf(2.0f, ((bend - 0.5f) * 400.0f) / 1200.0f); }
 
-DSPCore::DSPCore() { midiNotes.reserve(128); }
+DSPCore::DSPCore() {}
 
 void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.01f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.01f);
 
   noteStack.reserve(128);
   noteStack.resize(0);
@@ -118,7 +118,7 @@ void DSPCore::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   if (!noteStack.empty()) {
     velocity = noteStack.back().velocity;
@@ -159,7 +159,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   for (auto &fdn : fdnCascade)
     for (auto &time : fdn.delayTime) time.refresh();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
@@ -55,7 +56,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -72,26 +73,23 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   float velocity = 0;
   std::vector<NoteInfo> noteStack; // Top of this stack is current note.
@@ -106,14 +104,16 @@ private:
   VelvetNoise<float> velvet;
 
   float fdnSig = 0.0f;
-  std::array<FeedbackDelayNetwork<float, fdnMatrixSize>, 8> fdnCascade;
+  std::array<FeedbackDelayNetwork<float, fdnMatrixSize>, 8> fdnCascade
+    = makeSmootherArray<FeedbackDelayNetwork<float, fdnMatrixSize>, 8>(smootherContext);
 
   float serialAP1Sig = 0.0f;
-  SerialAllpass<float, nAP1> serialAP1;
+  SerialAllpass<float, nAP1> serialAP1{smootherContext};
   BiquadHighPass<double> serialAP1Highpass;
 
   float serialAP2Sig = 0.0f;
-  std::array<SerialAllpass<float, nAP2>, 4> serialAP2;
+  std::array<SerialAllpass<float, nAP2>, 4> serialAP2
+    = makeSmootherArray<SerialAllpass<float, nAP2>, 4>(smootherContext);
   BiquadHighPass<double> serialAP2Highpass;
 
   Delay<float> tremoloDelay;
@@ -122,18 +122,18 @@ private:
   float randomTremoloFrequency = 0.0f;
   float randomTremoloDelayTime = 0.0f;
 
-  LinearSmoother<float> interpPitch;
-  LinearSmoother<float> interpStickToneMix;
-  LinearSmoother<float> interpStickPulseMix;
-  LinearSmoother<float> interpStickVelvetMix;
-  LinearSmoother<float> interpFDNFeedback;
-  LinearSmoother<float> interpFDNCascadeMix;
-  LinearSmoother<float> interpAllpassMix;
-  LinearSmoother<float> interpAllpass1Feedback;
-  LinearSmoother<float> interpAllpass2Feedback;
-  LinearSmoother<float> interpTremoloMix;
-  LinearSmoother<float> interpTremoloDepth;
-  LinearSmoother<float> interpTremoloFrequency;
-  LinearSmoother<float> interpTremoloDelayTime;
-  LinearSmoother<float> interpMasterGain;
+  LinearSmoother<float> interpPitch{smootherContext};
+  LinearSmoother<float> interpStickToneMix{smootherContext};
+  LinearSmoother<float> interpStickPulseMix{smootherContext};
+  LinearSmoother<float> interpStickVelvetMix{smootherContext};
+  LinearSmoother<float> interpFDNFeedback{smootherContext};
+  LinearSmoother<float> interpFDNCascadeMix{smootherContext};
+  LinearSmoother<float> interpAllpassMix{smootherContext};
+  LinearSmoother<float> interpAllpass1Feedback{smootherContext};
+  LinearSmoother<float> interpAllpass2Feedback{smootherContext};
+  LinearSmoother<float> interpTremoloMix{smootherContext};
+  LinearSmoother<float> interpTremoloDepth{smootherContext};
+  LinearSmoother<float> interpTremoloFrequency{smootherContext};
+  LinearSmoother<float> interpTremoloDelayTime{smootherContext};
+  LinearSmoother<float> interpMasterGain{smootherContext};
 };
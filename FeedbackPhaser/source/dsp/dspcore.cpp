@@ -39,7 +39,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   pitchSmoothingKp                                                                       \
     = EMAFilter<double>::secondToP(upRate, pv[ID::notePitchSlideSecond]->getDouble());   \
@@ -75,7 +75,7 @@ void DSPCore::updateUpRate()
 {
   upRate = double(sampleRate) * fold[oversampling];
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 }
 
 void DSPCore::reset()
@@ -232,7 +232,7 @@ void DSPCore::process(
   const float *side0 = enableSidechain ? in2 : in0;
   const float *side1 = enableSidechain ? in3 : in1;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   if (transitionCounter == 0) {
     currentAllpassStage = pv[ID::stage]->getInt();
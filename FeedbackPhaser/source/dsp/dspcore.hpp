@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -22,11 +23,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   bool isPlaying = false;
@@ -67,21 +64,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -94,10 +87,11 @@ private:
   static constexpr size_t upFold = 8;
   static constexpr std::array<size_t, 3> fold{1, 2, upFold};
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100;
 
   double pitchSmoothingKp = 1;
@@ -105,18 +99,18 @@ private:
   ExpSmootherLocal<double> notePitchToAllpassCutoff;
   DoubleEMAFilter<double> notePitchToAllpassCutoffRelease;
 
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> feedbackMix;
-  ExpSmoother<double> inputMixSign;
-  ExpSmoother<double> feedback;
-  ExpSmoother<double> feedbackClip;
-  ExpSmoother<double> feedbackHighpassG;
-  ExpSmoother<double> outputHighpassG;
-  ExpSmoother<double> modAmount;
-  ExpSmoother<double> modAsymmetry;
-  ExpSmoother<double> modLowpassKp;
-  ExpSmoother<double> allpassSpread;
-  ExpSmoother<double> allpassCenterCut;
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> feedbackMix{smootherContext};
+  ExpSmoother<double> inputMixSign{smootherContext};
+  ExpSmoother<double> feedback{smootherContext};
+  ExpSmoother<double> feedbackClip{smootherContext};
+  ExpSmoother<double> feedbackHighpassG{smootherContext};
+  ExpSmoother<double> outputHighpassG{smootherContext};
+  ExpSmoother<double> modAmount{smootherContext};
+  ExpSmoother<double> modAsymmetry{smootherContext};
+  ExpSmoother<double> modLowpassKp{smootherContext};
+  ExpSmoother<double> allpassSpread{smootherContext};
+  ExpSmoother<double> allpassCenterCut{smootherContext};
 
   size_t oversampling = 1;
   size_t modType = 0;
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -42,13 +44,14 @@ public:
   void processBypass(Vst::ProcessData &data);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
     return int32(std::min<double>(stepCount, normalized * (stepCount + 1.0)));
   }
 
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
@@ -17,5 +17,5 @@
 int main()
 {
   FxTester<DSPCore> tester(UHHYOU_PLUGIN_NAME, OUT_DIR_PATH);
-  return tester.isFinished ? EXIT_SUCCESS : EXIT_FAILURE;
+  return tester.isPassed() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -19,8 +19,13 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
+
+  for (auto &os : offlineOversampler) {
+    os.setup(1);
+    os.set(offlineFold, OversamplingQuality::fir);
+  }
 
   startup();
 }
@@ -29,7 +34,7 @@ void DSPCore::setup(double sampleRate)
   using ID = ParameterID::ID;                                                            \
   auto &pv = param.value;                                                                \
                                                                                          \
-  SmootherCommon<float>::setTime(pv[ID::smoothness]->getFloat());                        \
+  smootherContext.setTime(pv[ID::smoothness]->getFloat());                               \
                                                                                          \
   interpInputGain.METHOD(pv[ID::inputGain]->getFloat());                                 \
   interpOutputGain.METHOD(pv[ID::outputGain]->getFloat());                               \
@@ -43,6 +48,7 @@ void DSPCore::reset()
   ASSIGN_PARAMETER(reset);
 
   for (auto &shpr : shaper) shpr.reset();
+  for (auto &os : offlineOversampler) os.reset();
   for (auto &lm : limiter) lm.reset();
   startup();
 }
@@ -52,7 +58,10 @@ void DSPCore::startup() {}
 size_t DSPCore::getLatency()
 {
   auto &&latency = activateLimiter ? limiter[0].latency() : 0;
-  latency += oversample ? shaper[0].latency() : 0;
+  if (oversample) {
+    latency += isOffline ? size_t(std::lround(offlineOversampler[0].latency()))
+                         : shaper[0].latency();
+  }
   return latency;
 }
 
@@ -73,7 +82,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   param.value[ParameterID::guiInputGain]->setFromFloat(
     std::max(maxAbs(length, in0), maxAbs(length, in1)));
@@ -90,7 +99,14 @@ void DSPCore::process(
     shaper[0].multiply = mul;
     shaper[1].multiply = mul;
 
-    if (oversample) {
+    if (oversample && isOffline) {
+      frame[0] = outGain
+        * offlineOversampler[0].process(
+          frame[0], [&](float x) { return shaper[0].process(x); });
+      frame[1] = outGain
+        * offlineOversampler[1].process(
+          frame[1], [&](float x) { return shaper[1].process(x); });
+    } else if (oversample) {
       frame[0] = outGain * shaper[0].process16(frame[0]);
       frame[1] = outGain * shaper[1].process16(frame[1]);
     } else {
@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/lightlimiter.hpp"
+#include "../../../common/dsp/multirate/oversampler.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 
@@ -18,6 +19,7 @@ using namespace Steinberg::Synth;
 class DSPCore {
 public:
   GlobalParameter param;
+  bool isOffline = false; // Set before `setup`. Uses `offlineOversampler` if true.
 
   void setup(double sampleRate);
   void reset();
@@ -29,14 +31,18 @@ public:
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float maxGain = 0.0f;
 
+  static constexpr size_t offlineFold = 64;
+
   std::array<FoldShaper<float>, 2> shaper;
+  std::array<Oversampler<float>, 2> offlineOversampler;
   std::array<LightLimiter<float, 64>, 2> limiter;
 
   bool oversample = true;
   bool activateLimiter = true;
-  ExpSmoother<float> interpInputGain;
-  ExpSmoother<float> interpOutputGain;
-  ExpSmoother<float> interpMul;
+  ExpSmoother<float> interpInputGain{smootherContext};
+  ExpSmoother<float> interpOutputGain{smootherContext};
+  ExpSmoother<float> interpMul{smootherContext};
 };
@@ -75,6 +75,7 @@ void Editor::valueChanged(CControl *pControl)
   ParamID tag = pControl->getTag();
 
   switch (tag) {
+    case Synth::ParameterID::ID::oversample:
     case Synth::ParameterID::ID::limiter:
     case Synth::ParameterID::ID::limiterAttack:
       controller->getComponentHandler()->restartComponent(kLatencyChanged);
@@ -121,7 +121,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = sampleRate;
   upRate = sampleRate * upFold;
 
-  SmootherCommon<double>::setTime(double(0.2));
+  smootherContext.setTime(double(0.2));
 
   triggerDetector.setup(upRate * double(0.125));
 
@@ -241,7 +241,7 @@ void DSPCore::setup(double sampleRate)
 void DSPCore::updateUpRate()
 {
   upRate = sampleRate * fold[overSampling];
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
   for (auto &x : membrane1) x.onSampleRateChange(upRate);
   for (auto &x : membrane2) x.onSampleRateChange(upRate);
 }
@@ -482,8 +482,8 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   bool isStereo = pv[ID::stereoUnison]->getInt();
   bool isSafetyHighpassEnabled = pv[ID::safetyHighpassEnable]->getInt();
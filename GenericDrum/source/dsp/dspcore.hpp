@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -25,11 +26,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   bool isPlaying = false;
@@ -61,21 +58,17 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -94,7 +87,7 @@ private:
     double timeModAmt);
   inline void processExternalInput(double absed);
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double maxExtInAmplitude = 0;
@@ -109,24 +102,25 @@ private:
   static constexpr std::array<size_t, 2> fold{1, upFold};
   size_t overSampling = 2;
   double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100.0;
 
   double noteNumber = 69.0;
   double pitchSmoothingKp = 1.0;
   ExpSmootherLocal<double> interpPitch;
 
-  ExpSmoother<double> externalInputGain;
-  ExpSmoother<double> wireDistance;
-  ExpSmoother<double> wireCollisionTypeMix;
-  ExpSmoother<double> impactWireMix;
-  ExpSmoother<double> secondaryDistance;
-  ExpSmoother<double> crossFeedbackGain;
-  ExpSmoother<double> delayTimeModAmount;
-  ExpSmoother<double> secondaryFdnMix;
-  ExpSmoother<double> membraneWireMix;
-  ExpSmoother<double> stereoBalance;
-  ExpSmoother<double> stereoMerge;
-  ExpSmoother<double> outputGain;
+  ExpSmoother<double> externalInputGain{smootherContext};
+  ExpSmoother<double> wireDistance{smootherContext};
+  ExpSmoother<double> wireCollisionTypeMix{smootherContext};
+  ExpSmoother<double> impactWireMix{smootherContext};
+  ExpSmoother<double> secondaryDistance{smootherContext};
+  ExpSmoother<double> crossFeedbackGain{smootherContext};
+  ExpSmoother<double> delayTimeModAmount{smootherContext};
+  ExpSmoother<double> secondaryFdnMix{smootherContext};
+  ExpSmoother<double> membraneWireMix{smootherContext};
+  ExpSmoother<double> stereoBalance{smootherContext};
+  ExpSmoother<double> stereoMerge{smootherContext};
+  ExpSmoother<double> outputGain{smootherContext};
 
   static constexpr size_t nDrum = 2;
   static constexpr size_t nAllpass = 4;
@@ -154,7 +148,7 @@ private:
 
   DoubleEmaADEnvelope<double> envelope;
   TransitionReleaseSmoother<double> releaseSmoother;
-  FeedbackMatrix<double, maxFdnSize> feedbackMatrix;
+  FeedbackMatrix<double, maxFdnSize> feedbackMatrix{smootherContext};
   std::array<double, maxFdnSize> matrixRandomizeAmount{};
   std::array<double, nDrum> membrane1Position{};
   std::array<double, nDrum> membrane1Velocity{};
@@ -162,10 +156,13 @@ private:
   std::array<double, nDrum> membrane2Velocity{};
   std::array<EnergyStoreDecay<double>, 2> membrane1EnergyDecay;
   std::array<EnergyStoreDecay<double>, 2> membrane2EnergyDecay;
-  std::array<EasyFDN<double, maxFdnSize>, 2> membrane1;
-  std::array<EasyFDN<double, maxFdnSize>, 2> membrane2;
+  std::array<EasyFDN<double, maxFdnSize>, 2> membrane1
+    = makeSmootherArray<EasyFDN<double, maxFdnSize>, 2>(smootherContext);
+  std::array<EasyFDN<double, maxFdnSize>, 2> membrane2
+    = makeSmootherArray<EasyFDN<double, maxFdnSize>, 2>(smootherContext);
 
   std::array<std::array<double, 2>, 2> halfbandInput{};
   std::array<HalfBandIIR<double, HalfBandCoefficient<double>>, 2> halfbandIir;
-  std::array<SVFHighpass<double>, 2> safetyHighpass;
+  std::array<SVFHighpass<double>, 2> safetyHighpass
+    = makeSmootherArray<SVFHighpass<double>, 2>(smootherContext);
 };
@@ -57,8 +57,10 @@ template<typename Sample> class ComplexLowpass {
 private:
   Sample x1 = 0;
   std::complex<Sample> y1{};
-  ExpSmoother<std::complex<Sample>> b{};
-  ExpSmoother<std::complex<Sample>> a1{};
+  // Coefficients are not smoothed, that is `kp = 1`, to keep the sound of presets.
+  static constexpr std::complex<Sample> kp{Sample(1), Sample(0)};
+  ExpSmootherLocal<std::complex<Sample>> b{};
+  ExpSmootherLocal<std::complex<Sample>> a1{};
 
   inline Sample setR(Sample cut, Sample lowR, Sample highR, Sample lowCut, Sample highCut)
   {
@@ -90,7 +92,7 @@ public:
 
   Sample process(Sample x0)
   {
-    y1 = b.process() * (x0 + x1) + a1.process() * y1;
+    y1 = b.process(kp) * (x0 + x1) + a1.process(kp) * y1;
     x1 = x0;
     return y1.real();
   }
@@ -168,6 +170,11 @@ private:
   ExpSmoother<Sample> k;
 
 public:
+  explicit SVFHighpass(const SmootherContext<Sample> &context)
+    : g(context), d(context), k(context)
+  {
+  }
+
   void push(Sample freqNormalized, Sample Q)
   {
     g.push(std::tan(
@@ -464,6 +471,11 @@ public:
   std::array<Sample, length> seed{};
   std::array<ParallelExpSmoother<Sample, length>, length> matrix;
 
+  explicit FeedbackMatrix(const SmootherContext<Sample> &context)
+    : matrix(makeSmootherArray<ParallelExpSmoother<Sample, length>, length>(context))
+  {
+  }
+
   // Construct Householder matrix. Call this after updating `seed`.
   //
   // `matrix` is 2D array of a square matrix.
@@ -535,6 +547,11 @@ public:
   ExpSmoother<Sample> bandpassQ;
   ExpSmoother<Sample> crossGain;
 
+  explicit EasyFDN(const SmootherContext<Sample> &context)
+    : bandpassCutoff(context), bandpassQ(context), crossGain(context)
+  {
+  }
+
   void setup(Sample maxTimeSamples) { delay.setup(maxTimeSamples); }
 
   void onSampleRateChange(Sample sampleRate)
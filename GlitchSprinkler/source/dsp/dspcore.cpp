@@ -21,7 +21,7 @@ void DSPCore::setup(double sampleRate_)
 
   sampleRate = sampleRate_;
 
-  SmootherCommon<double>::setTime(double(0.2));
+  smootherContext.setTime(double(0.2));
 
   terminationLength = int_fast32_t(double(0.002) * sampleRate);
   lowpassInterpRate = sampleRate / double(48000 * 64);
@@ -154,8 +154,8 @@ void DSPCore::reset()
   polynomial.updateCoefficients(true);
   isPolynomialUpdated = true;
 
-  modifierNotes.resize(0);
-  midiNotes.resize(0);
+  modifierNotes.clear();
+  midiNotes.clear();
   activeNote.resize(0);
   activeModifier.resize(0);
   noteIndices.resize(0);
@@ -298,7 +298,8 @@ std::array<double, 2> Voice::processFrame()
   return {(double(1) - unisonPan) * sig, unisonPan * sig};
 }
 
-void DSPCore::process(const size_t length, float *out0, float *out1)
+template<typename Sample>
+void DSPCore::process(const size_t length, Sample *out0, Sample *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
@@ -311,7 +312,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 
   isPolynomialUpdated = false;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   std::array<double, 2> frame{};
   for (size_t i = 0; i < length; ++i) {
@@ -336,11 +337,14 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
     frame[1] = std::lerp(frame[1], safetyFilter[1].process(frame[1]), safetyFiltMix);
 
     const auto outGain = outputGain.process();
-    out0[i] = float(outGain * frame[0]);
-    out1[i] = float(outGain * frame[1]);
+    out0[i] = Sample(outGain * frame[0]);
+    out1[i] = Sample(outGain * frame[1]);
   }
 }
 
+template void DSPCore::process<float>(const size_t, float *, float *);
+template void DSPCore::process<double>(const size_t, double *, double *);
+
 void DSPCore::noteOn(NoteInfo &info)
 {
   using ID = ParameterID::ID;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -94,6 +95,7 @@ public:
   GlobalParameter param;
 
   double sampleRate = 48000.0;
+  SmootherContext<double> smootherContext;
 
   bool isPlaying = false;
   double tempo = 120.0;
@@ -123,8 +125,8 @@ public:
   int_fast32_t pwmChangeCycle = 1;
   int_fast32_t pwmAmount = 1;
   DecibelScale<double> velocityMap{-60, 0, true};
-  ExpSmoother<double> safetyFilterMix;
-  ExpSmoother<double> outputGain;
+  ExpSmoother<double> safetyFilterMix{smootherContext};
+  ExpSmoother<double> outputGain{smootherContext};
 
   bool isPolynomialUpdated = false;
   PolySolver polynomial;
@@ -132,8 +134,8 @@ public:
   // Maybe make it possible to change the pitch modifier channel.
   static constexpr size_t pitchModifierChannel = 15;
 
-  std::vector<NoteInfo> modifierNotes;
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo, 2048> modifierNotes;
+  FrameEventQueue<NoteInfo, 2048> midiNotes;
   std::vector<NoteInfo> activeNote;
   std::vector<NoteInfo> activeModifier;
   std::vector<size_t> noteIndices;
@@ -145,8 +147,6 @@ public:
 
   DSPCore()
   {
-    modifierNotes.reserve(2048);
-    midiNotes.reserve(2048);
     activeNote.reserve(2048);
     activeModifier.reserve(2048);
 
@@ -161,7 +161,7 @@ public:
   void reset();
   void startup();
   void setParameters();
-  void process(const size_t length, float *out0, float *out1);
+  template<typename Sample> void process(const size_t length, Sample *out0, Sample *out1);
   void noteOn(NoteInfo &info);
   void noteOff(int_fast32_t noteId);
   void modNoteOn(NoteInfo &info);
@@ -186,26 +186,22 @@ public:
     note.velocity = velocity;
 
     if (note.channel == pitchModifierChannel) {
-      modifierNotes.push_back(note);
+      modifierNotes.push(note);
     } else {
-      midiNotes.push_back(note);
+      midiNotes.push(note);
     }
   }
 
-#define DEFINE_NOTE_PROC_FUNC(FUNC_NAME, VECTOR, ON_FUNC, OFF_FUNC)                      \
+#define DEFINE_NOTE_PROC_FUNC(FUNC_NAME, QUEUE, ON_FUNC, OFF_FUNC)                       \
   void FUNC_NAME(size_t frame)                                                           \
   {                                                                                      \
-    while (true) {                                                                       \
-      auto it = std::find_if(VECTOR.begin(), VECTOR.end(), [&](const NoteInfo &nt) {     \
-        return nt.frame == frame;                                                        \
-      });                                                                                \
-      if (it == std::end(VECTOR)) return;                                                \
-      if (it->isNoteOn) {                                                                \
-        ON_FUNC(*it);                                                                    \
+    NoteInfo note;                                                                       \
+    while (QUEUE.pop(frame, note)) {                                                     \
+      if (note.isNoteOn) {                                                               \
+        ON_FUNC(note);                                                                   \
       } else {                                                                           \
-        OFF_FUNC(it->id);                                                                \
+        OFF_FUNC(note.id);                                                               \
       }                                                                                  \
-      VECTOR.erase(it);                                                                  \
     }                                                                                    \
   }
 
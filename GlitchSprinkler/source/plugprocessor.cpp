@@ -57,6 +57,13 @@ uint32 PLUGIN_API PlugProcessor::getProcessContextRequirements()
     & Rq::kNeedTimeSignature;
 }
 
+tresult PLUGIN_API PlugProcessor::canProcessSampleSize(int32 symbolicSampleSize)
+{
+  if (symbolicSampleSize == Vst::kSample32 || symbolicSampleSize == Vst::kSample64)
+    return kResultTrue;
+  return kResultFalse;
+}
+
 tresult PLUGIN_API PlugProcessor::setupProcessing(Vst::ProcessSetup &setup)
 {
   dsp.setup(processSetup.sampleRate);
@@ -74,24 +81,26 @@ tresult PLUGIN_API PlugProcessor::setActive(TBool state)
   return AudioEffect::setActive(state);
 }
 
+template<typename Sample> void PlugProcessor::processAudio(Vst::ProcessData &data)
+{
+  Sample *out0 = getChannelBuffers<Sample>(data.outputs[0])[0];
+  Sample *out1 = getChannelBuffers<Sample>(data.outputs[0])[1];
+  const auto beatsPerSample = dsp.tempo / (double(60) * processSetup.sampleRate);
+  const auto beatsAtBlockStart = dsp.beatsElapsed;
+  processDriver.process(
+    data.numSamples, dsp.param, [&]() { dsp.setParameters(); },
+    [&](Vst::Event &event) { handleEvent(event); },
+    [&](int32 offset, int32 length) {
+      dsp.beatsElapsed = beatsAtBlockStart + offset * beatsPerSample;
+      dsp.process(size_t(length), out0 + offset, out1 + offset);
+    });
+}
+
 tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
 {
   using ID = ParameterID::ID;
 
-  // Read inputs parameter changes.
-  if (data.inputParameterChanges) {
-    int32 parameterCount = data.inputParameterChanges->getParameterCount();
-    for (int32 index = 0; index < parameterCount; index++) {
-      auto queue = data.inputParameterChanges->getParameterData(index);
-      if (!queue) continue;
-      Vst::ParamValue value;
-      int32 sampleOffset;
-      if (queue->getPoint(queue->getPointCount() - 1, sampleOffset, value) != kResultTrue)
-        continue;
-      size_t id = queue->getParameterId();
-      if (id < dsp.param.value.size()) dsp.param.value[id]->setFromNormalized(value);
-    }
-  }
+  processDriver.prepare(data, dsp.param);
 
   if (data.processContext != nullptr) {
     uint64_t state = data.processContext->state;
@@ -116,13 +125,12 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   if (data.numOutputs == 0) return kResultOk;
   if (data.numSamples <= 0) return kResultOk;
   if (data.outputs[0].numChannels < 2) return kResultOk;
-  if (data.symbolicSampleSize == Vst::kSample64) return kResultOk;
-
-  if (data.inputEvents != nullptr) handleEvent(data);
 
-  float *out0 = data.outputs[0].channelBuffers32[0];
-  float *out1 = data.outputs[0].channelBuffers32[1];
-  dsp.process((size_t)data.numSamples, out0, out1);
+  if (data.symbolicSampleSize == Vst::kSample64) {
+    processAudio<Vst::Sample64>(data);
+  } else {
+    processAudio<Vst::Sample32>(data);
+  }
 
   // // Send parameter changes for GUI.
   // if (!data.outputParameterChanges) return kResultOk;
@@ -136,29 +144,25 @@ tresult PLUGIN_API PlugProcessor::process(Vst::ProcessData &data)
   return kResultOk;
 }
 
-void PlugProcessor::handleEvent(Vst::ProcessData &data)
+void PlugProcessor::handleEvent(Vst::Event &event)
 {
-  for (int32 index = 0; index < data.inputEvents->getEventCount(); ++index) {
-    Vst::Event event;
-    if (data.inputEvents->getEvent(index, event) != kResultOk) continue;
-    switch (event.type) {
-      case Vst::Event::kNoteOnEvent: {
-        dsp.pushMidiNote(
-          true, event.sampleOffset,
-          event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId,
-          event.noteOn.channel, event.noteOn.pitch, event.noteOn.tuning,
-          event.noteOn.velocity);
-      } break;
-
-      case Vst::Event::kNoteOffEvent: {
-        dsp.pushMidiNote(
-          false, event.sampleOffset,
-          event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId,
-          event.noteOn.channel, 0, 0, 0);
-      } break;
-
-        // Add other event type here.
-    }
+  switch (event.type) {
+    case Vst::Event::kNoteOnEvent: {
+      dsp.pushMidiNote(
+        true, event.sampleOffset,
+        event.noteOn.noteId == -1 ? event.noteOn.pitch : event.noteOn.noteId,
+        event.noteOn.channel, event.noteOn.pitch, event.noteOn.tuning,
+        event.noteOn.velocity);
+    } break;
+
+    case Vst::Event::kNoteOffEvent: {
+      dsp.pushMidiNote(
+        false, event.sampleOffset,
+        event.noteOff.noteId == -1 ? event.noteOff.pitch : event.noteOff.noteId,
+        event.noteOn.channel, 0, 0, 0);
+    } break;
+
+      // Add other event type here.
   }
 }
 
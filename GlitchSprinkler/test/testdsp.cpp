@@ -5,6 +5,7 @@
 // #define HAS_INPUT
 #define NO_DSP_INTERFACE
 
+#include "../../test/sampleprecision.hpp"
 #include "../../test/synthtester.hpp"
 #include "../source/dsp/dspcore.hpp"
 
@@ -18,5 +19,14 @@
 int main()
 {
   SynthTester<DSPCore> tester(UHHYOU_PLUGIN_NAME, OUT_DIR_PATH, 1);
-  return tester.isFinished ? EXIT_SUCCESS : EXIT_FAILURE;
+  if (!tester.isPassed()) return EXIT_FAILURE;
+
+  auto isSampleSizeMatched = testSampleSize<DSPCore>(
+    UHHYOU_PLUGIN_NAME, [](auto &dsp, size_t frame, size_t length, auto &, auto &out) {
+      if (frame == 0) dsp.pushMidiNote(true, 0, 0, 0, 60, 0.0f, 1.0f);
+      if (frame == 32768) dsp.pushMidiNote(false, 0, 0, 0, 0, 0.0f, 0.0f);
+      dsp.setParameters();
+      dsp.process(length, out[0].data() + frame, out[1].data() + frame);
+    });
+  return isSampleSizeMatched ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -25,11 +26,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   bool isPlaying = false;
@@ -60,28 +57,24 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
   static constexpr size_t upFold = 2;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   DecibelScale<double> velocityMap{-60, 0, true};
@@ -92,6 +85,7 @@ private:
   std::minstd_rand formantRng{0};
 
   double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100.0;
 
   double noteNumber = 69.0;
@@ -99,30 +93,30 @@ private:
   ExpSmootherLocal<double> interpPitch;
   ExpSmootherLocal<double> noteFrequency;
 
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> envelopeAM;
-  ExpSmoother<double> pulseGain;
-  ExpSmoother<double> pulsePitchOctave;
-  ExpSmoother<double> pulseBendOctave;
-  ExpSmoother<double> pulsePitchModMix;
-  ExpSmoother<double> pulseFormantOctave;
-  ExpSmoother<double> breathGain;
-  ExpSmoother<double> breathFormantOctave;
-  ExpSmoother<double> combFollowNote;
-  ExpSmoother<double> combFeedbackFollowEnvelope;
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> envelopeAM{smootherContext};
+  ExpSmoother<double> pulseGain{smootherContext};
+  ExpSmoother<double> pulsePitchOctave{smootherContext};
+  ExpSmoother<double> pulseBendOctave{smootherContext};
+  ExpSmoother<double> pulsePitchModMix{smootherContext};
+  ExpSmoother<double> pulseFormantOctave{smootherContext};
+  ExpSmoother<double> breathGain{smootherContext};
+  ExpSmoother<double> breathFormantOctave{smootherContext};
+  ExpSmoother<double> combFollowNote{smootherContext};
+  ExpSmoother<double> combFeedbackFollowEnvelope{smootherContext};
 
   DoubleEmaADEnvelope<double> mainEnvelope;
   TransitionReleaseSmoother<double> releaseSmoother;
   AccumulateAM<double> accumulateAM;
   BlitOscillator<double> blitOsc;
   MaybeFormant<double, decltype(formantRng)> blitFormant;
-  EnvelopedNoise<double> breathNoise;
-  NoiseFormant<double, decltype(formantRng)> breathFormant;
+  EnvelopedNoise<double> breathNoise{smootherContext};
+  NoiseFormant<double, decltype(formantRng)> breathFormant{smootherContext};
   ModCombScaler<double, decltype(rng), nModDelay> modCombScaler;
-  ParallelModComb<double, decltype(formantRng), nModDelay> modComb;
+  ParallelModComb<double, decltype(formantRng), nModDelay> modComb{smootherContext};
   NoteGate<double> noteGate;
   HalfBandIIR<double, HalfBandCoefficient<double>> halfbandIir;
-  SVFHighpass<double> safetyHighpass;
+  SVFHighpass<double> safetyHighpass{smootherContext};
 
   double calcNotePitch(double note);
   double processSample();
@@ -33,6 +33,8 @@ private:
   Sample y1 = 0;
 
 public:
+  explicit LP1(const SmootherContext<Sample> &context) : bn(context), a1(context) {}
+
 #define ASSIGN_COEFFICINETS(METHOD)                                                      \
   auto cutoff = std::clamp(cutoffNormalized, minCutoff, nyquist);                        \
   auto k = Sample(1) / std::tan(std::numbers::pi_v<Sample> * cutoff);                    \
@@ -172,6 +174,11 @@ private:
   ExpSmoother<Sample> k;
 
 public:
+  explicit SVFHighpass(const SmootherContext<Sample> &context)
+    : g(context), d(context), k(context)
+  {
+  }
+
 #define ASSIGN_COEFFICINETS(METHOD, EXTRA)                                               \
   void METHOD(Sample freqNormalized, Sample Q)                                           \
   {                                                                                      \
@@ -385,6 +392,11 @@ public:
   std::array<ExpSmoother<Sample>, nBandpass> bandGain;
   SVF<Sample, SVFTool::lowpass> lowpass;
 
+  explicit NoiseFormant(const SmootherContext<Sample> &context)
+    : bandGain(makeSmootherArray<ExpSmoother<Sample>, nBandpass>(context))
+  {
+  }
+
   void reset()
   {
     for (size_t idx = 0; idx < bandGain.size(); ++idx) {
@@ -422,6 +434,10 @@ public:
   std::array<Sample, nTap> output{};
   ParallelExpSmoother<Sample, nTap> timeInSamples;
 
+  explicit MultiTapDelay(const SmootherContext<Sample> &context) : timeInSamples(context)
+  {
+  }
+
   inline size_t size() { return nTap; }
   inline Sample sum() { return std::accumulate(output.begin(), output.end(), Sample(0)); }
 
@@ -469,6 +485,10 @@ private:
   std::array<Sample, length> y1{};
 
 public:
+  explicit ParallelLP1(const SmootherContext<Sample> &context) : bn(context), a1(context)
+  {
+  }
+
   void resetDSP()
   {
     x1.fill({});
@@ -515,6 +535,10 @@ private:
   std::array<Sample, length> y1{};
 
 public:
+  explicit ParallelHP1(const SmootherContext<Sample> &context) : b0(context), a1(context)
+  {
+  }
+
   void resetDSP()
   {
     x1.fill({});
@@ -734,6 +758,22 @@ private:
   }
 
 public:
+  explicit ParallelModComb(const SmootherContext<Sample> &context)
+    : lossThreshold(context)
+    , timeMod(context)
+    , timeRate(context)
+    , allpassCut(
+        makeSmootherArray<ParallelExpSmoother<Sample, length>, nAllpass>(context))
+    , allpassQ(context)
+    , allpassMod(context)
+    , timeSamples(context)
+    , feedbackGain(context)
+    , spreadDelay(context)
+    , lowpass(context)
+    , highpass(context)
+  {
+  }
+
 #define ASSIGN_MOD_COMB_PARAMETERS(METHOD, EXTRA_CODE)                                   \
   void METHOD(                                                                           \
     const ModCombScaler<Sample, RandomNumberGenerator, length> &scaler,                  \
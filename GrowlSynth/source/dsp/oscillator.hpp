@@ -43,6 +43,11 @@ private:
   std::minstd_rand rng{0};
 
 public:
+  explicit EnvelopedNoise(const SmootherContext<Sample> &context)
+    : decay(context), lowpass(context)
+  {
+  }
+
   void reset(Sample decaySamples, Sample lowpassCutoff)
   {
     gain = Sample(1);
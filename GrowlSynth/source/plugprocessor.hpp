@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -40,7 +42,7 @@ public:
   }
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
@@ -48,6 +50,7 @@ protected:
   }
 
   uint64_t lastState = 0;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
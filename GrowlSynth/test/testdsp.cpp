@@ -16,5 +16,5 @@
 int main()
 {
   SynthTester<DSPCore> tester(UHHYOU_PLUGIN_NAME, OUT_DIR_PATH, 1);
-  return tester.isFinished ? EXIT_SUCCESS : EXIT_FAILURE;
+  return tester.isPassed() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
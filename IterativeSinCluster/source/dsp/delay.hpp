@@ -94,6 +94,16 @@ public:
   LinearSmoother<Sample> interpMinDelayTime;
   EMAFilter<Sample> delayTimeLowpass;
 
+  explicit Chorus(const SmootherContext<Sample> &context)
+    : interpTick(context)
+    , interpPhase(context)
+    , interpFeedback(context)
+    , interpDepth(context)
+    , interpDelayTimeRange(context)
+    , interpMinDelayTime(context)
+  {
+  }
+
   void setup(Sample sampleRate, Sample time, Sample maxTime)
   {
     delay.setup(sampleRate, time, maxTime);
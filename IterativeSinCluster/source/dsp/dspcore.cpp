@@ -7,8 +7,8 @@
 
 #include "dspcore.hpp"
 
-#define NOTE_NAME Note_FixedInstruction
-#define DSPCORE_NAME DSPCore_FixedInstruction
+#define NOTE_NAME UHHYOU_SIMD_NAME(Note_)
+#define DSPCORE_NAME UHHYOU_SIMD_NAME(DSPCore_)
 
 inline float clamp(float value, float min, float max)
 {
@@ -190,16 +190,16 @@ template<typename Sample> std::array<Sample, 2> NOTE_NAME<Sample>::process()
   return out;
 }
 
-DSPCORE_NAME::DSPCORE_NAME() { midiNotes.reserve(128); }
+DSPCORE_NAME::DSPCORE_NAME() {}
 
 void DSPCORE_NAME::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (auto &note : notes) note.setup(this->sampleRate);
 
@@ -219,7 +219,7 @@ void DSPCORE_NAME::reset()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   interpChorusMix.reset(param.value[ID::chorusMix]->getFloat());
   interpMasterGain.reset(
@@ -259,7 +259,7 @@ void DSPCORE_NAME::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   interpChorusMix.push(param.value[ID::chorusMix]->getFloat());
   interpMasterGain.push(
@@ -294,7 +294,7 @@ void DSPCORE_NAME::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   std::array<float, 2> frame{};
   std::array<float, 2> chorusOut{};
@@ -387,3 +387,8 @@ void DSPCORE_NAME::noteOff(int32_t noteId)
     if (x.id == noteId && x.state != NoteState::release) x.release();
   }
 }
+
+std::unique_ptr<DSPInterface> UHHYOU_SIMD_NAME(makeDSPCore_)()
+{
+  return std::make_unique<DSPCORE_NAME>();
+}
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
@@ -13,6 +15,7 @@
 
 #include <array>
 #include <cmath>
+#include <memory>
 
 using namespace SomeDSP;
 using namespace Steinberg::Synth;
@@ -80,7 +83,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   virtual void pushMidiNote(
     bool isNoteOn,
@@ -127,27 +130,23 @@ mpt stands for Max Poly Transition. I guess this sounds weird for English native
       note.pitch = pitch;                                                                \
       note.tuning = tuning;                                                              \
       note.velocity = velocity;                                                          \
-      midiNotes.push_back(note);                                                         \
+      midiNotes.push(note);                                                              \
     }                                                                                    \
                                                                                          \
     void processMidiNote(uint32_t frame) override                                        \
     {                                                                                    \
-      while (true) {                                                                     \
-        auto it                                                                          \
-          = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {   \
-              return nt.frame == frame;                                                  \
-            });                                                                          \
-        if (it == std::end(midiNotes)) return;                                           \
-        if (it->isNoteOn)                                                                \
-          noteOn(it->id, it->pitch, it->tuning, it->velocity);                           \
+      MidiNote note;                                                                     \
+      while (midiNotes.pop(frame, note)) {                                               \
+        if (note.isNoteOn)                                                               \
+          noteOn(note.id, note.pitch, note.tuning, note.velocity);                       \
         else                                                                             \
-          noteOff(it->id);                                                               \
-        midiNotes.erase(it);                                                             \
+          noteOff(note.id);                                                              \
       }                                                                                  \
     }                                                                                    \
                                                                                          \
   private:                                                                               \
     float sampleRate = 44100.0f;                                                         \
+    SmootherContext<float> smootherContext;                                              \
                                                                                          \
     White<float> rng{0};                                                                 \
                                                                                          \
@@ -155,10 +154,11 @@ mpt stands for Max Poly Transition. I guess this sounds weird for English native
     std::array<Note_##INSTRSET<float>, maxVoice> notes;                                  \
     float lastNoteFreq = 1.0f;                                                           \
                                                                                          \
-    std::array<Chorus<float>, 3> chorus;                                                 \
+    std::array<Chorus<float>, 3> chorus                                                  \
+      = makeSmootherArray<Chorus<float>, 3>(smootherContext);                            \
                                                                                          \
-    LinearSmoother<float> interpChorusMix;                                               \
-    LinearSmoother<float> interpMasterGain;                                              \
+    LinearSmoother<float> interpChorusMix{smootherContext};                              \
+    LinearSmoother<float> interpMasterGain{smootherContext};                             \
                                                                                          \
     std::vector<std::array<float, 2>> transitionBuffer{};                                \
     bool isTransitioning = false;                                                        \
@@ -166,5 +166,11 @@ mpt stands for Max Poly Transition. I guess this sounds weird for English native
     size_t mptStop = 0;                                                                  \
   };
 
-NOTE_CLASS(FixedInstruction)
-DSPCORE_CLASS(FixedInstruction)
+UHHYOU_SIMD_APPLY(NOTE_CLASS)
+UHHYOU_SIMD_APPLY(DSPCORE_CLASS)
+
+// Variant of current translation unit. Tests use this without dispatch.
+using DSPCore_FixedInstruction = UHHYOU_SIMD_NAME(DSPCore_);
+
+// Defined in `dspcore.cpp` for each variant. Use `UHHYOU_SIMD_DISPATCH(makeDSPCore_)`.
+UHHYOU_SIMD_DECLARE_FACTORY(std::unique_ptr<DSPInterface>, makeDSPCore_)
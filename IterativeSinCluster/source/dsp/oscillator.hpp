@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/simddispatch.hpp"
 #include "../../../lib/vcl.hpp"
 #include "../../../lib/vcl/vectormath_trig.h"
 
@@ -11,6 +12,7 @@
 #include <cmath>
 
 namespace SomeDSP {
+inline namespace UHHYOU_SIMD_NAMESPACE {
 
 template<size_t size> struct alignas(64) BiquadOsc {
 public:
@@ -43,4 +45,5 @@ public:
   }
 };
 
+} // namespace UHHYOU_SIMD_NAMESPACE
 } // namespace SomeDSP
@@ -104,14 +104,21 @@ public:
 
 template<typename Sample, size_t nest> class NestedLongAllpass {
 public:
-  std::array<ExpSmoother<Sample>, nest> seconds{};
-  std::array<ExpSmoother<Sample>, nest> innerFeed{};
-  std::array<ExpSmoother<Sample>, nest> outerFeed{};
+  std::array<ExpSmoother<Sample>, nest> seconds;
+  std::array<ExpSmoother<Sample>, nest> innerFeed;
+  std::array<ExpSmoother<Sample>, nest> outerFeed;
 
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
   std::array<LongAllpass<Sample>, nest> allpass;
 
+  explicit NestedLongAllpass(const SmootherContext<Sample> &context)
+    : seconds(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , innerFeed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , outerFeed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
@@ -150,6 +157,12 @@ public:
   std::array<ExpSmoother<Sample>, nest> feed;
   std::array<NestedLongAllpass<Sample, nSection1>, nest> allpass;
 
+  explicit NestD2(const SmootherContext<Sample> &context)
+    : feed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , allpass(makeSmootherArray<NestedLongAllpass<Sample, nSection1>, nest>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
@@ -187,6 +200,12 @@ public:
   std::array<ExpSmoother<Sample>, nest> feed;
   std::array<NestD2<Sample, nSection1, nSection2>, nest> allpass;
 
+  explicit NestD3(const SmootherContext<Sample> &context)
+    : feed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , allpass(makeSmootherArray<NestD2<Sample, nSection1, nSection2>, nest>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
@@ -230,6 +249,13 @@ public:
   std::array<ExpSmoother<Sample>, nest> feed;
   std::array<NestD3<Sample, nSection1, nSection2, nSection3>, nest> allpass;
 
+  explicit NestD4(const SmootherContext<Sample> &context)
+    : feed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , allpass(
+        makeSmootherArray<NestD3<Sample, nSection1, nSection2, nSection3>, nest>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
@@ -9,8 +9,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   for (auto &dly : delay) dly.setup(this->sampleRate, float(Scales::time.getMax()));
 
@@ -144,11 +144,39 @@ void DSPCore::startup()
   d4FeedRng.seed(d4FeedSeed);
 }
 
+size_t DSPCore::getTailLength()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  // Approximation. Nested allpass doesn't have a closed form of decay time. All the
+  // sections are on the signal path, so their total time is taken as the loop. The
+  // largest feed, including stereo cross, is taken as the gain of the loop.
+  auto timeMul = pv[ID::timeMultiply]->getFloat() * notePitchMultiplier;
+  float loopSeconds = 0;
+  float feed = std::abs(pv[ID::stereoCross]->getFloat());
+  auto updateFeed = [&](ID multiply, ID first, size_t length) {
+    auto mul = std::abs(pv[multiply]->getFloat());
+    for (size_t idx = 0; idx < length; ++idx)
+      feed = std::max(feed, mul * std::abs(pv[first + idx]->getFloat()));
+  };
+  for (size_t idx = 0; idx < nDepth1; ++idx) {
+    loopSeconds += std::min(timeMul * pv[ID::time0 + idx]->getFloat(), 1.0f);
+  }
+  updateFeed(ID::innerFeedMultiply, ID::innerFeed0, nDepth1);
+  updateFeed(ID::d1FeedMultiply, ID::d1Feed0, nDepth1);
+  updateFeed(ID::d2FeedMultiply, ID::d2Feed0, nDepth2);
+  updateFeed(ID::d3FeedMultiply, ID::d3Feed0, nDepth3);
+  updateFeed(ID::d4FeedMultiply, ID::d4Feed0, nDepth4);
+
+  return feedbackTailLength(sampleRate * loopSeconds, feed, pv[ID::wet]->getFloat());
+}
+
 void DSPCore::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   refreshSeed();
 
@@ -167,7 +195,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
@@ -104,14 +104,21 @@ public:
 
 template<typename Sample, size_t nest> class NestedLongAllpass {
 public:
-  std::array<ExpSmoother<Sample>, nest> seconds{};
-  std::array<ExpSmoother<Sample>, nest> innerFeed{};
-  std::array<ExpSmoother<Sample>, nest> outerFeed{};
+  std::array<ExpSmoother<Sample>, nest> seconds;
+  std::array<ExpSmoother<Sample>, nest> innerFeed;
+  std::array<ExpSmoother<Sample>, nest> outerFeed;
 
   std::array<Sample, nest> in{};
   std::array<Sample, nest> buffer{};
   std::array<LongAllpass<Sample>, nest> allpass;
 
+  explicit NestedLongAllpass(const SmootherContext<Sample> &context)
+    : seconds(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , innerFeed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+    , outerFeed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))
+  {
+  }
+
   void setup(Sample sampleRate, Sample maxTime)
   {
     for (auto &ap : allpass) ap.setup(sampleRate, maxTime);
@@ -151,6 +158,12 @@ public:
     std::array<ExpSmoother<Sample>, nest> feed;                                          \
     std::array<CHILD<Sample, nest>, nest> allpass;                                       \
                                                                                          \
+    explicit NAME(const SmootherContext<Sample> &context)                                \
+      : feed(makeSmootherArray<ExpSmoother<Sample>, nest>(context))                      \
+      , allpass(makeSmootherArray<CHILD<Sample, nest>, nest>(context))                   \
+    {                                                                                    \
+    }                                                                                    \
+                                                                                         \
     void setup(Sample sampleRate, Sample maxTime)                                        \
     {                                                                                    \
       for (auto &ap : allpass) ap.setup(sampleRate, maxTime);                            \
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/silence.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 
@@ -25,17 +27,14 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
 
   void setup(double sampleRate);
   void reset();
   void startup();
+  size_t getTailLength();
   void setParameters();
   void process(
     const size_t length, const float *in0, const float *in1, float *out0, float *out1);
@@ -56,21 +55,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -78,11 +73,12 @@ private:
   void refreshSeed();
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   std::minstd_rand timeRng{0};
   std::minstd_rand innerRng{0};
@@ -97,10 +93,11 @@ private:
   uint_fast32_t d3FeedSeed = 0;
   uint_fast32_t d4FeedSeed = 0;
 
-  std::array<NestD4<float, 4>, 2> delay;
+  std::array<NestD4<float, 4>, 2> delay
+    = makeSmootherArray<NestD4<float, 4>, 2>(smootherContext);
   std::array<float, 2> delayOut{};
-  ExpSmoother<float> interpStereoCross;
-  ExpSmoother<float> interpStereoSpread;
-  ExpSmoother<float> interpDry;
-  ExpSmoother<float> interpWet;
+  ExpSmoother<float> interpStereoCross{smootherContext};
+  ExpSmoother<float> interpStereoSpread{smootherContext};
+  ExpSmoother<float> interpDry{smootherContext};
+  ExpSmoother<float> interpWet{smootherContext};
 };
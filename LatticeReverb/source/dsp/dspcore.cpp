@@ -9,8 +9,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   delay.setup(this->sampleRate, float(Scales::time.getMax()));
 
@@ -80,37 +80,41 @@ void DSPCore::reset()
 
 void DSPCore::startup() { rng.seed(0); }
 
+size_t DSPCore::getTailLength()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  // Approximation. Nested allpass doesn't have a closed form of decay time. Round trip
+  // through all the nests is taken as the loop, and the largest feed as its gain.
+  auto timeMul = notePitchMultiplier * pv[ID::timeMultiply]->getFloat();
+  auto outerMul = std::abs(pv[ID::outerFeedMultiply]->getFloat());
+  auto innerMul = std::abs(pv[ID::innerFeedMultiply]->getFloat());
+  float loopSeconds = 0;
+  float feed = 0;
+  for (size_t idx = 0; idx < nestingDepth; ++idx) {
+    auto time = timeMul * pv[ID::time0 + idx]->getFloat();
+    loopSeconds += std::clamp<float>(
+      time + pv[ID::timeLfoAmount0 + idx]->getFloat(), 0.0f, 1.0f);
+    feed = std::max(feed, outerMul * std::abs(pv[ID::outerFeed0 + idx]->getFloat()));
+    feed = std::max(feed, innerMul * std::abs(pv[ID::innerFeed0 + idx]->getFloat()));
+  }
+  return feedbackTailLength(sampleRate * loopSeconds, feed, pv[ID::wet]->getFloat());
+}
+
 void DSPCore::setParameters()
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
-  auto timeMul = notePitchMultiplier * param.value[ID::timeMultiply]->getFloat();
   auto outerMul = param.value[ID::outerFeedMultiply]->getFloat();
   auto innerMul = param.value[ID::innerFeedMultiply]->getFloat();
-  auto timeOffsetMul = param.value[ID::timeOffsetMultiply]->getFloat();
   auto outerOffsetMul = param.value[ID::outerFeedOffsetMultiply]->getFloat();
   auto innerOffsetMul = param.value[ID::innerFeedOffsetMultiply]->getFloat();
-  auto timeLfoLowpassKp = param.value[ID::timeLfoLowpass]->getFloat();
 
-  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  // Delay times are pushed in `process()`, as they step the LFO.
   for (size_t idx = 0; idx < nestingDepth; ++idx) {
-    auto timeOffset
-      = calcOffset(param.value[ID::timeOffset0 + idx]->getFloat(), timeOffsetMul);
-    auto time = param.value[ID::time0 + idx]->getFloat();
-    auto timeLfo = param.value[ID::timeLfoAmount0 + idx]->getFloat();
-    lowpassLfoTime[0][idx].kp = timeLfoLowpassKp;
-    lowpassLfoTime[1][idx].kp = timeLfoLowpassKp;
-    interpTime[0][idx].push(std::clamp<float>(
-      timeOffset[0] * timeMul * time
-        + timeLfo * lowpassLfoTime[0][idx].process(dist(rng)),
-      0.0f, 1.0f));
-    interpTime[1][idx].push(std::clamp<float>(
-      timeOffset[1] * timeMul * time
-        + timeLfo * lowpassLfoTime[1][idx].process(dist(rng)),
-      0.0f, 1.0f));
-
     auto outerOffset
       = calcOffset(param.value[ID::outerFeedOffset0 + idx]->getFloat(), outerOffsetMul);
     auto outerFeed = param.value[ID::outerFeed0 + idx]->getFloat();
@@ -136,7 +140,9 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
+
+  updateDelayTime();
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
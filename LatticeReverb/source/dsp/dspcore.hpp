@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/silence.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 
@@ -25,17 +27,14 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
 
   void setup(double sampleRate);
   void reset();
   void startup();
+  size_t getTailLength();
   void setParameters();
   void process(
     const size_t length, const float *in0, const float *in1, float *out0, float *out1);
@@ -56,43 +55,47 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   std::minstd_rand rng{0};
   std::array<std::array<EMAFilter<float>, nestingDepth>, 2> lowpassLfoTime;
 
   StereoLongAllpass<float, nestingDepth> delay;
-  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpTime;
-  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpOuterFeed;
-  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpInnerFeed;
-  std::array<ExpSmoother<float>, nestingDepth> interpLowpassCutoff;
-  ExpSmoother<float> interpStereoCross;
-  ExpSmoother<float> interpStereoSpread;
-  ExpSmoother<float> interpDry;
-  ExpSmoother<float> interpWet;
+  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpTime
+    = makeSmootherArray<std::array<ExpSmoother<float>, nestingDepth>, 2>(
+      makeSmootherArray<ExpSmoother<float>, nestingDepth>(smootherContext));
+  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpOuterFeed
+    = makeSmootherArray<std::array<ExpSmoother<float>, nestingDepth>, 2>(
+      makeSmootherArray<ExpSmoother<float>, nestingDepth>(smootherContext));
+  std::array<std::array<ExpSmoother<float>, nestingDepth>, 2> interpInnerFeed
+    = makeSmootherArray<std::array<ExpSmoother<float>, nestingDepth>, 2>(
+      makeSmootherArray<ExpSmoother<float>, nestingDepth>(smootherContext));
+  std::array<ExpSmoother<float>, nestingDepth> interpLowpassCutoff
+    = makeSmootherArray<ExpSmoother<float>, nestingDepth>(smootherContext);
+  ExpSmoother<float> interpStereoCross{smootherContext};
+  ExpSmoother<float> interpStereoSpread{smootherContext};
+  ExpSmoother<float> interpDry{smootherContext};
+  ExpSmoother<float> interpWet{smootherContext};
 };
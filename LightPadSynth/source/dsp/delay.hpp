@@ -12,7 +12,87 @@
 
 namespace SomeDSP {
 
-// 2x oversampled delay with feedback.
+/**
+Delay buffers shared by the voices. Only sounding voices hold a buffer, so the memory
+follows the polyphony instead of the maximum number of voices.
+
+`acquire`, `release`, `requestGrow` and `commitPending` are realtime safe.
+`allocatePending` runs on the background worker between `requestGrow` and
+`commitPending`. `acquire` returns `nullptr` when the pool is empty. Voices without a
+buffer are bound after `commitPending`, so they get the delay once the pool grows.
+*/
+template<typename Sample> class DelayPool {
+private:
+  size_t length = 0;
+  size_t growTarget = 0;
+  std::vector<std::vector<Sample>> buffers;
+  std::vector<std::vector<Sample>> pending;
+  std::vector<Sample *> freeList;
+
+public:
+  // Not realtime safe. Allocates `nBuffer` buffers, and reserves for `maxBuffer`.
+  void setup(size_t bufferLength, size_t nBuffer, size_t maxBuffer)
+  {
+    length = bufferLength;
+    nBuffer = std::min(nBuffer, maxBuffer);
+
+    buffers.clear();
+    buffers.shrink_to_fit();
+    buffers.reserve(maxBuffer);
+    pending.clear();
+    pending.reserve(maxBuffer);
+    freeList.clear();
+    freeList.reserve(maxBuffer);
+
+    for (size_t idx = 0; idx < nBuffer; ++idx) {
+      buffers.emplace_back(length, Sample(0));
+      freeList.push_back(buffers.back().data());
+    }
+    growTarget = buffers.size();
+  }
+
+  size_t bufferLength() const { return length; }
+  size_t capacity() const { return buffers.size(); }
+
+  Sample *acquire()
+  {
+    if (freeList.empty()) return nullptr;
+    auto data = freeList.back();
+    freeList.pop_back();
+    return data;
+  }
+
+  void release(Sample *data)
+  {
+    if (data != nullptr) freeList.push_back(data);
+  }
+
+  // Returns false if `nBuffer` is already satisfied.
+  bool requestGrow(size_t nBuffer)
+  {
+    growTarget = std::min(nBuffer, buffers.capacity());
+    return growTarget > buffers.size();
+  }
+
+  void allocatePending()
+  {
+    for (size_t idx = buffers.size(); idx < growTarget; ++idx) {
+      pending.emplace_back(length, Sample(0));
+    }
+  }
+
+  void commitPending()
+  {
+    for (auto &buf : pending) {
+      buffers.push_back(std::move(buf));
+      freeList.push_back(buffers.back().data());
+    }
+    pending.clear();
+  }
+};
+
+// 2x oversampled delay with feedback. Buffer is borrowed from `DelayPool`, and the output
+// is 0 while no buffer is bound.
 template<typename Sample> class Delay {
 public:
   Sample w1 = 0;
@@ -20,59 +100,80 @@ public:
   Sample rFraction = 0.0;
   int wptr = 0;
   int rptr = 0;
-  std::vector<Sample> buf;
+  Sample *buf = nullptr;
+  int size = 0;
 
-  void setup(Sample sampleRate, Sample time, Sample maxTime)
+  static size_t bufferLength(Sample sampleRate, Sample maxTime)
   {
-    auto size = int(Sample(2) * sampleRate * maxTime) + 1;
-    buf.resize(size < 0 ? 4 : size);
+    auto length = int(Sample(2) * sampleRate * maxTime) + 1;
+    return size_t(length < 4 ? 4 : length);
+  }
 
-    setTime(sampleRate, time);
-    reset();
+  bool isBound() const { return buf != nullptr; }
+
+  void acquire(DelayPool<Sample> &pool)
+  {
+    if (isBound()) return;
+    buf = pool.acquire();
+    if (buf == nullptr) return;
+    size = int(pool.bufferLength());
+    wptr = 0;
+    rptr = 0;
+  }
+
+  void release(DelayPool<Sample> &pool)
+  {
+    pool.release(buf);
+    buf = nullptr;
+    size = 0;
   }
 
   void reset()
   {
-    std::fill(buf.begin(), buf.end(), Sample(0));
+    if (isBound()) std::fill(buf, buf + size, Sample(0));
     w1 = 0;
     r1 = 0;
   }
 
   void setTime(Sample sampleRate, Sample seconds)
   {
-    Sample timeInSample = std::clamp<Sample>(
-      Sample(2) * sampleRate * seconds, Sample(0), Sample(buf.size()));
+    if (!isBound()) return;
+
+    Sample timeInSample
+      = std::clamp<Sample>(Sample(2) * sampleRate * seconds, Sample(0), Sample(size));
 
     int timeInt = int(timeInSample);
     rFraction = timeInSample - Sample(timeInt);
 
     rptr = wptr - timeInt;
-    if (rptr < 0) rptr += int(buf.size());
+    if (rptr < 0) rptr += size;
   }
 
   Sample process(Sample input, Sample feedback)
   {
+    if (!isBound()) return r1 = 0;
+
     input += feedback * r1;
 
     // Write to buffer.
     buf[wptr] = input - Sample(0.5) * (input - w1);
     ++wptr;
-    if (wptr >= int(buf.size())) wptr -= int(buf.size());
+    if (wptr >= size) wptr -= size;
 
     buf[wptr] = input;
     ++wptr;
-    if (wptr >= int(buf.size())) wptr -= int(buf.size());
+    if (wptr >= size) wptr -= size;
 
     w1 = input;
 
     // Read from buffer.
     const size_t i1 = rptr;
     ++rptr;
-    if (rptr >= int(buf.size())) rptr -= int(buf.size());
+    if (rptr >= size) rptr -= size;
 
     const size_t i0 = rptr;
     ++rptr;
-    if (rptr >= int(buf.size())) rptr -= int(buf.size());
+    if (rptr >= size) rptr -= size;
 
     return r1 = buf[i0] - rFraction * (buf[i0] - buf[i1]);
   }
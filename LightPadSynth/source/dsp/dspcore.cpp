@@ -23,8 +23,6 @@ inline float mapCutoff(float x)
        + float(0.4872433705867005) * x * x + float(-0.13155292689641543) * x * x * x);
 }
 
-void Note::setup(float sampleRate) { delay.setup(sampleRate, 0.0f, delayMaxTime); }
-
 void Note::noteOn(
   int32_t noteId,
   float notePitch,
@@ -131,20 +129,27 @@ DSPCore::DSPCore()
   voiceIndices.reserve(maxVoice);
 
   peakInfos.resize(nOvertone);
-
-  midiNotes.reserve(maxVoice);
 }
 
 void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
-  for (auto &note : notes) note.setup(this->sampleRate);
+  nVoice = std::min<size_t>(
+    16 * (param.value[ParameterID::nVoice]->getInt() + 1), maxVoice);
+  delayPoolTask.wait();
+  delayPoolTask.poll();
+  for (auto &note : notes) note.delay.release(delayPool);
+  delayPool.setup(
+    Delay<float>::bufferLength(this->sampleRate, delayMaxTime), nVoice, maxVoice);
+  for (auto &note : notes) {
+    if (note.state != NoteState::rest) note.delay.acquire(delayPool);
+  }
 
   // 2 msec + 1 sample transition time.
   transitionBuffer.resize(1 + size_t(this->sampleRate * 0.01), {0.0f, 0.0f});
@@ -158,7 +163,10 @@ void DSPCore::reset()
   using ID = ParameterID::ID;
 
   panCounter = 0;
-  for (auto &note : notes) note.rest();
+  for (auto &note : notes) {
+    note.rest();
+    note.delay.release(delayPool);
+  }
 
   info.reset(param, sampleRate);
   interpMasterGain.reset(param.value[ID::gain]->getFloat());
@@ -177,7 +185,7 @@ void DSPCore::setParameters(float tempo)
 {
   using ID = ParameterID::ID;
 
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
   interpMasterGain.push(param.value[ID::gain]->getFloat());
 
@@ -211,6 +219,7 @@ void DSPCore::setParameters(float tempo)
 
   nVoice = 16 * (param.value[ID::nVoice]->getInt() + 1);
   if (nVoice > notes.size()) nVoice = notes.size();
+  if (!delayPoolTask.isBusy() && delayPool.requestGrow(nVoice)) delayPoolTask.submit();
 
   for (auto &note : notes) {
     if (note.state == NoteState::rest) continue;
@@ -240,7 +249,18 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
+
+  if (delayPoolTask.poll()) {
+    delayPool.commitPending();
+
+    // Binds the notes which started while the pool was short.
+    for (auto &note : notes) {
+      if (note.state == NoteState::rest || note.delay.isBound()) continue;
+      note.delay.acquire(delayPool);
+      note.delay.reset();
+    }
+  }
 
   std::array<float, 2> frame{};
   for (uint32_t i = 0; i < length; ++i) {
@@ -255,6 +275,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
       auto sig = note.process(sampleRate, wavetable, info);
       frame[0] += sig[0];
       frame[1] += sig[1];
+      if (note.state == NoteState::rest) note.delay.release(delayPool);
     }
 
     if (isTransitioning) {
@@ -411,6 +432,8 @@ void DSPCore::noteOn(int32_t identifier, int16_t pitch, float tuning, float velo
     }
   }
 
+  for (auto &index : noteIndices) notes[index].delay.acquire(delayPool);
+
   if (nUnison <= 1) {
     notes[noteIndices[0]].noteOn(
       identifier, float(pitch) + tuning, velocity, 0.5f, 0.0f, sampleRate, wavetable,
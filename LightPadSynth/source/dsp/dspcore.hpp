@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "../../../common/backgroundjob.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
@@ -80,6 +82,23 @@ struct NoteProcessInfo {
     if (lfoOut < 0.0f) lfoOut = 0.0f;
   }
 
+  explicit NoteProcessInfo(const SmootherContext<float> &context)
+    : masterPitch(context)
+    , equalTemperament(context)
+    , pitchA4Hz(context)
+    , filterCutoff(context)
+    , filterResonance(context)
+    , filterAmount(context)
+    , filterKeyFollow(context)
+    , delayMix(context)
+    , delayDetune(context)
+    , delayFeedback(context)
+    , lfoFrequency(context)
+    , lfoAmount(context)
+    , lfoLowpass(context)
+  {
+  }
+
   void reset(GlobalParameter &param, float sampleRate)
   {
     using ID = ParameterID::ID;
@@ -134,7 +153,11 @@ public:
   Delay<float> delay;
   float delaySeconds = 0;
 
-  void setup(float sampleRate);
+  explicit Note(const SmootherContext<float> &context)
+    : gainEnvelope(context), filterEnvelope(context)
+  {
+  }
+
   void noteOn(
     int32_t noteId,
     float notePitch,
@@ -169,7 +192,7 @@ public:
   static constexpr size_t maxVoice = 128;
   GlobalParameter param;
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   DSPCore();
 
@@ -199,21 +222,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(uint32_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -221,6 +240,7 @@ private:
   void setUnisonPan(size_t nUnison);
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   std::vector<PeakInfo<float>> peakInfos;
 
@@ -235,10 +255,15 @@ private:
   std::vector<size_t> noteIndices;
   std::vector<size_t> voiceIndices;
   std::vector<float> unisonPan;
-  std::array<Note, maxVoice> notes;
+  std::array<Note, maxVoice> notes = makeSmootherArray<Note, maxVoice>(smootherContext);
+
+  // Delay buffers are bound to the notes on note-on, and returned on rest. When the
+  // polyphony goes up, missing buffers are allocated on background thread.
+  DelayPool<float> delayPool;
+  BackgroundTask delayPoolTask{[this]() { delayPool.allocatePending(); }};
 
-  NoteProcessInfo info;
-  LinearSmoother<float> interpMasterGain;
+  NoteProcessInfo info{smootherContext};
+  LinearSmoother<float> interpMasterGain{smootherContext};
 
   std::vector<std::array<float, 2>> transitionBuffer{};
   bool isTransitioning = false;
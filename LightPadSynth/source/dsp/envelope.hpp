@@ -120,6 +120,8 @@ public:
 
 template<typename Sample> class ExpADSREnvelope {
 public:
+  explicit ExpADSREnvelope(const SmootherContext<Sample> &context) : sus(context) {}
+
   void reset(
     Sample sampleRate,
     Sample attackTime,
@@ -247,6 +249,8 @@ protected:
 
 template<typename Sample> class LinearADSREnvelope {
 public:
+  explicit LinearADSREnvelope(const SmootherContext<Sample> &context) : sus(context) {}
+
   Sample secondToDelta(Sample sampleRate, Sample seconds)
   {
     return Sample(1) / (sampleRate * seconds);
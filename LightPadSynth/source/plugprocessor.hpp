@@ -11,6 +11,8 @@
 #include "pluginterfaces/vst/ivstaudioprocessor.h"
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -42,11 +44,12 @@ public:
     return (Vst::IAudioProcessor *)new PlugProcessor();
   }
 
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
 protected:
   uint64_t lastState = 0;
   float tempo = 120.0f;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
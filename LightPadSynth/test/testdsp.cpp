@@ -23,5 +23,5 @@ int main()
     UHHYOU_PLUGIN_NAME, OUT_DIR_PATH, 1);
 #endif
 
-  return tester.isFinished ? EXIT_SUCCESS : EXIT_FAILURE;
+  return tester.isPassed() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -33,7 +33,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
@@ -60,7 +60,7 @@ void DSPCore::updateUpRate()
   auto fold = oversampling ? upFold : size_t(1);
   upRate = double(sampleRate) * fold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
   lfo.setup(upRate, double(0.1));
@@ -199,7 +199,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -24,8 +24,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.04f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.04f);
 
   for (auto &shf : shifter) shf.setup(this->sampleRate, maxShiftDelaySeconds);
 
@@ -59,7 +59,7 @@ void DSPCore::setup(double sampleRate)
   }                                                                                      \
   interpShiftGain.back().METHOD(bypassMix);                                              \
                                                                                          \
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());
 
 void DSPCore::reset()
 {
@@ -90,7 +90,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   // When tempo-sync is off, use 120 BPM.
   bool isTempoSyncing = param.value[ParameterID::lfoTempoSync]->getInt();
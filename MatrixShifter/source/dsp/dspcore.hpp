@@ -33,6 +33,7 @@ private:
   float getTempoSyncInterval();
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   // Temporary variables.
   std::array<float, 2> lfoOut{};
@@ -40,18 +41,22 @@ private:
   std::array<float, 2> feedbackCutoffHz{};
   std::array<float, 2> lfoHz{};
 
-  ExpSmoother<float> interpGain;
-  ExpSmoother<float> interpShiftFeedbackGain;
-  ExpSmoother<float> interpShiftFeedbackCutoff;
-  ExpSmoother<float> interpSectionGain;
-  ExpSmoother<float> interpLfoLrPhaseOffset;
-  ExpSmoother<float> interpLfoToDelay;
-  ExpSmoother<float> interpLfoSkew;
-  ExpSmoother<float> interpLfoToPitchShift;
-  ExpSmoother<float> interpLfoToFeedbackCutoff;
-  std::array<std::array<ExpSmoother<float>, nParallel>, nSerial> interpShiftHz;
-  std::array<ExpSmoother<float>, nSerial> interpShiftDelay;
-  std::array<ExpSmoother<float>, nSerial + 1> interpShiftGain;
+  ExpSmoother<float> interpGain{smootherContext};
+  ExpSmoother<float> interpShiftFeedbackGain{smootherContext};
+  ExpSmoother<float> interpShiftFeedbackCutoff{smootherContext};
+  ExpSmoother<float> interpSectionGain{smootherContext};
+  ExpSmoother<float> interpLfoLrPhaseOffset{smootherContext};
+  ExpSmoother<float> interpLfoToDelay{smootherContext};
+  ExpSmoother<float> interpLfoSkew{smootherContext};
+  ExpSmoother<float> interpLfoToPitchShift{smootherContext};
+  ExpSmoother<float> interpLfoToFeedbackCutoff{smootherContext};
+  std::array<std::array<ExpSmoother<float>, nParallel>, nSerial> interpShiftHz
+    = makeSmootherArray<std::array<ExpSmoother<float>, nParallel>, nSerial>(
+      makeSmootherArray<ExpSmoother<float>, nParallel>(smootherContext));
+  std::array<ExpSmoother<float>, nSerial> interpShiftDelay
+    = makeSmootherArray<ExpSmoother<float>, nSerial>(smootherContext);
+  std::array<ExpSmoother<float>, nSerial + 1> interpShiftGain
+    = makeSmootherArray<ExpSmoother<float>, nSerial + 1>(smootherContext);
 
   TempoSynchronizer<float> syncer;
   std::array<LFO<float>, 2> lfo;
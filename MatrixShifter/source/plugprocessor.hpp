@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -48,6 +50,7 @@ protected:
   }
 
   uint32_t wasBypassing = 0;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
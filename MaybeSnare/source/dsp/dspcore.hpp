@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -26,7 +27,6 @@ public:
 
   DSPCore()
   {
-    midiNotes.reserve(1024);
     noteStack.reserve(1024);
 
     batterFdnMatrixRandomBase.resize(fdnSize);
@@ -69,21 +69,17 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -97,7 +93,7 @@ private:
 
   static constexpr size_t upFold = 2;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   DecibelScale<double> velocityMap{-60, 0, true};
@@ -109,6 +105,7 @@ private:
   bool enableSnareModEnv = true;
 
   double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100.0;
 
   double noteNumber = 69.0;
@@ -117,21 +114,21 @@ private:
   ExpSmootherLocal<double> snareSidePitch;
   ExpSmootherLocal<double> frequencyHz;
 
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> fdnMix;
-  ExpSmoother<double> impactNoiseMix;
-  ExpSmoother<double> couplingAmount;
-  ExpSmoother<double> couplingSafetyReduction;
-  ExpSmoother<double> batterShape;
-  ExpSmoother<double> batterFeedback;
-  ExpSmoother<double> batterModulation;
-  ExpSmoother<double> batterInterpRate;
-  ExpSmoother<double> batterMinModulation;
-  ExpSmoother<double> snareShape;
-  ExpSmoother<double> snareFeedback;
-  ExpSmoother<double> snareModulation;
-  ExpSmoother<double> snareInterpRate;
-  ExpSmoother<double> snareMinModulation;
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> fdnMix{smootherContext};
+  ExpSmoother<double> impactNoiseMix{smootherContext};
+  ExpSmoother<double> couplingAmount{smootherContext};
+  ExpSmoother<double> couplingSafetyReduction{smootherContext};
+  ExpSmoother<double> batterShape{smootherContext};
+  ExpSmoother<double> batterFeedback{smootherContext};
+  ExpSmoother<double> batterModulation{smootherContext};
+  ExpSmoother<double> batterInterpRate{smootherContext};
+  ExpSmoother<double> batterMinModulation{smootherContext};
+  ExpSmoother<double> snareShape{smootherContext};
+  ExpSmoother<double> snareFeedback{smootherContext};
+  ExpSmoother<double> snareModulation{smootherContext};
+  ExpSmoother<double> snareInterpRate{smootherContext};
+  ExpSmoother<double> snareMinModulation{smootherContext};
 
   uint32_t previousSeed = 0;
   pcg64 rng;
@@ -146,8 +143,8 @@ private:
   PulseGenerator<double> pulse;
   SREnvelope<double> batterModEnvelope;
   SREnvelope<double> snareModEnvelope;
-  SnaredFDN<double, fdnSize> batterSide;
-  SnaredFDN<double, fdnSize> snareSide;
+  SnaredFDN<double, fdnSize> batterSide{smootherContext};
+  SnaredFDN<double, fdnSize> snareSide{smootherContext};
   HalfBandIIR<double, HalfBandCoefficient<double>> halfbandIir;
 
   double calcNotePitch(double note);
@@ -100,6 +100,12 @@ private:
   std::array<ExpSmoother<Sample>, length> k;
 
 public:
+  explicit ParallelSVFHighpass(const SmootherContext<Sample> &context)
+    : g(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+    , k(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+  {
+  }
+
   void pushCutoffAt(size_t index, Sample normalizedFreq, Sample Q)
   {
     g[index].push(std::tan(std::clamp(normalizedFreq, minCutoff, nyquist) * Sample(pi)));
@@ -148,6 +154,12 @@ private:
   std::array<ExpSmoother<Sample>, length> k;
 
 public:
+  explicit ParallelSVFHighshelf(const SmootherContext<Sample> &context)
+    : g(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+    , k(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+  {
+  }
+
   void pushCutoffAt(size_t index, Sample normalizedFreq, Sample Q)
   {
     g[index].push(
@@ -307,7 +319,11 @@ public:
   ParallelSVFHighshelf<Sample, length> lowpass;
   ParallelSVFHighpass<Sample, length> highpass;
 
-  SnaredFDN() { inputGain.fill(Sample(1) / Sample(length)); }
+  explicit SnaredFDN(const SmootherContext<Sample> &context)
+    : lowpass(context), highpass(context)
+  {
+    inputGain.fill(Sample(1) / Sample(length));
+  }
 
   /**
   If `identityAmount` is close to 0, then the result becomes close to identity matrix.
@@ -33,8 +33,8 @@ void DSPCore::setup(double sampleRate)
 
   constexpr auto smoothingTimeSecond = 0.2;
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<double>::setTime(smoothingTimeSecond);
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(smoothingTimeSecond);
 
   fdn.setup(upRate, 1.0);
 
@@ -153,8 +153,8 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
+  smootherContext.setSampleRate(upRate);
 
   bool overSampling = pv[ID::overSampling]->getInt();
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -26,7 +27,6 @@ public:
 
   DSPCore()
   {
-    midiNotes.reserve(1024);
     noteStack.reserve(1024);
 
     fdnMatrixRandomBase.resize(fdnSize);
@@ -64,21 +64,17 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -92,7 +88,7 @@ private:
 
   static constexpr size_t upFold = 2;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   DecibelScale<double> velocityMap{-60, 0, true};
@@ -102,6 +98,7 @@ private:
   bool enableModEnv = true;
 
   double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100.0;
 
   double noteNumber = 69.0;
@@ -109,12 +106,12 @@ private:
   ExpSmootherLocal<double> interpPitch;
   ExpSmootherLocal<double> frequencyHz;
 
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> fdnShape;
-  ExpSmoother<double> fdnFeedback;
-  ExpSmoother<double> fdnModulation;
-  ExpSmoother<double> fdnInterpRate;
-  ExpSmoother<double> fdnMinModulation;
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> fdnShape{smootherContext};
+  ExpSmoother<double> fdnFeedback{smootherContext};
+  ExpSmoother<double> fdnModulation{smootherContext};
+  ExpSmoother<double> fdnInterpRate{smootherContext};
+  ExpSmoother<double> fdnMinModulation{smootherContext};
 
   uint32_t previousSeed = 0;
   pcg64 rng;
@@ -123,7 +120,7 @@ private:
 
   PulseGenerator<double> pulse;
   SREnvelope<double> modulationEnvelope;
-  ModulatedFDN<double, fdnSize> fdn;
+  ModulatedFDN<double, fdnSize> fdn{smootherContext};
   HalfBandIIR<double, HalfBandCoefficient<double>> halfbandIir;
 
   double calcNotePitch(double note);
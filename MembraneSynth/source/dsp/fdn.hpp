@@ -72,6 +72,12 @@ private:
   std::array<ExpSmoother<Sample>, length> k;
 
 public:
+  explicit ParallelSVFHighpass(const SmootherContext<Sample> &context)
+    : g(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+    , k(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+  {
+  }
+
   void pushCutoffAt(size_t index, Sample normalizedFreq, Sample Q)
   {
     g[index].push(std::tan(std::clamp(normalizedFreq, minCutoff, nyquist) * Sample(pi)));
@@ -120,6 +126,12 @@ private:
   std::array<ExpSmoother<Sample>, length> k;
 
 public:
+  explicit ParallelSVFHighshelf(const SmootherContext<Sample> &context)
+    : g(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+    , k(makeSmootherArray<ExpSmoother<Sample>, length>(context))
+  {
+  }
+
   void pushCutoffAt(size_t index, Sample normalizedFreq, Sample Q)
   {
     g[index].push(
@@ -279,6 +291,11 @@ public:
   ParallelSVFHighshelf<Sample, length> lowpass;
   ParallelSVFHighpass<Sample, length> highpass;
 
+  explicit ModulatedFDN(const SmootherContext<Sample> &context)
+    : lowpass(context), highpass(context)
+  {
+  }
+
   /**
   If `identityAmount` is close to 0, then the result becomes close to identity matrix.
 
@@ -17,8 +17,16 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
+
+  firFadeLength = std::max(size_t(1), size_t(this->sampleRate * 0.01f));
+
+  // FIR in flight is for the previous sample rate.
+  firTask.wait();
+  firTask.poll();
+  isFirRequested = false;
+  firTransitionCounter = 0;
 
   reset();
   startup();
@@ -38,7 +46,12 @@ void DSPCore::reset()
 {
   ASSIGN_PARAMETER(reset);
 
-  for (auto &cnv : convolver) cnv.reset();
+  // The other set has the new FIR during transition. `firTask` is idle here.
+  if (firTransitionCounter > 0) {
+    activeConvolver ^= 1;
+    firTransitionCounter = 0;
+  }
+  for (auto &cnv : convolver[activeConvolver]) cnv.reset();
   for (auto &dly : delay) dly.reset();
 
   startup();
@@ -50,12 +63,24 @@ void DSPCore::setParameters()
 {
   ASSIGN_PARAMETER(push);
 
-  if (prepareRefresh || (!isFirRefreshed && pv[ID::refreshFir]->getInt())) {
+  if (prepareRefresh) {
     auto cutoffHz = pv[ID::cutoffHz]->getFloat();
-    for (auto &cnv : convolver) cnv.refreshFir(sampleRate, cutoffHz, false);
+    for (auto &cnv : convolver[activeConvolver]) {
+      cnv.refreshFir(sampleRate, cutoffHz, false);
+    }
+  } else if (!isFirRefreshed && pv[ID::refreshFir]->getInt()) {
+    isFirRequested = true;
   }
   isFirRefreshed = pv[ID::refreshFir]->getInt();
   prepareRefresh = false;
+
+  if (firTask.poll()) firTransitionCounter = Convolver::nTap + firFadeLength;
+  if (isFirRequested && !firTask.isBusy() && firTransitionCounter == 0) {
+    firTarget = activeConvolver ^ 1;
+    firSampleRate = sampleRate;
+    firCutoffHz = pv[ID::cutoffHz]->getFloat();
+    if (firTask.submit()) isFirRequested = false;
+  }
 }
 
 void DSPCore::process(
@@ -63,14 +88,29 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
   for (size_t i = 0; i < length; ++i) {
-    auto lp0 = convolver[0].process(in0[i]);
-    auto lp1 = convolver[1].process(in1[i]);
+    auto &cnv = convolver[activeConvolver];
+    auto lp0 = cnv[0].process(in0[i]);
+    auto lp1 = cnv[1].process(in1[i]);
+
+    if (firTransitionCounter > 0) {
+      auto &next = convolver[activeConvolver ^ 1];
+      auto nextLp0 = next[0].process(in0[i]);
+      auto nextLp1 = next[1].process(in1[i]);
+
+      --firTransitionCounter;
+      if (firTransitionCounter < firFadeLength) {
+        auto fade = float(firTransitionCounter) / float(firFadeLength);
+        lp0 = nextLp0 + fade * (lp0 - nextLp0);
+        lp1 = nextLp1 + fade * (lp1 - nextLp1);
+      }
+      if (firTransitionCounter == 0) activeConvolver ^= 1;
+    }
 
     auto hp0 = delay[0].process(in0[i]) - lp0;
     auto hp1 = delay[1].process(in1[i]) - lp1;
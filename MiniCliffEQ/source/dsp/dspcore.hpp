@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../../common/backgroundjob.hpp"
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/lightlimiter.hpp"
 #include "../../../common/dsp/smoother.hpp"
@@ -33,12 +34,34 @@ public:
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   bool prepareRefresh = false;
   bool isFirRefreshed = false;
 
-  ExpSmoother<float> interpHighpassGain;
-  ExpSmoother<float> interpLowpassGain;
+  ExpSmoother<float> interpHighpassGain{smootherContext};
+  ExpSmoother<float> interpLowpassGain{smootherContext};
 
-  std::array<SplitConvolver<nBlock, blockSizeInPow2>, 2> convolver;
+  using Convolver = SplitConvolver<nBlock, blockSizeInPow2>;
+
+  // `convolver[activeConvolver]` is the output. The other set is used for FIR refresh.
+  std::array<std::array<Convolver, 2>, 2> convolver;
   std::array<FixedIntDelay<float, fftconvLatency>, 2> delay;
+  size_t activeConvolver = 0;
+
+  // FIR refresh requested from GUI is built into the inactive set on background thread.
+  // `firTarget`, `firSampleRate` and `firCutoffHz` are the inputs, written only while
+  // `firTask` is idle. After the build, both sets run for `Convolver::nTap` samples to
+  // fill the new one, then the output is crossfaded over `firFadeLength`.
+  bool isFirRequested = false;
+  size_t firTarget = 1;
+  float firSampleRate = 44100.0f;
+  float firCutoffHz = 1.0f;
+  size_t firFadeLength = 1;
+  size_t firTransitionCounter = 0;
+  BackgroundTask firTask{[this]() {
+    for (auto &cnv : convolver[firTarget]) {
+      cnv.refreshFir(firSampleRate, firCutoffHz, false);
+      cnv.reset();
+    }
+  }};
 };
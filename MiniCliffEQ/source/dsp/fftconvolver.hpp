@@ -4,13 +4,13 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
-#include "../../../lib/fftw3/fftw3.h"
+#include "../../../common/dsp/fft/fftw.hpp"
+#include "../../../common/trace.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <complex>
-#include <mutex>
 #include <numeric>
 #include <vector>
 
@@ -85,9 +85,6 @@ public:
 
 class OverlapSaveConvolver {
 private:
-  // `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`.
-  static std::mutex fftwMutex;
-
   static constexpr size_t nBuffer = 2;
 
   size_t half = 1;
@@ -100,7 +97,8 @@ private:
   float *flt; // filtered.
   float *coefficient;
 
-  std::array<fftwf_plan, nBuffer> forwardPlan;
+  // Plans are owned by `FFTWPlanCache`, and shared with other instances.
+  fftwf_plan forwardPlan;
   fftwf_plan inversePlan;
   fftwf_plan firPlan;
 
@@ -112,7 +110,7 @@ private:
 public:
   void init(size_t nTap, size_t delay = 0)
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    auto &fftw = FFTWPlanCache::instance();
 
     offset = delay;
 
@@ -120,43 +118,35 @@ public:
     bufSize = 2 * half;
     spcSize = nTap + 1;
 
-    for (size_t idx = 0; idx < nBuffer; ++idx) {
-      buf[idx] = (float *)fftwf_malloc(sizeof(float) * bufSize);
-    }
-    spc = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spcSize);
-    flt = (float *)fftwf_malloc(sizeof(float) * bufSize);
+    for (size_t idx = 0; idx < nBuffer; ++idx) buf[idx] = fftw.allocate<float>(bufSize);
+    spc = fftw.allocate<std::complex<float>>(spcSize);
+    flt = fftw.allocate<float>(bufSize);
 
-    coefficient = (float *)fftwf_malloc(sizeof(float) * bufSize);
+    coefficient = fftw.allocate<float>(bufSize);
     std::fill(coefficient, coefficient + bufSize, float(0));
 
-    fir = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spcSize);
+    fir = fftw.allocate<std::complex<float>>(spcSize);
     std::fill(fir, fir + spcSize, std::complex<float>(0, 0));
 
-    for (size_t idx = 0; idx < nBuffer; ++idx) {
-      forwardPlan[idx] = fftwf_plan_dft_r2c_1d(
-        int(bufSize), buf[idx], reinterpret_cast<fftwf_complex *>(spc), FFTW_ESTIMATE);
-    }
-    inversePlan = fftwf_plan_dft_c2r_1d(
-      int(bufSize), reinterpret_cast<fftwf_complex *>(spc), flt, FFTW_ESTIMATE);
-    firPlan = fftwf_plan_dft_r2c_1d(
-      int(bufSize), coefficient, reinterpret_cast<fftwf_complex *>(fir), FFTW_ESTIMATE);
+    forwardPlan = fftw.getR2C(int(bufSize), buf[0], spc);
+    inversePlan = fftw.getC2R(int(bufSize), spc, flt);
+    firPlan = fftw.getR2C(int(bufSize), coefficient, fir);
   }
 
   ~OverlapSaveConvolver()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &fp : forwardPlan) fftwf_destroy_plan(fp);
-    fftwf_destroy_plan(inversePlan);
-    fftwf_destroy_plan(firPlan);
-
-    for (auto &bf : buf) fftwf_free(bf);
-    fftwf_free(spc);
-    fftwf_free(fir);
-    fftwf_free(flt);
-    fftwf_free(coefficient);
+    auto &fftw = FFTWPlanCache::instance();
+    for (auto &bf : buf) fftw.free(bf);
+    fftw.free(spc);
+    fftw.free(fir);
+    fftw.free(flt);
+    fftw.free(coefficient);
   }
 
+  /**
+  Can be called from other thread while this instance isn't processing. Plans are shared
+  with other instances, but new-array execution of FFTW3 plans is thread safe.
+  */
   void setFir(std::vector<float> &source, size_t start, size_t end)
   {
     std::copy(source.begin() + start, source.begin() + end, coefficient);
@@ -164,7 +154,7 @@ public:
     // FFT scaling.
     for (size_t idx = 0; idx < half; ++idx) coefficient[idx] /= float(bufSize);
 
-    fftwf_execute(firPlan);
+    fftwExecute(firPlan, coefficient, fir);
   }
 
   void reset()
@@ -192,9 +182,11 @@ public:
     }
 
     if (wptr[front] == 0) {
-      fftwf_execute(forwardPlan[front]);
+      UHHYOU_TRACE_SCOPE("OverlapSaveConvolver::fft");
+
+      fftwExecute(forwardPlan, buf[front], spc);
       for (size_t i = 0; i < spcSize; ++i) spc[i] *= fir[i];
-      fftwf_execute(inversePlan);
+      fftwExecute(inversePlan, spc, flt);
 
       front ^= 1;
     }
@@ -247,14 +239,7 @@ public:
   void refreshFir(float sampleRate, float cutoffHz, bool isHighpass)
   {
     auto coefficient = getNuttallFir(nTap, sampleRate, cutoffHz, isHighpass);
-
-    // Set FIR coefficients.
-    firstConvolver.setFir(coefficient);
-    for (size_t idx = 0; idx < nFftConvolver; ++idx) {
-      fftConvolver[idx].setFir(
-        coefficient, size_t(1) << (minBlockSizeInPow2 + idx),
-        size_t(1) << (minBlockSizeInPow2 + idx + 1));
-    }
+    setFir(coefficient);
   }
 
   void setFir(std::vector<float> &source)
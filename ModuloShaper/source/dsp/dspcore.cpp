@@ -19,8 +19,13 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
+
+  for (auto &os : offlineOversampler) {
+    os.setup(1);
+    os.set(offlineFold, OversamplingQuality::fir);
+  }
 
   startup();
 }
@@ -29,7 +34,7 @@ void DSPCore::setup(double sampleRate)
   using ID = ParameterID::ID;                                                            \
   auto &pv = param.value;                                                                \
                                                                                          \
-  SmootherCommon<float>::setTime(pv[ID::smoothness]->getFloat());                        \
+  smootherContext.setTime(pv[ID::smoothness]->getFloat());                               \
                                                                                          \
   interpInputGain.METHOD(pv[ID::inputGain]->getFloat());                                 \
   interpClipGain.METHOD(pv[ID::clipGain]->getFloat());                                   \
@@ -52,6 +57,7 @@ void DSPCore::reset()
   ASSIGN_PARAMETER(reset);
 
   for (auto &shaper : shaperNaive) shaper.reset();
+  for (auto &os : offlineOversampler) os.reset();
   for (auto &shaper : shaperBlep) shaper.reset();
   for (auto &lp : lowpass) lp.reset();
   for (auto &lm : limiter) lm.reset();
@@ -63,7 +69,9 @@ void DSPCore::startup() {}
 size_t DSPCore::getLatency()
 {
   auto latency = activateLimiter ? limiter[0].latency() : 0;
-  if (shaperType == 1)
+  if (shaperType == 1 && isOffline)
+    return size_t(std::lround(offlineOversampler[0].latency())) + latency;
+  else if (shaperType == 1)
     return shaperNaive[0].latency() + latency;
   else if (shaperType == 2) // 4 point PolyBLEP residual.
     return 4 + latency;
@@ -88,7 +96,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   param.value[ParameterID::guiInputGain]->setFromFloat(
     std::max(maxAbs(length, in0), maxAbs(length, in1)));
@@ -125,12 +133,21 @@ void DSPCore::process(
         frame[1] = clipGain * shaperNaive[1].process(inGain * frame[1]);
         break;
 
-      case 1: // Naive 16x oversampling.
+      case 1: // Naive 16x oversampling. 64x in offline rendering.
         shaperNaive[0].add = add;
         shaperNaive[1].add = add;
         shaperNaive[0].mul = mul;
         shaperNaive[1].mul = mul;
 
+        if (isOffline) {
+          for (size_t ch = 0; ch < 2; ++ch) {
+            frame[ch] = clipGain
+              * offlineOversampler[ch].process(inGain * frame[ch], [&](float x) {
+                  return shaperNaive[ch].process(x);
+                });
+          }
+          break;
+        }
         frame[0] = clipGain * shaperNaive[0].process16x(inGain * frame[0]);
         frame[1] = clipGain * shaperNaive[1].process16x(inGain * frame[1]);
         break;
@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/constants.hpp"
 #include "../../../common/dsp/lightlimiter.hpp"
+#include "../../../common/dsp/multirate/oversampler.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 
@@ -18,6 +19,7 @@ using namespace Steinberg::Synth;
 class DSPCore {
 public:
   GlobalParameter param;
+  bool isOffline = false; // Set before `setup`. Uses `offlineOversampler` if true.
 
   void setup(double sampleRate);
   void reset();
@@ -29,9 +31,13 @@ public:
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float maxGain = 0.0f;
 
+  static constexpr size_t offlineFold = 64;
+
   std::array<ModuloShaper<float>, 2> shaperNaive;
+  std::array<Oversampler<float>, 2> offlineOversampler;
   std::array<ModuloShaperPolyBLEP<double>, 2> shaperBlep;
   std::array<Butter8Lowpass<float>, 2> lowpass;
   std::array<LightLimiter<float, 64>, 2> limiter;
@@ -39,10 +45,10 @@ private:
   size_t shaperType = 0; /* 0: naive, 1: oversample, 2: P-BLEP4, 3: P-BLEP8 */
   bool activateLowpass = true;
   bool activateLimiter = true;
-  ExpSmoother<float> interpInputGain;
-  ExpSmoother<float> interpClipGain;
-  ExpSmoother<float> interpOutputGain;
-  ExpSmoother<float> interpAdd;
-  ExpSmoother<float> interpMul;
-  ExpSmoother<float> interpCutoff;
+  ExpSmoother<float> interpInputGain{smootherContext};
+  ExpSmoother<float> interpClipGain{smootherContext};
+  ExpSmoother<float> interpOutputGain{smootherContext};
+  ExpSmoother<float> interpAdd{smootherContext};
+  ExpSmoother<float> interpMul{smootherContext};
+  ExpSmoother<float> interpCutoff{smootherContext};
 };
@@ -27,20 +27,31 @@ void DSPCore::setup(double sampleRate)
   pitchSmoothingKp = EMAFilter<double>::secondToP(upRate, double(0.01));
   phaseSyncKp = EMAFilter<double>::secondToP(upRate, double(1));
 
-  for (auto &ps : pitchShifter)
-    ps.setup(size_t(this->sampleRate * maxUpFold * maxDelayTime));
+  const auto maxFold = isOffline ? offlineFold : maxUpFold;
+  for (auto &ps : pitchShifter) {
+    ps.setup(size_t(this->sampleRate * maxFold * maxDelayTime));
+  }
+
+  for (auto &os : offlineOversampler) {
+    os.setup(1);
+    os.set(offlineFold, OversamplingQuality::fir);
+  }
 
   reset();
   startup();
 }
 
-size_t DSPCore::getLatency() { return 0; }
+size_t DSPCore::getLatency()
+{
+  return useOfflineOversampler() ? size_t(std::lround(offlineOversampler[0].latency()))
+                                 : 0;
+}
 
 #define ASSIGN_PARAMETER(METHOD)                                                         \
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   lfoPhaseOffset.METHOD(pv[ID::lfoPhaseOffset]->getDouble());                            \
   lfoPhaseConstant.METHOD(pv[ID::lfoPhaseConstant]->getDouble());                        \
@@ -66,9 +77,10 @@ size_t DSPCore::getLatency() { return 0; }
 void DSPCore::updateUpRate()
 {
   constexpr std::array<size_t, 3> fold{1, 2, 8};
-  upRate = double(sampleRate) * fold[oversampling];
+  const auto activeFold = useOfflineOversampler() ? offlineFold : fold[oversampling];
+  upRate = double(sampleRate) * activeFold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
 }
@@ -93,6 +105,7 @@ void DSPCore::reset()
   for (auto &x : pitchShifter) x.reset();
   for (auto &x : decimationLowpass) x.reset();
   for (auto &x : halfbandIir) x.reset();
+  for (auto &x : offlineOversampler) x.reset();
 
   startup();
 }
@@ -183,7 +196,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -194,6 +207,24 @@ void DSPCore::process(
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
 
+    if (useOfflineOversampler()) {
+      const double x0 = in0[i];
+      const double x1 = in1[i];
+      auto up0 = offlineOversampler[0].up(&x0, 1);
+      auto up1 = offlineOversampler[1].up(&x1, 1);
+      for (size_t j = 0; j < offlineFold; ++j) {
+        auto frame = processFrame(up0[j], up1[j]);
+        up0[j] = frame[0];
+        up1[j] = frame[1];
+      }
+      double y0, y1;
+      offlineOversampler[0].down(&y0, 1);
+      offlineOversampler[1].down(&y1, 1);
+      out0[i] = float(y0);
+      out1[i] = float(y1);
+      continue;
+    }
+
     upSampler[0].process(in0[i]);
     upSampler[1].process(in1[i]);
 
@@ -4,8 +4,10 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/lfo.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/multirate/oversampler.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "filter.hpp"
@@ -23,13 +25,10 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
+  bool isOffline = false; // Set before `setup`. Uses `offlineOversampler` if true.
   bool isPlaying = false;
   float tempo = 120.0f;
   double beatsElapsed = 0.0f;
@@ -60,21 +59,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -84,33 +79,37 @@ private:
   double getTempoSyncInterval();
   double calcNotePitch(double note, double equalTemperament = 12);
 
+  bool useOfflineOversampler() const { return isOffline && oversampling != 0; }
+
   static constexpr size_t maxUpFold = 8;
+  static constexpr size_t offlineFold = 16;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = maxUpFold * 44100;
 
   double phaseSyncKp = 1;
   double pitchSmoothingKp = 1;
   ExpSmootherLocal<double> notePitch;
 
-  RotarySmoother<double> lfoPhaseConstant;
-  RotarySmoother<double> lfoPhaseOffset;
-
-  ExpSmoother<double> lfoShapeClip;
-  ExpSmoother<double> lfoShapeSkew;
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> dryGain;
-  ExpSmoother<double> wetGain;
-  ExpSmoother<double> feedback;
-  ExpSmoother<double> delayTimeSamples;
-  ExpSmoother<double> shiftPitch;
-  ExpSmoother<double> shiftFreq;
-  ExpSmoother<double> lfoToPrimaryDelayTime;
-  ExpSmoother<double> lfoToPrimaryShiftPitch;
-  ExpSmoother<double> lfoToPrimaryShiftHz;
+  RotarySmoother<double> lfoPhaseConstant{smootherContext};
+  RotarySmoother<double> lfoPhaseOffset{smootherContext};
+
+  ExpSmoother<double> lfoShapeClip{smootherContext};
+  ExpSmoother<double> lfoShapeSkew{smootherContext};
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> dryGain{smootherContext};
+  ExpSmoother<double> wetGain{smootherContext};
+  ExpSmoother<double> feedback{smootherContext};
+  ExpSmoother<double> delayTimeSamples{smootherContext};
+  ExpSmoother<double> shiftPitch{smootherContext};
+  ExpSmoother<double> shiftFreq{smootherContext};
+  ExpSmoother<double> lfoToPrimaryDelayTime{smootherContext};
+  ExpSmoother<double> lfoToPrimaryShiftPitch{smootherContext};
+  ExpSmoother<double> lfoToPrimaryShiftHz{smootherContext};
 
   size_t oversampling = 2;
 
@@ -118,10 +117,13 @@ private:
 
   std::array<double, 2> feedbackBuffer{};
   std::array<CubicUpSampler<double, maxUpFold>, 2> upSampler;
-  std::array<SVF<double>, 2> feedbackHighpass;
-  std::array<SVF<double>, 2> feedbackLowpass;
+  std::array<SVF<double>, 2> feedbackHighpass
+    = makeSmootherArray<SVF<double>, 2>(smootherContext);
+  std::array<SVF<double>, 2> feedbackLowpass
+    = makeSmootherArray<SVF<double>, 2>(smootherContext);
   std::array<AMFrequencyShifter<double>, 2> frequencyShifter;
   std::array<PitchShiftDelay<double>, 2> pitchShifter;
   std::array<DecimationLowpass<double, Sos8FoldFirstStage<double>>, 2> decimationLowpass;
   std::array<HalfBandIIR<double, HalfBandCoefficient<double>>, 2> halfbandIir;
+  std::array<Oversampler<double>, 2> offlineOversampler;
 };
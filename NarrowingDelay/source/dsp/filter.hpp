@@ -98,6 +98,8 @@ private:
   ExpSmoother<Sample> k;
 
 public:
+  explicit SVF(const SmootherContext<Sample> &context) : g(context), k(context) {}
+
   void pushCutoff(Sample normalizedFreq, Sample Q)
   {
     g.push(std::tan(std::clamp(normalizedFreq, minCutoff, nyquist) * Sample(pi)));
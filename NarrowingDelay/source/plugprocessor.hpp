@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -34,6 +36,8 @@ public:
   tresult PLUGIN_API setState(IBStream *state) SMTG_OVERRIDE;
   tresult PLUGIN_API getState(IBStream *state) SMTG_OVERRIDE;
 
+  uint32 PLUGIN_API getLatencySamples() SMTG_OVERRIDE;
+
   static FUnknown *createInstance(void *)
   {
     return (Vst::IAudioProcessor *)new PlugProcessor();
@@ -42,7 +46,7 @@ public:
   void processBypass(Vst::ProcessData &data);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
@@ -50,6 +54,7 @@ protected:
   }
 
   uint64_t lastState = 0;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
@@ -29,6 +29,7 @@ public:
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float maxGain = 0.0f;
 
   std::array<OddPowShaper<float>, 2> shaper;
@@ -36,6 +37,6 @@ private:
 
   bool oversample = true;
   bool activateLimiter = true;
-  ExpSmoother<float> interpDrive;
-  ExpSmoother<float> interpOutputGain;
+  ExpSmoother<float> interpDrive{smootherContext};
+  ExpSmoother<float> interpOutputGain{smootherContext};
 };
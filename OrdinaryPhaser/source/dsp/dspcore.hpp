@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/lfo.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
@@ -23,11 +24,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   bool isPlaying = false;
@@ -60,21 +57,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -86,10 +79,11 @@ private:
 
   static constexpr size_t upFold = 2;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100;
 
   double pitchSmoothingKp = 1;
@@ -99,19 +93,19 @@ private:
   DoubleEMAFilter<double> notePitchToDelayTimeRelease;
   DoubleEMAFilter<double> notePitchToAllpassCutoffRelease;
 
-  RotarySmoother<double> lfoPhaseConstant;
-  RotarySmoother<double> lfoPhaseOffset;
-
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> mix;
-  ExpSmoother<double> cutoffSpread;
-  ExpSmoother<double> cutoffMinHz;
-  ExpSmoother<double> cutoffMaxHz;
-  ExpSmoother<double> feedback;
-  ExpSmoother<double> delayTimeSamples;
-  ExpSmoother<double> lfoToDelay;
-  ExpSmoother<double> inputToFeedbackGain;
-  ExpSmoother<double> inputToDelayTime;
+  RotarySmoother<double> lfoPhaseConstant{smootherContext};
+  RotarySmoother<double> lfoPhaseOffset{smootherContext};
+
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> mix{smootherContext};
+  ExpSmoother<double> cutoffSpread{smootherContext};
+  ExpSmoother<double> cutoffMinHz{smootherContext};
+  ExpSmoother<double> cutoffMaxHz{smootherContext};
+  ExpSmoother<double> feedback{smootherContext};
+  ExpSmoother<double> delayTimeSamples{smootherContext};
+  ExpSmoother<double> lfoToDelay{smootherContext};
+  ExpSmoother<double> inputToFeedbackGain{smootherContext};
+  ExpSmoother<double> inputToDelayTime{smootherContext};
 
   bool oversampling = true;
   size_t lfoToDelayTuningType = 0;
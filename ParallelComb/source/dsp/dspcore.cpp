@@ -24,8 +24,8 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = float(sampleRate);
   auto maxRate = float(sampleRate) * OverSampler::fold;
 
-  SmootherCommon<float>::setSampleRate(maxRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(maxRate);
+  smootherContext.setTime(0.2f);
 
   gate.setup(sampleRate, 0.001f);
 
@@ -168,8 +168,8 @@ void DSPCore::process(
   float upfold = overSampling ? OverSampler::fold : float(1);
   float upRate = upfold * sampleRate;
 
-  SmootherCommon<float>::setBufferSize(float(length));
-  SmootherCommon<float>::setSampleRate(upRate);
+  smootherContext.setBufferSize(float(length));
+  smootherContext.setSampleRate(upRate);
 
   bool enableMidSide = pv[ID::channelType]->getInt();
 
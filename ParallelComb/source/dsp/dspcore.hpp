@@ -5,6 +5,7 @@
 
 #include "../../../common/dsp/basiclimiter.hpp"
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -28,11 +29,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
 
@@ -60,21 +57,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -82,22 +75,23 @@ private:
   std::array<float, 2> processInternal(float ch0, float ch1);
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   std::array<float, 2> delayOut{};
 
-  ExpSmoother<float> interpCombInterpRate;
-  ExpSmoother<float> interpCombInterpCutoffKp;
-  ExpSmoother<float> interpFeedback;
-  ExpSmoother<float> interpFeedbackHighpassCutoffKp;
-  ExpSmoother<float> interpStereoCross;
-  ExpSmoother<float> interpFeedbackToDelayTime;
-  ExpSmoother<float> interpGateReleaseKp;
-  ExpSmoother<float> interpDry;
-  ExpSmoother<float> interpWet;
+  ExpSmoother<float> interpCombInterpRate{smootherContext};
+  ExpSmoother<float> interpCombInterpCutoffKp{smootherContext};
+  ExpSmoother<float> interpFeedback{smootherContext};
+  ExpSmoother<float> interpFeedbackHighpassCutoffKp{smootherContext};
+  ExpSmoother<float> interpStereoCross{smootherContext};
+  ExpSmoother<float> interpFeedbackToDelayTime{smootherContext};
+  ExpSmoother<float> interpGateReleaseKp{smootherContext};
+  ExpSmoother<float> interpDry{smootherContext};
+  ExpSmoother<float> interpWet{smootherContext};
 
   std::array<OverSampler, 2> overSampler;
   EasyGate<float> gate;
@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -42,7 +44,7 @@ public:
   void processBypass(Vst::ProcessData &data);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   inline int32 toDiscrete(Vst::ParamValue normalized, int32 stepCount)
   {
@@ -51,6 +53,7 @@ protected:
 
   uint64_t lastState = 0;
   uint32_t wasBypassing = 0;
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
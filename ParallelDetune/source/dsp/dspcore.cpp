@@ -31,7 +31,7 @@ void DSPCore::setup(double sampleRate)
 
   for (auto &ps : pitchShifter) ps.setup(size_t(upRate * maxDelayTime));
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   synchronizer.reset(upRate, defaultTempo, double(1));
   lfo.setup(upRate, double(0.1));
@@ -46,7 +46,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
@@ -113,7 +113,10 @@ void DSPCore::reset()
 
 void DSPCore::startup() { synchronizer.reset(upRate, tempo, getTempoSyncInterval()); }
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+}
 
 std::array<double, 2> DSPCore::processFrame(double in0, double in1)
 {
@@ -225,7 +228,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/lfo.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
@@ -54,21 +55,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -79,36 +76,37 @@ private:
 
   static constexpr size_t upFold = 2;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100;
 
   double phaseSyncKp = 1;
   double pitchSmoothingKp = 1;
   ExpSmootherLocal<double> notePitch;
 
-  RotarySmoother<double> lfoPhaseConstant;
-  RotarySmoother<double> lfoPhaseOffset;
-
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> dryGain;
-  ExpSmoother<double> wetGain;
-  ExpSmoother<double> panSpread;
-  ExpSmoother<double> lfoToPan;
-  ExpSmoother<double> tremoloMix;
-  ExpSmoother<double> tremoloLean;
-  ExpSmoother<double> feed;
-  ExpSmoother<double> lfoToDelayTime;
-  ExpSmoother<double> lfoToShiftPitch;
-
-  ParallelExpSmoother<double, nShifter> shiftPitch;
-  ParallelExpSmoother<double, nShifter> delayTimeSamples;
-  ParallelExpSmoother<double, nShifter> shifterGain;
-
-  ParallelExpSmoother<double, nShifter> highpassG;
-  ParallelExpSmoother<double, nShifter> lowpassG;
+  RotarySmoother<double> lfoPhaseConstant{smootherContext};
+  RotarySmoother<double> lfoPhaseOffset{smootherContext};
+
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> dryGain{smootherContext};
+  ExpSmoother<double> wetGain{smootherContext};
+  ExpSmoother<double> panSpread{smootherContext};
+  ExpSmoother<double> lfoToPan{smootherContext};
+  ExpSmoother<double> tremoloMix{smootherContext};
+  ExpSmoother<double> tremoloLean{smootherContext};
+  ExpSmoother<double> feed{smootherContext};
+  ExpSmoother<double> lfoToDelayTime{smootherContext};
+  ExpSmoother<double> lfoToShiftPitch{smootherContext};
+
+  ParallelExpSmoother<double, nShifter> shiftPitch{smootherContext};
+  ParallelExpSmoother<double, nShifter> delayTimeSamples{smootherContext};
+  ParallelExpSmoother<double, nShifter> shifterGain{smootherContext};
+
+  ParallelExpSmoother<double, nShifter> highpassG{smootherContext};
+  ParallelExpSmoother<double, nShifter> lowpassG{smootherContext};
 
   LinearTempoSynchronizer<double, 32768> synchronizer;
   TableLFO<double, nLfoWavetable, 2048, 2> lfo;
@@ -39,8 +39,8 @@ void DSPCore::setup(double sampleRate)
 
   phaseSyncCutoffKp = float(EMAFilter<double>::cutoffToP(sampleRate, 0.1));
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate * OverSampler::fold);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate * OverSampler::fold);
+  smootherContext.setTime(0.2f);
 
   synchronizer.reset(this->sampleRate * OverSampler::fold, defaultTempo, 1.0f);
   lfo.setup(this->sampleRate * OverSampler::fold, 0.02f * OverSampler::fold);
@@ -59,7 +59,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<float>::setTime(pv[ID::smoothingTime]->getFloat());                     \
+  smootherContext.setTime(pv[ID::smoothingTime]->getFloat());                            \
                                                                                          \
   lfo.interpType = pv[ID::lfoInterpolation]->getInt();                                   \
   for (size_t idx = 0; idx < nLfoWavetable; ++idx) {                                     \
@@ -118,7 +118,10 @@ void DSPCore::startup()
   synchronizer.reset(sampleRate * OverSampler::fold, tempo, getTempoSyncInterval());
 }
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+}
 
 inline void convertToMidSide(float &left, float &right)
 {
@@ -150,7 +153,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -27,11 +28,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   bool isPlaying = false;
@@ -62,21 +59,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -84,28 +77,29 @@ private:
   float getTempoSyncInterval();
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   float notePitchMultiplier = float(1);
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float phaseSyncCutoffKp = 1e-5f;
 
-  ExpSmoother<float> interpPitchMain;
-  ExpSmoother<float> interpPitchUnison;
-  ExpSmoother<float> interpLfoStereoOffset;
-  ExpSmoother<float> interpLfoUnisonOffset;
-  ExpSmoother<float> interpLfoToPitch;
-  ExpSmoother<float> interpLfoToUnison;
-  ExpSmoother<float> interpDelayTime;
-  ExpSmoother<float> interpStereoLean;
-  ExpSmoother<float> interpFeedback;
-  ExpSmoother<float> interpHighpassCutoffKp;
-  ExpSmoother<float> interpPitchCross;
-  ExpSmoother<float> interpStereoCross;
-  ExpSmoother<float> interpUnisonMix;
-  ExpSmoother<float> interpDry;
-  ExpSmoother<float> interpWet;
+  ExpSmoother<float> interpPitchMain{smootherContext};
+  ExpSmoother<float> interpPitchUnison{smootherContext};
+  ExpSmoother<float> interpLfoStereoOffset{smootherContext};
+  ExpSmoother<float> interpLfoUnisonOffset{smootherContext};
+  ExpSmoother<float> interpLfoToPitch{smootherContext};
+  ExpSmoother<float> interpLfoToUnison{smootherContext};
+  ExpSmoother<float> interpDelayTime{smootherContext};
+  ExpSmoother<float> interpStereoLean{smootherContext};
+  ExpSmoother<float> interpFeedback{smootherContext};
+  ExpSmoother<float> interpHighpassCutoffKp{smootherContext};
+  ExpSmoother<float> interpPitchCross{smootherContext};
+  ExpSmoother<float> interpStereoCross{smootherContext};
+  ExpSmoother<float> interpUnisonMix{smootherContext};
+  ExpSmoother<float> interpDry{smootherContext};
+  ExpSmoother<float> interpWet{smootherContext};
 
   LightTempoSynchronizer<float> synchronizer;
   TableLFO<float, nLfoWavetable, 2048, 4> lfo;
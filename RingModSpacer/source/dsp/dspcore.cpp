@@ -47,7 +47,7 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = double(sampleRate);
 
-  SmootherCommon<double>::setSampleRate(sampleRate);
+  smootherContext.setSampleRate(sampleRate);
 
   size_t bufferSize = size_t(sampleRate * maxLimiterAttackSeconds) + 1;
   for (auto &x : delay) x.resize(bufferSize);
@@ -66,7 +66,7 @@ size_t DSPCore::getLatency()
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   outputGain.METHOD(pv[ID::outputGain]->getDouble());                                    \
   sideMix.METHOD(pv[ID::sideMix]->getDouble());                                          \
@@ -110,7 +110,10 @@ void DSPCore::reset()
 
 void DSPCore::startup() {}
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+}
 
 std::array<double, 2> DSPCore::processFrame(const std::array<double, 4> &frame)
 {
@@ -155,7 +158,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
     auto frame = processFrame({in0[i], in1[i], in2[i], in3[i]});
@@ -36,12 +36,13 @@ private:
   std::array<double, 2> processFrame(const std::array<double, 4> &frame);
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
 
-  ExpSmoother<double> outputGain;
-  ExpSmoother<double> sideMix;
-  ExpSmoother<double> ringSubtractMix;
-  ExpSmoother<double> inputGain;
-  ExpSmoother<double> sideGain;
+  ExpSmoother<double> outputGain{smootherContext};
+  ExpSmoother<double> sideMix{smootherContext};
+  ExpSmoother<double> ringSubtractMix{smootherContext};
+  ExpSmoother<double> inputGain{smootherContext};
+  ExpSmoother<double> sideGain{smootherContext};
 
   std::array<IntDelay<double>, 4> delay;
   std::array<BasicLimiter<double>, 4> limiter;
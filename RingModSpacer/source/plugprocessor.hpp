@@ -10,6 +10,8 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -49,6 +51,7 @@ protected:
     return int32(std::min<double>(stepCount, normalized * (stepCount + 1.0)));
   }
 
+  ProcessDriver processDriver;
   DSPCore dsp;
 };
 
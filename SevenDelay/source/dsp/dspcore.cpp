@@ -35,7 +35,8 @@ template<typename T> inline T calcNotePitch(T note)
 
 void DSPCore::setup(double sampleRate)
 {
-  SmootherCommon<double>::setSampleRate(double(sampleRate));
+  this->sampleRate = sampleRate;
+  smootherContext.setSampleRate(double(sampleRate));
 
   for (size_t i = 0; i < delay.size(); ++i)
     delay[i].setup(double(sampleRate), double(1), maxDelayTime);
@@ -71,9 +72,27 @@ void DSPCore::startup()
   lfoPhase = param.value[ParameterID::lfoInitialPhase]->getDouble();
 }
 
+size_t DSPCore::getTailLength()
+{
+  using ID = ParameterID::ID;
+  const auto &pv = param.value;
+
+  // Same as `setParameters()`. LFO lengthens the delay time up to 2 * lfoTimeAmount.
+  auto time = pv[ID::time]->getDouble() * notePitchMultiplier;
+  if (pv[ID::tempoSync]->getInt()) {
+    if (time < double(1))
+      time *= double(15) / double(tempo);
+    else
+      time = std::floor(double(2) * time) * double(7.5) / double(tempo);
+  }
+  time = std::min(time + double(2) * pv[ID::lfoTimeAmount]->getDouble(), maxDelayTime);
+
+  return feedbackTailLength(sampleRate * time, pv[ID::feedback]->getDouble());
+}
+
 void DSPCore::setParameters()
 {
-  SmootherCommon<double>::setTime(param.value[ParameterID::smoothness]->getDouble());
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getDouble());
 
   // This won't work if sync is on and tempo < 15. Up to 8 sec or 8/16 beat.
   // 15.0 comes from (60 sec per minute) * (4 beat) / (16 beat).
@@ -120,7 +139,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   const bool lfoHold = !param.value[ParameterID::lfoHold]->getInt();
   for (size_t i = 0; i < length; ++i) {
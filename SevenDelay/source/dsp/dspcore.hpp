@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "../../../common/dsp/eventqueue.hpp"
+#include "../../../common/dsp/silence.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "delay.hpp"
@@ -28,11 +30,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
   double tempo = 120.0f; // tempo is beat per minutes.
@@ -40,6 +38,7 @@ public:
   void setup(double sampleRate);
   void reset();   // Stop sounds.
   void startup(); // Reset phase, random seed etc.
+  size_t getTailLength();
   void setParameters();
 
   void process(
@@ -62,48 +61,47 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 protected:
   void updateDelayTime();
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
   double notePitchMultiplier = double(1);
 
-  std::array<LinearSmoother<double>, 2> interpTime{};
-  LinearSmoother<double> interpWetMix;
-  LinearSmoother<double> interpDryMix;
-  LinearSmoother<double> interpFeedback;
-  LinearSmoother<double> interpLfoTimeAmount;
-  LinearSmoother<double> interpLfoToneAmount;
-  LinearSmoother<double> interpLfoFrequency;
-  LinearSmoother<double> interpLfoShape;
-  LinearSmoother<double> interpPanIn;
-  LinearSmoother<double> interpSpreadIn;
-  LinearSmoother<double> interpPanOut;
-  LinearSmoother<double> interpSpreadOut;
-  LinearSmoother<double> interpToneCutoff;
-  LinearSmoother<double> interpToneQ;
-  LinearSmoother<double> interpToneMix;
-  LinearSmoother<double> interpDCKill;
-  LinearSmoother<double> interpDCKillMix;
+  double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
+  std::array<LinearSmoother<double>, 2> interpTime
+    = makeSmootherArray<LinearSmoother<double>, 2>(smootherContext);
+  LinearSmoother<double> interpWetMix{smootherContext};
+  LinearSmoother<double> interpDryMix{smootherContext};
+  LinearSmoother<double> interpFeedback{smootherContext};
+  LinearSmoother<double> interpLfoTimeAmount{smootherContext};
+  LinearSmoother<double> interpLfoToneAmount{smootherContext};
+  LinearSmoother<double> interpLfoFrequency{smootherContext};
+  LinearSmoother<double> interpLfoShape{smootherContext};
+  LinearSmoother<double> interpPanIn{smootherContext};
+  LinearSmoother<double> interpSpreadIn{smootherContext};
+  LinearSmoother<double> interpPanOut{smootherContext};
+  LinearSmoother<double> interpSpreadOut{smootherContext};
+  LinearSmoother<double> interpToneCutoff{smootherContext};
+  LinearSmoother<double> interpToneQ{smootherContext};
+  LinearSmoother<double> interpToneMix{smootherContext};
+  LinearSmoother<double> interpDCKill{smootherContext};
+  LinearSmoother<double> interpDCKillMix{smootherContext};
 
   double lfoPhase;
   double lfoPhaseTick;
@@ -10,6 +10,9 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
+#include "../../common/processdriver.hpp"
+#include "../../common/silencedetector.hpp"
+
 #include "dsp/dspcore.hpp"
 
 namespace Steinberg {
@@ -29,6 +32,7 @@ public:
 
   tresult PLUGIN_API setupProcessing(Vst::ProcessSetup &setup) SMTG_OVERRIDE;
   tresult PLUGIN_API setActive(TBool state) SMTG_OVERRIDE;
+  uint32 PLUGIN_API getTailSamples() SMTG_OVERRIDE;
   tresult PLUGIN_API process(Vst::ProcessData &data) SMTG_OVERRIDE;
 
   tresult PLUGIN_API setState(IBStream *state) SMTG_OVERRIDE;
@@ -42,11 +46,13 @@ public:
   void processBypass(Vst::ProcessData &data);
 
 protected:
-  void handleEvent(Vst::ProcessData &data);
+  void handleEvent(Vst::Event &event);
 
   uint32_t lastState = 0;
   uint32_t wasBypassing = 0;
   float tempo = 120.0f;
+  ProcessDriver processDriver;
+  SilenceDetector silenceDetector;
   DSPCore dsp;
 };
 
@@ -19,8 +19,8 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   startup();
 }
@@ -30,7 +30,7 @@ void DSPCore::setup(double sampleRate)
                                                                                          \
   using ID = ParameterID::ID;                                                            \
                                                                                          \
-  SmootherCommon<float>::setTime(param.value[ID::smoothness]->getFloat());               \
+  smootherContext.setTime(param.value[ID::smoothness]->getFloat());                      \
                                                                                          \
   interpInputGain.METHOD(param.value[ID::inputGain]->getFloat());                        \
   interpOutputGain.METHOD(param.value[ID::outputGain]->getFloat());                      \
@@ -62,7 +62,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   param.value[ParameterID::guiInputGain]->setFromFloat(
     std::max(maxAbs(length, in0), maxAbs(length, in1)));
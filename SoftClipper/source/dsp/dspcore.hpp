@@ -28,15 +28,16 @@ public:
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float maxGain = 0.0f;
 
   std::array<SoftClipper<float>, 2> shaper;
 
   bool oversample = true;
-  ExpSmoother<float> interpInputGain;
-  ExpSmoother<float> interpOutputGain;
-  ExpSmoother<float> interpClip;
-  ExpSmoother<float> interpOrder;
-  ExpSmoother<float> interpRatio;
-  ExpSmoother<float> interpSlope;
+  ExpSmoother<float> interpInputGain{smootherContext};
+  ExpSmoother<float> interpOutputGain{smootherContext};
+  ExpSmoother<float> interpClip{smootherContext};
+  ExpSmoother<float> interpOrder{smootherContext};
+  ExpSmoother<float> interpRatio{smootherContext};
+  ExpSmoother<float> interpSlope{smootherContext};
 };
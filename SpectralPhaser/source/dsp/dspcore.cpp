@@ -15,7 +15,7 @@ void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = Sample(sampleRate);
 
-  SmootherCommon<Sample>::setSampleRate(sampleRate);
+  smootherContext.setSampleRate(sampleRate);
 
   lfoSyncRate = EMAFilter<double>::secondToP(sampleRate, Sample(0.013));
 
@@ -29,7 +29,7 @@ size_t DSPCore::getLatency() { return spcParam.reportLatency ? spcParam.frmSize
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<Sample>::setTime(pv[ID::parameterSmoothingSecond]->getFloat());         \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getFloat());                 \
                                                                                          \
   spcParam.sideChain = pv[ID::sideChainSwitch]->getInt();                                \
   spcParam.reportLatency = pv[ID::reportLatency]->getInt();                              \
@@ -85,7 +85,10 @@ void DSPCore::reset()
 
 void DSPCore::startup() {}
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+}
 
 // Output range is in [0, 1].
 inline Sample phaseToWave(Sample phase, Sample mod, LfoWaveform waveform)
@@ -194,7 +197,7 @@ void DSPCore::process(
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<Sample>::setBufferSize(Sample(length));
+  smootherContext.setBufferSize(Sample(length));
   lfoTargetFreq = getTempoSyncFrequency();
 
   for (int i = 0; i < length; ++i) {
@@ -45,30 +45,31 @@ private:
   Sample getTempoSyncFrequency();
 
   Sample sampleRate = 44100;
+  SmootherContext<Sample> smootherContext;
   TransformType previousTransform = TransformType::fft;
   LfoWaveform lfoWaveform = LfoWaveform::sine;
 
-  ExpSmoother<Sample> lfoWaveMod;
-  ExpSmoother<Sample> lfoRate;
-  RotarySmoother<Sample> lfoStereoPhaseOffset;
-  RotarySmoother<Sample> lfoInitialPhase;
-  ExpSmoother<Sample> feedback;
-  ExpSmoother<Sample> spectralShift;
-  ExpSmoother<Sample> maskMix;
-  ExpSmoother<Sample> maskPhase;
-  RotarySmoother<Sample> maskFreq;
-  ExpSmoother<Sample> maskChirp;
-  ExpSmoother<Sample> maskThreshold;
-  ExpSmoother<Sample> maskRotation;
-  ExpSmoother<Sample> lfoToSpectralShift;
-  ExpSmoother<Sample> lfoToMaskMix;
-  ExpSmoother<Sample> lfoToMaskPhase;
-  ExpSmoother<Sample> lfoToMaskFreq;
-  ExpSmoother<Sample> lfoToMaskChirp;
-  ExpSmoother<Sample> lfoToMaskThreshold;
-  ExpSmoother<Sample> lfoToMaskRotation;
-  ExpSmoother<Sample> outputGain;
-  ExpSmoother<Sample> dryWetMix;
+  ExpSmoother<Sample> lfoWaveMod{smootherContext};
+  ExpSmoother<Sample> lfoRate{smootherContext};
+  RotarySmoother<Sample> lfoStereoPhaseOffset{smootherContext};
+  RotarySmoother<Sample> lfoInitialPhase{smootherContext};
+  ExpSmoother<Sample> feedback{smootherContext};
+  ExpSmoother<Sample> spectralShift{smootherContext};
+  ExpSmoother<Sample> maskMix{smootherContext};
+  ExpSmoother<Sample> maskPhase{smootherContext};
+  RotarySmoother<Sample> maskFreq{smootherContext};
+  ExpSmoother<Sample> maskChirp{smootherContext};
+  ExpSmoother<Sample> maskThreshold{smootherContext};
+  ExpSmoother<Sample> maskRotation{smootherContext};
+  ExpSmoother<Sample> lfoToSpectralShift{smootherContext};
+  ExpSmoother<Sample> lfoToMaskMix{smootherContext};
+  ExpSmoother<Sample> lfoToMaskPhase{smootherContext};
+  ExpSmoother<Sample> lfoToMaskFreq{smootherContext};
+  ExpSmoother<Sample> lfoToMaskChirp{smootherContext};
+  ExpSmoother<Sample> lfoToMaskThreshold{smootherContext};
+  ExpSmoother<Sample> lfoToMaskRotation{smootherContext};
+  ExpSmoother<Sample> outputGain{smootherContext};
+  ExpSmoother<Sample> dryWetMix{smootherContext};
 
   Sample lfoTargetFreq = 0;
   Sample lfoSyncRate = Sample(0.0078125);
@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include "../../../lib/fftw3/fftw3.h"
+#include "../../../common/dsp/fft/fftw.hpp"
 #include "../parameter.hpp"
 #include "spectralmask.hpp"
 
@@ -12,16 +12,11 @@
 #include <cmath>
 #include <complex>
 #include <limits>
-#include <mutex>
 #include <numbers>
 #include <numeric>
 
 namespace SomeDSP {
 
-// `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`. In other words, FFTW3
-// isn't thread safe except `fftw*_execute` call.
-extern std::mutex fftwMutex;
-
 // Fast Walsh-Hadamard transform. In-place.
 template<typename T> void fwht(int N, T *seq, bool inverse = false)
 {
@@ -139,20 +134,18 @@ template<int maxFrameSizeLog2> struct SideChainMask {
 
   static constexpr int planIndexOffset = 2; // Starts from 2^2.
   static constexpr int nPlan = maxFrameSizeLog2 - planIndexOffset + 1;
-  std::array<fftwf_plan, nPlan> forwardPlan;
+  std::array<fftwf_plan, nPlan> forwardPlan; // Owned by `FFTWPlanCache`.
 
   SideChainMask()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    auto &fftw = FFTWPlanCache::instance();
 
-    bufW = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    bufMask = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    spcMask = (std::complex<float> *)fftwf_malloc(
-      sizeof(std::complex<float>) * maxSpectrumSize);
+    bufW = fftw.allocate<float>(maxFrameSize);
+    bufMask = fftw.allocate<float>(maxFrameSize);
+    spcMask = fftw.allocate<std::complex<float>>(maxSpectrumSize);
     for (int idx = 0; idx < nPlan; ++idx) {
-      const auto spc_ = reinterpret_cast<fftwf_complex *>(spcMask);
       const int length = int(1) << (idx + 2);
-      forwardPlan[idx] = fftwf_plan_dft_r2c_1d(length, bufW, spc_, FFTW_ESTIMATE);
+      forwardPlan[idx] = fftw.getR2C(length, bufW, spcMask);
     }
 
     reset();
@@ -160,12 +153,10 @@ template<int maxFrameSizeLog2> struct SideChainMask {
 
   ~SideChainMask()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &x : forwardPlan) fftwf_destroy_plan(x);
-    if (spcMask) fftwf_free(spcMask);
-    if (bufMask) fftwf_free(bufMask);
-    if (bufW) fftwf_free(bufW);
+    auto &fftw = FFTWPlanCache::instance();
+    fftw.free(spcMask);
+    fftw.free(bufMask);
+    fftw.free(bufW);
   }
 
   void reset(int indexOffset = 0)
@@ -176,7 +167,10 @@ template<int maxFrameSizeLog2> struct SideChainMask {
   }
 
   void push(float input, const int bufIndex) { bufW[bufIndex] = input; }
-  void processFft(const int planIndex) { fftwf_execute(forwardPlan[planIndex]); }
+  void processFft(const int planIndex)
+  {
+    fftwExecute(forwardPlan[planIndex], bufW, spcMask);
+  }
   void processFwht(const int size) { fwht(size, bufW, bufMask, false); }
   void processHaar(const int size) { haarTransformForward(size, bufW, bufMask); }
 };
@@ -199,28 +193,26 @@ public:
 
   static constexpr int planIndexOffset = 2; // Starts from 2^2.
   static constexpr int nPlan = maxFrameSizeLog2 - planIndexOffset + 1;
-  std::array<fftwf_plan, nPlan> forwardPlan;
-  std::array<fftwf_plan, nPlan> inversePlan;
+  std::array<fftwf_plan, nPlan> forwardPlan; // Owned by `FFTWPlanCache`.
+  std::array<fftwf_plan, nPlan> inversePlan; // Owned by `FFTWPlanCache`.
 
   SideChainMask<maxFrameSizeLog2> side;
 
   SpectralDelay()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    auto &fftw = FFTWPlanCache::instance();
 
-    bufW = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    bufR = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
-    bufTmp = (float *)fftwf_malloc(sizeof(float) * maxFrameSize);
+    bufW = fftw.allocate<float>(maxFrameSize);
+    bufR = fftw.allocate<float>(maxFrameSize);
+    bufTmp = fftw.allocate<float>(maxFrameSize);
 
-    constexpr int spcAllocSize = sizeof(std::complex<float>) * maxSpectrumSize;
-    spcSrc = (std::complex<float> *)fftwf_malloc(spcAllocSize);
-    spcTmp = (std::complex<float> *)fftwf_malloc(spcAllocSize);
+    spcSrc = fftw.allocate<std::complex<float>>(maxSpectrumSize);
+    spcTmp = fftw.allocate<std::complex<float>>(maxSpectrumSize);
 
     for (int idx = 0; idx < nPlan; ++idx) {
-      const auto spc_ = reinterpret_cast<fftwf_complex *>(spcSrc);
       const int length = int(1) << (idx + 2);
-      forwardPlan[idx] = fftwf_plan_dft_r2c_1d(length, bufW, spc_, FFTW_ESTIMATE);
-      inversePlan[idx] = fftwf_plan_dft_c2r_1d(length, spc_, bufR, FFTW_ESTIMATE);
+      forwardPlan[idx] = fftw.getR2C(length, bufW, spcSrc);
+      inversePlan[idx] = fftw.getC2R(length, spcSrc, bufR);
     }
 
     reset();
@@ -228,17 +220,14 @@ public:
 
   ~SpectralDelay()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &x : inversePlan) fftwf_destroy_plan(x);
-    for (auto &x : forwardPlan) fftwf_destroy_plan(x);
+    auto &fftw = FFTWPlanCache::instance();
 
-    if (spcTmp) fftwf_free(spcTmp);
-    if (spcSrc) fftwf_free(spcSrc);
+    fftw.free(spcTmp);
+    fftw.free(spcSrc);
 
-    if (bufTmp) fftwf_free(bufTmp);
-    if (bufR) fftwf_free(bufR);
-    if (bufW) fftwf_free(bufW);
+    fftw.free(bufTmp);
+    fftw.free(bufR);
+    fftw.free(bufW);
   }
 
   void reset(int indexOffset = 0)
@@ -262,7 +251,7 @@ public:
     bufIndex = 0;
 
     const auto planIndex = prm.frameSizeLog2 - planIndexOffset;
-    fftwf_execute(forwardPlan[planIndex]);
+    fftwExecute(forwardPlan[planIndex], bufW, spcSrc);
 
     const auto spectrumSize = prm.frmSize / 2 + 1;
 
@@ -287,7 +276,7 @@ public:
         = spcTmp[idx] * std::polar(std::abs(maskValue), prm.maskRotation * mask[idx]);
     }
 
-    fftwf_execute(inversePlan[planIndex]);
+    fftwExecute(inversePlan[planIndex], spcSrc, bufR);
     return output;
   }
 
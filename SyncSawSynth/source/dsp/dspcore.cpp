@@ -256,19 +256,20 @@ template<typename Sample> Sample Note<Sample>::process(NoteProcessInfo<Sample> &
   return gain * filter.process(info.osc1Gain * outSaw1 + info.osc2Gain * outSaw2);
 }
 
-DSPCore::DSPCore() { midiNotes.reserve(128); }
+DSPCore::DSPCore() {}
 
 void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.2f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.2f);
 
   for (auto &note : notes) {
-    for (auto &nt : note) nt = std::make_unique<Note<float>>(this->sampleRate);
+    for (auto &nt : note)
+      nt = std::make_unique<Note<float>>(smootherContext, this->sampleRate);
   }
 
   // 10 msec + 1 sample transition time.
@@ -393,7 +394,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   bool unison = param.value[ParameterID::unison]->getFloat();
   for (auto &note : notes) {
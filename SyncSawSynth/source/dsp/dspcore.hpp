@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "envelope.hpp"
@@ -81,11 +82,11 @@ public:
   LinearEnvelope<float> filterEnvelope;
   PolyExpEnvelope<double> modEnvelope;
 
-  Note(Sample sampleRate)
+  Note(const SmootherContext<float> &context, Sample sampleRate)
     : saw1(sampleRate, 0, 0)
     , saw2(sampleRate, 0, 0)
     , filter(sampleRate, Sample(20000), Sample(0.5))
-    , gainEnvelope(sampleRate, Sample(0.2), Sample(0.5), Sample(0.2), Sample(1))
+    , gainEnvelope(context, sampleRate, Sample(0.2), Sample(0.5), Sample(0.2), Sample(1))
     , filterEnvelope(sampleRate, Sample(0.2), Sample(0.5), Sample(0.2), Sample(1))
     , modEnvelope(sampleRate, 0, 1)
   {
@@ -128,7 +129,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -145,26 +146,23 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float lfoPhase = 0.0f;
   float lfoValue = 0.0f;
 
@@ -172,35 +170,35 @@ private:
 
   NoteProcessInfo<float> noteInfo;
 
-  ExpSmoother<float> interpMasterGain;
-  ExpSmoother<float> interpOsc1Gain;
-  ExpSmoother<float> interpOsc1Pitch;
-  ExpSmoother<float> interpOsc1Sync;
-  ExpSmoother<float> interpOsc2Gain;
-  ExpSmoother<float> interpOsc2Pitch;
-  ExpSmoother<float> interpOsc2Sync;
-  ExpSmoother<float> interpFMOsc1ToSync1;
-  ExpSmoother<float> interpFMOsc1ToFreq2;
-  ExpSmoother<float> interpFMOsc2ToSync1;
-  ExpSmoother<float> interpModEnvelopeToFreq1;
-  ExpSmoother<float> interpModEnvelopeToSync1;
-  ExpSmoother<float> interpModEnvelopeToFreq2;
-  ExpSmoother<float> interpModEnvelopeToSync2;
-  ExpSmoother<float> interpModLFOFrequency;
-  ExpSmoother<float> interpModLFONoiseMix;
-  ExpSmoother<float> interpModLFOToFreq1;
-  ExpSmoother<float> interpModLFOToSync1;
-  ExpSmoother<float> interpModLFOToFreq2;
-  ExpSmoother<float> interpModLFOToSync2;
-  ExpSmoother<float> interpGainEnvelopeCurve;
-  ExpSmoother<float> interpFilterCutoff;
-  ExpSmoother<float> interpFilterResonance;
-  ExpSmoother<float> interpFilterFeedback;
-  ExpSmoother<float> interpFilterSaturation;
-  ExpSmoother<float> interpFilterCutoffAmount;
-  ExpSmoother<float> interpFilterResonanceAmount;
-  ExpSmoother<float> interpFilterKeyToCutoff;
-  ExpSmoother<float> interpFilterKeyToFeedback;
+  ExpSmoother<float> interpMasterGain{smootherContext};
+  ExpSmoother<float> interpOsc1Gain{smootherContext};
+  ExpSmoother<float> interpOsc1Pitch{smootherContext};
+  ExpSmoother<float> interpOsc1Sync{smootherContext};
+  ExpSmoother<float> interpOsc2Gain{smootherContext};
+  ExpSmoother<float> interpOsc2Pitch{smootherContext};
+  ExpSmoother<float> interpOsc2Sync{smootherContext};
+  ExpSmoother<float> interpFMOsc1ToSync1{smootherContext};
+  ExpSmoother<float> interpFMOsc1ToFreq2{smootherContext};
+  ExpSmoother<float> interpFMOsc2ToSync1{smootherContext};
+  ExpSmoother<float> interpModEnvelopeToFreq1{smootherContext};
+  ExpSmoother<float> interpModEnvelopeToSync1{smootherContext};
+  ExpSmoother<float> interpModEnvelopeToFreq2{smootherContext};
+  ExpSmoother<float> interpModEnvelopeToSync2{smootherContext};
+  ExpSmoother<float> interpModLFOFrequency{smootherContext};
+  ExpSmoother<float> interpModLFONoiseMix{smootherContext};
+  ExpSmoother<float> interpModLFOToFreq1{smootherContext};
+  ExpSmoother<float> interpModLFOToSync1{smootherContext};
+  ExpSmoother<float> interpModLFOToFreq2{smootherContext};
+  ExpSmoother<float> interpModLFOToSync2{smootherContext};
+  ExpSmoother<float> interpGainEnvelopeCurve{smootherContext};
+  ExpSmoother<float> interpFilterCutoff{smootherContext};
+  ExpSmoother<float> interpFilterResonance{smootherContext};
+  ExpSmoother<float> interpFilterFeedback{smootherContext};
+  ExpSmoother<float> interpFilterSaturation{smootherContext};
+  ExpSmoother<float> interpFilterCutoffAmount{smootherContext};
+  ExpSmoother<float> interpFilterResonanceAmount{smootherContext};
+  ExpSmoother<float> interpFilterKeyToCutoff{smootherContext};
+  ExpSmoother<float> interpFilterKeyToFeedback{smootherContext};
 
   size_t nVoice = 32;
   std::array<std::array<std::unique_ptr<Note<float>>, 2>, maxVoice> notes;
@@ -23,6 +23,7 @@ public:
   // attackTime, decayTime, releaseTime and declickTime are in seconds.
   // sustainLevel in [0, 1]. 0.0 < threshold < 1.0.
   ExpADSREnvelope(
+    const SmootherContext<Sample> &context,
     Sample sampleRate,
     Sample attackTime,
     Sample decayTime,
@@ -30,7 +31,7 @@ public:
     Sample releaseTime,
     Sample declickTime = Sample(0.001),
     Sample threshold = Sample(1e-5))
-    : sampleRate(sampleRate)
+    : sampleRate(sampleRate), sustain(context)
   {
     reset(attackTime, decayTime, sustainLevel, releaseTime, declickTime, threshold);
   }
@@ -272,7 +272,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
   using ID = ParameterID::ID;
   auto &pv = param.value;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   size_t oversampling = pv[ID::oversampling]->getInt();
 
@@ -385,8 +385,8 @@ inline void DSPCore::updateSampleRate(bool reset)
   auto oversampling = std::min<size_t>(pv[ID::oversampling]->getInt(), fold.size() - 1);
   upRate = float(fold[oversampling] * sampleRate);
 
-  SmootherCommon<float>::setSampleRate(upRate);
-  SmootherCommon<float>::setTime(pv[ID::parameterSmoothingSecond]->getFloat());
+  smootherContext.setSampleRate(upRate);
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getFloat());
 
   if (!reset && previousRate == upRate) return;
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -125,6 +126,9 @@ enum class NoteState { active, release, rest };
   oscMix.METHOD(pv[ID::oscMix]->getFloat());
 
 struct NoteProcessInfo {
+  using LfoWavetableSmoother = ParallelExpSmoother<float, nLfoWavetable>;
+  using OscWavetableSmoother = ParallelExpSmoother<float, nOscWavetable>;
+
   std::array<WavetableParameter, nOscillator> tableParam;
 
   std::array<float, nOscillator> envAttackKp{};
@@ -135,9 +139,9 @@ struct NoteProcessInfo {
   std::array<ExpSmoother<float>, nOscillator> lfoPhaseDelta;
   std::array<ExpSmoother<float>, nOscillator> lfoLowpassKp;
   std::array<ExpSmoother<float>, nOscillator> externalInput;
-  std::array<ParallelExpSmoother<float, nLfoWavetable>, nOscillator> lfoWavetable;
-  std::array<ParallelExpSmoother<float, nOscWavetable>, nOscillator> oscWavetable;
-  std::array<ParallelExpSmoother<float, nOscWavetable>, nOscillator> oscWaveModGain;
+  std::array<LfoWavetableSmoother, nOscillator> lfoWavetable;
+  std::array<OscWavetableSmoother, nOscillator> oscWavetable;
+  std::array<OscWavetableSmoother, nOscillator> oscWaveModGain;
   float gainAttackKp = 1;
   float gainDecayKp = 1;
   float gainReleaseKp = 1;
@@ -146,6 +150,22 @@ struct NoteProcessInfo {
   ExpSmoother<float> oscMix;
   ExpSmoother<float> mainPitch;
 
+  explicit NoteProcessInfo(const SmootherContext<float> &context)
+    : tableParam(makeSmootherArray<WavetableParameter, nOscillator>(context))
+    , envelopeSustainAmplitude(
+        makeSmootherArray<ExpSmoother<float>, nOscillator>(context))
+    , lfoPhaseDelta(makeSmootherArray<ExpSmoother<float>, nOscillator>(context))
+    , lfoLowpassKp(makeSmootherArray<ExpSmoother<float>, nOscillator>(context))
+    , externalInput(makeSmootherArray<ExpSmoother<float>, nOscillator>(context))
+    , lfoWavetable(makeSmootherArray<LfoWavetableSmoother, nOscillator>(context))
+    , oscWavetable(makeSmootherArray<OscWavetableSmoother, nOscillator>(context))
+    , oscWaveModGain(makeSmootherArray<OscWavetableSmoother, nOscillator>(context))
+    , gainSustainAmplitude(context)
+    , oscMix(context)
+    , mainPitch(context)
+  {
+  }
+
   inline float getLfoPhaseDelta(size_t oscIndex, float sampleRate, GlobalParameter &param)
   {
     using ID = ParameterID::ID;
@@ -218,6 +238,11 @@ public:
   std::array<std::array<float, nOscWavetable>, nOscillator> wavetable;
   std::array<VariableWaveTableOscillator, nOscillator> oscillator;
 
+  explicit Note(const SmootherContext<float> &context)
+    : lfoPitch(makeSmootherArray<ExpSmoother<float>, nOscillator>(context))
+  {
+  }
+
   void setup(float sampleRate);
   void reset();
   void setParameters(float sampleRate, NoteProcessInfo &info, GlobalParameter &param);
@@ -262,7 +287,7 @@ public:
   void noteOn(int_fast32_t noteId, int_fast16_t pitch, float tuning, float velocity);
   void noteOff(int_fast32_t noteId);
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -279,21 +304,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -307,6 +328,7 @@ private:
   static constexpr std::array<size_t, 3> fold{1, 2, DownSamplerType::fold};
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
   float upRate = DownSamplerType::fold * 44100.0f;
   float velocity = 0.0f;
   DecibelScale<float> velocityMap{-60, 0, true};
@@ -315,12 +337,12 @@ private:
   std::vector<size_t> noteIndices;
   std::vector<size_t> voiceIndices;
   std::vector<float> unisonPan;
-  std::array<Note, maxVoice> notes;
+  std::array<Note, maxVoice> notes = makeSmootherArray<Note, maxVoice>(smootherContext);
 
-  NoteProcessInfo info;
+  NoteProcessInfo info{smootherContext};
   bool dcHighpassEnable = false;
-  ExpSmoother<float> interpMasterGain;
-  ExpSmoother<float> dcHighpassCutoffKp;
+  ExpSmoother<float> interpMasterGain{smootherContext};
+  ExpSmoother<float> dcHighpassCutoffKp{smootherContext};
 
   std::array<EMAHighpass<double>, 2> dcHighpass;
   std::array<DownSamplerType, 2> downSampler;
@@ -4,22 +4,17 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/fft/fftw.hpp"
 #include "../../../common/dsp/smoother.hpp"
-#include "../../../lib/fftw3/fftw3.h"
 #include "modulationenum.hpp"
 
 #include <algorithm>
 #include <array>
 #include <complex>
-#include <mutex>
 #include <numeric>
 
 namespace SomeDSP {
 
-// `fftwMutex` is used to lock FFTW3 calls except `fftw*_execute`. In other words, FFTW3
-// isn't thread safe except `fftw*_execute` call.
-extern std::mutex fftwMutex;
-
 // Range of t is in [0, 1]. Interpoltes between y1 and y2.
 // y0 is current, y3 is earlier sample.
 template<typename T> inline T lagrange3Interp(T y0, T y1, T y2, T y3, T t)
@@ -58,6 +53,21 @@ struct WavetableParameter {
   ParallelExpSmoother<float, ModID::MODID_ENUM_LENGTH> accumulatePm;
   ParallelExpSmoother<float, ModID::MODID_ENUM_LENGTH> fm;
 
+  explicit WavetableParameter(const SmootherContext<float> &context)
+    : oscPitch(context)
+    , sumMix(context)
+    , feedbackLowpassKp(context)
+    , sumToImmediatePm(context)
+    , sumToAccumulatePm(context)
+    , sumToFm(context)
+    , sumToAm(context)
+    , pitch(context)
+    , immedaitePm(context)
+    , accumulatePm(context)
+    , fm(context)
+  {
+  }
+
   std::array<float, ModID::MODID_ENUM_LENGTH> modHardSync{};
   std::array<float, ModID::MODID_ENUM_LENGTH> modPhaseSkew{};
   std::array<float, ModID::MODID_ENUM_LENGTH> modDistortion{};
@@ -79,18 +89,11 @@ template<size_t tableSize> struct WaveForm {
 
   WaveForm()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    table = (float *)fftwf_malloc(sizeof(float) * tableSize);
+    table = FFTWPlanCache::instance().allocate<float>(tableSize);
     std::fill(table, table + tableSize, 0.0f);
   }
 
-  ~WaveForm()
-  {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    if (table) fftwf_free(table);
-  }
+  ~WaveForm() { FFTWPlanCache::instance().free(table); }
 
   inline float phaseSkewFunc(float x) { return x * x * x * x * x * x * x * x; }
 
@@ -158,18 +161,16 @@ template<size_t tableSize> struct Spectrum {
 
   Spectrum()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    src = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spectrumSize);
-    dst = (std::complex<float> *)fftwf_malloc(sizeof(std::complex<float>) * spectrumSize);
+    auto &fftw = FFTWPlanCache::instance();
+    src = fftw.allocate<std::complex<float>>(spectrumSize);
+    dst = fftw.allocate<std::complex<float>>(spectrumSize);
   }
 
   ~Spectrum()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    if (src) fftwf_free(src);
-    if (dst) fftwf_free(dst);
+    auto &fftw = FFTWPlanCache::instance();
+    fftw.free(src);
+    fftw.free(dst);
   }
 
   void prepare(
@@ -223,6 +224,7 @@ struct VariableWaveTableOscillator {
   WaveForm<tableSize> waveform;
   Spectrum<tableSize> spectrum;
 
+  // Plans are owned by `FFTWPlanCache`, and shared with other voices.
   fftwf_plan forwardPlan;
   std::array<fftwf_plan, 2> inversePlan;
 
@@ -237,29 +239,22 @@ struct VariableWaveTableOscillator {
 
   VariableWaveTableOscillator()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
+    auto &fftw = FFTWPlanCache::instance();
 
-    forwardPlan = fftwf_plan_dft_r2c_1d(
-      tableSize, waveform.table, reinterpret_cast<fftwf_complex *>(spectrum.src),
-      FFTW_ESTIMATE);
+    forwardPlan = fftw.getR2C(tableSize, waveform.table, spectrum.src);
 
     for (size_t idx = 0; idx < table.size(); ++idx) {
-      table[idx] = (float *)fftwf_malloc(sizeof(float) * paddedSize);
+      table[idx] = fftw.allocate<float>(paddedSize);
       std::fill(table[idx], table[idx] + paddedSize, 0.0f);
 
-      inversePlan[idx] = fftwf_plan_dft_c2r_1d(
-        tableSize, reinterpret_cast<fftwf_complex *>(spectrum.dst), table[idx] + 1,
-        FFTW_ESTIMATE);
+      inversePlan[idx] = fftw.getC2R(tableSize, spectrum.dst, table[idx] + 1);
     }
   }
 
   ~VariableWaveTableOscillator()
   {
-    const std::lock_guard<std::mutex> fftwLock(fftwMutex);
-
-    for (auto &pln : inversePlan) fftwf_destroy_plan(pln);
-    for (auto &tbl : table) fftwf_free(tbl);
-    fftwf_destroy_plan(forwardPlan);
+    auto &fftw = FFTWPlanCache::instance();
+    for (auto &tbl : table) fftw.free(tbl);
   }
 
   void reset()
@@ -295,9 +290,9 @@ struct VariableWaveTableOscillator {
     WavetableParameter &param)
   {
     waveform.draw(mod, wavetable, param);
-    fftwf_execute(forwardPlan);
+    fftwExecute(forwardPlan, waveform.table, spectrum.src);
     spectrum.prepare(noteHz, mod, param);
-    fftwf_execute(inversePlan[tableIndex]);
+    fftwExecute(inversePlan[tableIndex], spectrum.dst, table[tableIndex] + 1);
 
     table[tableIndex][0] = table[tableIndex][tableSize];
     table[tableIndex][paddedSize - 2] = table[tableIndex][1];
@@ -334,16 +334,16 @@ template<typename Sample> Sample TpzMono<Sample>::getOsc2Pitch(GlobalParameter &
            param.value[ParameterID::pitchBend]->getFloat());
 }
 
-DSPCore::DSPCore() { midiNotes.reserve(128); }
+DSPCore::DSPCore() {}
 
 void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(0.01f);
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(0.01f);
 
   noteStack.reserve(128);
   noteStack.resize(0);
@@ -367,7 +367,7 @@ void DSPCore::startup() { tpz1.startup(); }
 
 void DSPCore::setParameters(double tempo)
 {
-  SmootherCommon<float>::setTime(param.value[ParameterID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getFloat());
 
   interpMasterGain.push(velocity * param.value[ParameterID::gain]->getFloat());
 
@@ -378,7 +378,7 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   float sample = 1.0;
   for (uint32_t i = 0; i < length; ++i) {
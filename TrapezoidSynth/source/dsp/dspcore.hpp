@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "envelope.hpp"
@@ -96,6 +97,42 @@ public:
   LinearSmoother<Sample> interpShifter2Pitch;
   LinearSmoother<Sample> interpShifter2Gain;
 
+  explicit TpzMono(const SmootherContext<Sample> &context)
+    : interpOctave(context)
+    , interpOsc1Pitch(context)
+    , interpOsc2Pitch(context)
+    , interpOsc1Slope(context)
+    , interpOsc1PulseWidth(context)
+    , interpOsc2Slope(context)
+    , interpOsc2PulseWidth(context)
+    , interpPhaseMod(context)
+    , interpOscMix(context)
+    , interpPitchDrift(context)
+    , interpFeedback(context)
+    , interpFilterCutoff(context)
+    , interpFilterFeedback(context)
+    , interpFilterSaturation(context)
+    , interpFilterEnvToCutoff(context)
+    , interpFilterKeyToCutoff(context)
+    , interpOscMixToFilterCutoff(context)
+    , interpMod1EnvToPhaseMod(context)
+    , interpMod2EnvToFeedback(context)
+    , interpMod2EnvToLFOFrequency(context)
+    , interpModEnv2ToOsc2Slope(context)
+    , interpMod2EnvToShifter1(context)
+    , interpLFOFrequency(context)
+    , interpLFOShape(context)
+    , interpLFOToPitch(context)
+    , interpLFOToSlope(context)
+    , interpLFOToPulseWidth(context)
+    , interpLFOToCutoff(context)
+    , interpShifter1Pitch(context)
+    , interpShifter1Gain(context)
+    , interpShifter2Pitch(context)
+    , interpShifter2Gain(context)
+  {
+  }
+
   void setup(Sample sampleRate);
   void reset(GlobalParameter &param);
   void startup();
@@ -137,7 +174,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -154,31 +191,28 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(uint32_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
 private:
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   float velocity = 0;
   std::vector<NoteInfo> noteStack; // Top of this stack is current note.
 
-  TpzMono<float> tpz1;
+  TpzMono<float> tpz1{smootherContext};
 
-  LinearSmoother<float> interpMasterGain;
+  LinearSmoother<float> interpMasterGain{smootherContext};
 };
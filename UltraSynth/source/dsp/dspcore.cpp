@@ -35,13 +35,20 @@ void DSPCore::setup(double sampleRate)
 
   baseRateKp = EMAFilter<double>::secondToP(sampleRate, smoothingTimeSecond);
 
-  SmootherCommon<double>::setSampleRate(upRate);
-  SmootherCommon<double>::setTime(smoothingTimeSecond);
+  smootherContext.setSampleRate(upRate);
+
+  offlineOversampler.setup(1);
+  offlineOversampler.set(upFold, OversamplingQuality::fir);
 
   reset();
   startup();
 }
 
+size_t DSPCore::getLatency()
+{
+  return isOffline ? size_t(std::lround(offlineOversampler.latency())) : 0;
+}
+
 #define ASSIGN_PARAMETER(METHOD)                                                         \
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
@@ -119,6 +126,7 @@ void DSPCore::reset()
   firstStageLowpass.reset();
   halfBandInput.fill({});
   halfbandIir.reset();
+  offlineOversampler.reset();
 
   startup();
 }
@@ -131,7 +139,10 @@ void DSPCore::startup()
   resetBuffer();
 }
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+}
 
 template<typename Sample> inline Sample processOsc(Sample phase, Sample shape, Sample mix)
 {
@@ -140,15 +151,15 @@ template<typename Sample> inline Sample processOsc(Sample phase, Sample shape, S
                  : lerp(phase / shape, Sample(1), mix));
 }
 
-void DSPCore::process(const size_t length, float *out0, float *out1)
+template<typename Sample>
+void DSPCore::process(const size_t length, Sample *out0, Sample *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
   using ID = ParameterID::ID;
   const auto &pv = param.value;
 
-  SmootherCommon<double>::setBufferSize(double(length));
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setBufferSize(double(length));
 
   // When tempo-sync is off, use defaultTempo BPM.
   bool isTempoSyncing = pv[ID::lfoTempoSync]->getInt();
@@ -244,18 +255,30 @@ void DSPCore::process(const size_t length, float *out0, float *out1)
         feedback = sig;
         feedback -= std::floor(sig);
 
-        firstStageLowpass.push(sig);
+        if (isOffline) {
+          offlineOversampler.data()[j * firstStateFold + k] = sig;
+        } else {
+          firstStageLowpass.push(sig);
+        }
       }
       halfBandInput[j] = firstStageLowpass.output();
     }
 
-    auto out
-      = float(interpOutputGain.process(baseRateKp) * halfbandIir.process(halfBandInput));
+    double decimated;
+    if (isOffline) {
+      offlineOversampler.down(&decimated, 1);
+    } else {
+      decimated = halfbandIir.process(halfBandInput);
+    }
+    auto out = Sample(interpOutputGain.process(baseRateKp) * decimated);
     out0[i] = out;
     out1[i] = out;
   }
 }
 
+template void DSPCore::process<float>(const size_t, float *, float *);
+template void DSPCore::process<double>(const size_t, double *, double *);
+
 void DSPCore::noteOn(NoteInfo &info)
 {
   using ID = ParameterID::ID;
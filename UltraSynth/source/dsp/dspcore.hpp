@@ -4,8 +4,10 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/lfo.hpp"
 #include "../../../common/dsp/multirate.hpp"
+#include "../../../common/dsp/multirate/oversampler.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "filter.hpp"
@@ -25,13 +27,10 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
+  bool isOffline = false; // Set before `setup`. Uses `offlineOversampler` if true.
   bool isPlaying = false;
   double tempo = 120.0;
   double beatsElapsed = 0.0;
@@ -41,8 +40,9 @@ public:
   void setup(double sampleRate);
   void reset();
   void startup();
+  size_t getLatency();
   void setParameters();
-  void process(const size_t length, float *out0, float *out1);
+  template<typename Sample> void process(const size_t length, Sample *out0, Sample *out1);
   void noteOn(NoteInfo &info);
   void noteOff(int_fast32_t noteId);
 
@@ -60,21 +60,17 @@ public:
     note.id = noteId;
     note.noteNumber = noteNumber + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -82,13 +78,14 @@ private:
   static constexpr size_t upFold = 64;
   static constexpr size_t firstStateFold = Sos64FoldFirstStage<float>::fold;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   DecibelScale<double> velocityMap{-36, 0, true};
   double velocity = 0;
 
   double sampleRate = 44100.0;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100.0;
 
   double noteNumber = 69.0;
@@ -111,24 +108,24 @@ private:
   DoubleEMAFilter<double> lfoSmootherB;
   DoubleEMAFilter<double> lfoSmootherP;
 
-  ExpSmoother<double> interpFrequencyHz;
-  ExpSmoother<double> interpOsc1FrequencyOffsetPitch;
-  ExpSmoother<double> interpOsc2FrequencyOffsetPitch;
-  ExpSmoother<double> interpOsc1WaveShape;
-  ExpSmoother<double> interpOsc2WaveShape;
-  ExpSmoother<double> interpOsc1SawPulse;
-  ExpSmoother<double> interpOsc2SawPulse;
-  ExpSmoother<double> interpPhaseModFromLowpassToOsc1;
-  ExpSmoother<double> interpPmPhase1ToPhase2;
-  ExpSmoother<double> interpPmPhase2ToPhase1;
-  ExpSmoother<double> interpPmOsc1ToPhase2;
-  ExpSmoother<double> interpPmOsc2ToPhase1;
-  ExpSmoother<double> interpOscMix;
-  ExpSmoother<double> interpSvfG;
-  ExpSmoother<double> interpSvfK;
-  ExpSmoother<double> interpRectificationMix;
-  ExpSmoother<double> interpSaturationMix;
-  ExpSmoother<double> interpSustain;
+  ExpSmoother<double> interpFrequencyHz{smootherContext};
+  ExpSmoother<double> interpOsc1FrequencyOffsetPitch{smootherContext};
+  ExpSmoother<double> interpOsc2FrequencyOffsetPitch{smootherContext};
+  ExpSmoother<double> interpOsc1WaveShape{smootherContext};
+  ExpSmoother<double> interpOsc2WaveShape{smootherContext};
+  ExpSmoother<double> interpOsc1SawPulse{smootherContext};
+  ExpSmoother<double> interpOsc2SawPulse{smootherContext};
+  ExpSmoother<double> interpPhaseModFromLowpassToOsc1{smootherContext};
+  ExpSmoother<double> interpPmPhase1ToPhase2{smootherContext};
+  ExpSmoother<double> interpPmPhase2ToPhase1{smootherContext};
+  ExpSmoother<double> interpPmOsc1ToPhase2{smootherContext};
+  ExpSmoother<double> interpPmOsc2ToPhase1{smootherContext};
+  ExpSmoother<double> interpOscMix{smootherContext};
+  ExpSmoother<double> interpSvfG{smootherContext};
+  ExpSmoother<double> interpSvfK{smootherContext};
+  ExpSmoother<double> interpRectificationMix{smootherContext};
+  ExpSmoother<double> interpSaturationMix{smootherContext};
+  ExpSmoother<double> interpSustain{smootherContext};
 
   double feedback = 0;
   double phase1 = 0;
@@ -147,6 +144,7 @@ private:
   DecimationLowpass<double, Sos64FoldFirstStage<double>> firstStageLowpass;
   std::array<double, 2> halfBandInput;
   HalfBandIIR<double, HalfBandCoefficient<double>> halfbandIir;
+  Oversampler<double> offlineOversampler; // Linear phase decimator for `upFold`.
 
   double calcNotePitch(double note);
   double getTempoSyncInterval();
@@ -16,7 +16,7 @@ void DSPCore::setup(double sampleRate)
   this->sampleRate = double(sampleRate);
   upRate = double(sampleRate) * upFold;
 
-  SmootherCommon<double>::setSampleRate(upRate);
+  smootherContext.setSampleRate(upRate);
 
   reset();
   startup();
@@ -28,7 +28,7 @@ size_t DSPCore::getLatency() { return 0; }
   using ID = ParameterID::ID;                                                            \
   const auto &pv = param.value;                                                          \
                                                                                          \
-  SmootherCommon<double>::setTime(pv[ID::parameterSmoothingSecond]->getDouble());        \
+  smootherContext.setTime(pv[ID::parameterSmoothingSecond]->getDouble());                \
                                                                                          \
   pitchSmoothingKp = double(                                                             \
     EMAFilter<double>::secondToP(upRate, pv[ID::noteSlideTimeSecond]->getDouble()));     \
@@ -64,14 +64,17 @@ void DSPCore::reset()
 
 void DSPCore::startup() { phase = 0; }
 
-void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
+void DSPCore::setParameters()
+{
+  ASSIGN_PARAMETER(push);
+}
 
 void DSPCore::process(
   const size_t length, const float *in0, const float *in1, float *out0, float *out1)
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<double>::setBufferSize(double(length));
+  smootherContext.setBufferSize(double(length));
 
   for (size_t i = 0; i < length; ++i) {
     processMidiNote(i);
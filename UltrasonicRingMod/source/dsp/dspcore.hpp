@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/multirate.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
@@ -23,11 +24,7 @@ public:
     float velocity;
   };
 
-  DSPCore()
-  {
-    midiNotes.reserve(1024);
-    noteStack.reserve(1024);
-  }
+  DSPCore() { noteStack.reserve(1024); }
 
   GlobalParameter param;
 
@@ -55,21 +52,17 @@ public:
     note.id = noteId;
     note.pitch = pitch + tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(*it);
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -77,24 +70,25 @@ private:
   static constexpr size_t upFold = 64;
   static constexpr size_t firstStateFold = Sos64FoldFirstStage<double>::fold;
 
-  std::vector<NoteInfo> midiNotes;
+  FrameEventQueue<NoteInfo> midiNotes;
   std::vector<NoteInfo> noteStack;
 
   double sampleRate = 44100;
+  SmootherContext<double> smootherContext;
   double upRate = upFold * 44100;
 
   double pitchSmoothingKp = 1;
   ExpSmootherLocal<double> interpPitch;
 
-  ExpSmoother<double> interpPreClipGain;
-  ExpSmoother<double> interpOutputGain;
-  ExpSmoother<double> interpMix;
-  ExpSmoother<double> interpFrequencyHz;
-  ExpSmoother<double> interpDCOffset;
-  ExpSmoother<double> interpFeedbackGain;
-  ExpSmoother<double> interpModFrequencyScaling;
-  ExpSmoother<double> interpModWrapMix;
-  ExpSmoother<double> interpHardclipMix;
+  ExpSmoother<double> interpPreClipGain{smootherContext};
+  ExpSmoother<double> interpOutputGain{smootherContext};
+  ExpSmoother<double> interpMix{smootherContext};
+  ExpSmoother<double> interpFrequencyHz{smootherContext};
+  ExpSmoother<double> interpDCOffset{smootherContext};
+  ExpSmoother<double> interpFeedbackGain{smootherContext};
+  ExpSmoother<double> interpModFrequencyScaling{smootherContext};
+  ExpSmoother<double> interpModWrapMix{smootherContext};
+  ExpSmoother<double> interpHardclipMix{smootherContext};
 
   std::array<LinearUpSampler<double, upFold>, 2> upSampler;
   std::array<DecimationLowpass<double, Sos64FoldFirstStage<double>>, 2> firstStageLowpass;
@@ -39,16 +39,16 @@ void DSPCore::setSystem()
     param.value[ParameterID::randomAmount]->getFloat());
 }
 
-DSPCore::DSPCore() { midiNotes.reserve(128); }
+DSPCore::DSPCore() {}
 
 void DSPCore::setup(double sampleRate)
 {
   this->sampleRate = float(sampleRate);
 
-  midiNotes.resize(0);
+  midiNotes.clear();
 
-  SmootherCommon<float>::setSampleRate(this->sampleRate);
-  SmootherCommon<float>::setTime(param.value[ParameterID::smoothness]->getFloat());
+  smootherContext.setSampleRate(this->sampleRate);
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getFloat());
 
   noteStack.reserve(128);
   noteStack.resize(0);
@@ -84,7 +84,7 @@ void DSPCore::startup() { rnd.seed = param.value[ParameterID::seed]->getInt(); }
 
 void DSPCore::setParameters()
 {
-  SmootherCommon<float>::setTime(param.value[ParameterID::smoothness]->getFloat());
+  smootherContext.setTime(param.value[ParameterID::smoothness]->getFloat());
 
   interpMasterGain.push(param.value[ParameterID::gain]->getFloat());
 
@@ -117,7 +117,7 @@ void DSPCore::process(
 {
   ScopedNoDenormals scopedDenormals;
 
-  SmootherCommon<float>::setBufferSize(float(length));
+  smootherContext.setBufferSize(float(length));
 
   const bool excitation = param.value[ParameterID::excitation]->getInt();
   const bool collision = param.value[ParameterID::collision]->getInt();
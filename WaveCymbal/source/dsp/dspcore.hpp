@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../../common/dsp/constants.hpp"
+#include "../../../common/dsp/eventqueue.hpp"
 #include "../../../common/dsp/smoother.hpp"
 #include "../parameter.hpp"
 #include "ksstring.hpp"
@@ -46,7 +47,7 @@ public:
     float velocity;
   };
 
-  std::vector<MidiNote> midiNotes;
+  FrameEventQueue<MidiNote> midiNotes;
 
   void pushMidiNote(
     bool isNoteOn,
@@ -63,21 +64,17 @@ public:
     note.pitch = pitch;
     note.tuning = tuning;
     note.velocity = velocity;
-    midiNotes.push_back(note);
+    midiNotes.push(note);
   }
 
   void processMidiNote(size_t frame)
   {
-    while (true) {
-      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const MidiNote &nt) {
-        return nt.frame == frame;
-      });
-      if (it == std::end(midiNotes)) return;
-      if (it->isNoteOn)
-        noteOn(it->id, it->pitch, it->tuning, it->velocity);
+    MidiNote note;
+    while (midiNotes.pop(frame, note)) {
+      if (note.isNoteOn)
+        noteOn(note.id, note.pitch, note.tuning, note.velocity);
       else
-        noteOff(it->id);
-      midiNotes.erase(it);
+        noteOff(note.id);
     }
   }
 
@@ -85,6 +82,7 @@ private:
   void setSystem();
 
   float sampleRate = 44100.0f;
+  SmootherContext<float> smootherContext;
 
   // Top of this stack is current note.
   std::vector<NoteInfo> noteStack;
@@ -94,12 +92,12 @@ private:
   Brown<float> brownNoise{0};
 
   Random<float> rnd{0};
-  Excitor<float> excitor;
-  WaveHat<float> cymbal;
+  Excitor<float> excitor{smootherContext};
+  WaveHat<float> cymbal{smootherContext};
 
   // debug
   bool trigger = false;
 
-  LinearSmoother<float> interpMasterGain;
-  LinearSmoother<float> interpPitch;
+  LinearSmoother<float> interpMasterGain{smootherContext};
+  LinearSmoother<float> interpPitch{smootherContext};
 };
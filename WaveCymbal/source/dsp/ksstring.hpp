@@ -67,6 +67,8 @@ public:
 // Karplus-Strong algorithm. Min 10hz.
 template<typename Sample> class KSString {
 public:
+  explicit KSString(const SmootherContext<Sample> &context) : interpDelayTime(context) {}
+
   void setup(Sample sampleRate, Sample frequency, Sample decay)
   {
     delay.setup(sampleRate, Sample(1.0) / frequency, Sample(0.1));
@@ -208,6 +210,11 @@ public:
   std::array<Sample, maxStack> bandpassRnd{};
   std::array<BiquadBandpass<Sample>, maxStack> bandpass;
 
+  explicit WaveString(const SmootherContext<Sample> &context)
+    : string(makeSmootherArray<KSString<Sample>, maxStack>(context))
+  {
+  }
+
   void setup(Sample sampleRate)
   {
     wave1d.setup(sampleRate, maxStack, Sample(0.5), Sample(0.5), Sample(0.1));
@@ -291,6 +298,11 @@ public:
   Sample distance = 100;
   std::array<WaveString<Sample, maxStack>, maxCymbal> string;
 
+  explicit WaveHat(const SmootherContext<Sample> &context)
+    : string(makeSmootherArray<WaveString<Sample, maxStack>, maxCymbal>(context))
+  {
+  }
+
   void setup(Sample sampleRate)
   {
     for (auto &str : string) str.setup(sampleRate);
@@ -354,6 +366,8 @@ public:
 
 template<typename Sample> class Comb {
 public:
+  explicit Comb(const SmootherContext<Sample> &context) : interpDelayTime(context) {}
+
   void setup(Sample sampleRate, Sample time, Sample gain, Sample feedback)
   {
     this->gain = gain;
@@ -397,7 +411,10 @@ protected:
 
 template<typename Sample> class Excitor {
 public:
-  Excitor() {}
+  explicit Excitor(const SmootherContext<Sample> &context)
+    : comb(makeSmootherArray<Comb<Sample>, 8>(context))
+  {
+  }
 
   void setup(Sample sampleRate)
   {
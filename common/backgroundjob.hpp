@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Steinberg {
+namespace Synth {
+
+/**
+Background execution of heavy refreshes, like wavetable, FIR or matrix rebuilds.
+
+- `BackgroundWorker` is a thread pool shared by all instances of a plugin binary.
+- `BackgroundTask` is a single piece of work owned by a DSPCore. `submit()` and `poll()`
+  are realtime safe: no allocation, no lock.
+- `BackgroundDoubleBuffer` builds a result into the back buffer, then swaps it to the
+  front on the audio thread. The previous result is kept until `release()`, so the
+  caller can crossfade from old to new.
+
+Construct and destruct tasks outside of the audio thread. The first task starts the
+worker threads, and the last one stops them.
+*/
+
+class BackgroundTask;
+
+// Bounded multi-producer multi-consumer queue. Dmitry Vyukov's algorithm.
+template<typename T, size_t capacity> class BoundedJobQueue {
+private:
+  static_assert(
+    capacity >= 2 && (capacity & (capacity - 1)) == 0,
+    "BoundedJobQueue: capacity must be power of 2.");
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  static constexpr size_t mask = capacity - 1;
+
+  std::array<Cell, capacity> cells;
+  alignas(64) std::atomic<size_t> enqueuePos{0};
+  alignas(64) std::atomic<size_t> dequeuePos{0};
+
+public:
+  BoundedJobQueue()
+  {
+    for (size_t idx = 0; idx < capacity; ++idx) {
+      cells[idx].sequence.store(idx, std::memory_order_relaxed);
+    }
+  }
+
+  bool push(T data)
+  {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      auto &cell = cells[pos & mask];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      auto diff = intptr_t(seq) - intptr_t(pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.data = data;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // Full.
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool pop(T &data)
+  {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      auto &cell = cells[pos & mask];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      auto diff = intptr_t(seq) - intptr_t(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          data = cell.data;
+          cell.sequence.store(pos + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // Empty.
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+class BackgroundWorker {
+public:
+  static BackgroundWorker &instance()
+  {
+    static BackgroundWorker worker;
+    return worker;
+  }
+
+  // Not realtime safe. Starts threads on the first call.
+  void acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (userCount++ > 0) return;
+
+    isRunning.store(true);
+    unsigned nThread = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    for (unsigned idx = 0; idx < nThread; ++idx) {
+      threads.emplace_back([this]() { runLoop(); });
+    }
+  }
+
+  // Not realtime safe. Stops threads on the last call.
+  void release()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (userCount == 0 || --userCount > 0) return;
+
+    isRunning.store(false);
+    signal.fetch_add(1, std::memory_order_release);
+    signal.notify_all();
+    for (auto &th : threads) th.join();
+    threads.clear();
+  }
+
+  // Realtime safe. Returns false when the queue is full.
+  bool push(BackgroundTask *task)
+  {
+    if (!queue.push(task)) return false;
+    signal.fetch_add(1, std::memory_order_release);
+    signal.notify_one();
+    return true;
+  }
+
+private:
+  BackgroundWorker() = default;
+  ~BackgroundWorker()
+  {
+    if (threads.empty()) return;
+    userCount = 1;
+    release();
+  }
+
+  inline void runLoop();
+
+  BoundedJobQueue<BackgroundTask *, 256> queue;
+  std::atomic<uint32_t> signal{0};
+  std::atomic<bool> isRunning{false};
+
+  std::mutex mutex;
+  size_t userCount = 0;
+  std::vector<std::thread> threads;
+};
+
+class BackgroundTask {
+public:
+  explicit BackgroundTask(std::function<void()> work) : work(std::move(work))
+  {
+    BackgroundWorker::instance().acquire();
+  }
+
+  ~BackgroundTask()
+  {
+    wait();
+    BackgroundWorker::instance().release();
+  }
+
+  BackgroundTask(const BackgroundTask &) = delete;
+  BackgroundTask &operator=(const BackgroundTask &) = delete;
+
+  // Realtime safe. Returns false if the task is in flight or not yet polled, or the queue
+  // is full. Inputs of the work must be written before calling this.
+  bool submit()
+  {
+    if (state.load(std::memory_order_acquire) != State::idle) return false;
+    state.store(State::queued, std::memory_order_relaxed);
+    if (BackgroundWorker::instance().push(this)) return true;
+    state.store(State::idle, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Realtime safe. Returns true once after the work is finished. Outputs of the work can
+  // be read after this returns true.
+  bool poll()
+  {
+    if (state.load(std::memory_order_acquire) != State::done) return false;
+    state.store(State::idle, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool isBusy() const { return state.load(std::memory_order_acquire) == State::queued; }
+
+  // Not realtime safe. Blocks until the submitted work is finished.
+  void wait()
+  {
+    while (isBusy()) std::this_thread::yield();
+  }
+
+private:
+  friend class BackgroundWorker;
+
+  enum class State : int { idle, queued, done };
+
+  void run()
+  {
+    work();
+    state.store(State::done, std::memory_order_release);
+  }
+
+  std::function<void()> work;
+  std::atomic<State> state{State::idle};
+};
+
+inline void BackgroundWorker::runLoop()
+{
+  for (;;) {
+    // Loading `signal` first avoids missing a push or a stop between the checks and
+    // `wait`.
+    auto seen = signal.load(std::memory_order_acquire);
+    if (!isRunning.load(std::memory_order_acquire)) break;
+
+    BackgroundTask *task = nullptr;
+    if (queue.pop(task)) {
+      task->run();
+      continue;
+    }
+    signal.wait(seen, std::memory_order_acquire);
+  }
+}
+
+/**
+`build(Result &back, const Input &input)` runs on the worker thread. `Input` is copied on
+the audio thread, so it must be trivially copyable.
+
+Call `update()` once per block on the audio thread. When it returns true, `front()` is
+the new result and `previous()` is the old one. A new request isn't started until
+`release()` is called, so `previous()` stays valid during a crossfade.
+*/
+template<typename Result, typename Input> class BackgroundDoubleBuffer {
+public:
+  static_assert(
+    std::is_trivially_copyable_v<Input>,
+    "BackgroundDoubleBuffer: Input must be trivially copyable.");
+
+  using Builder = std::function<void(Result &, const Input &)>;
+
+  BackgroundDoubleBuffer(Builder build)
+    : build(std::move(build)), task([this]() { this->build(buffer[backIndex], input); })
+  {
+  }
+
+  const Result &front() const { return buffer[frontIndex]; }
+  const Result &previous() const { return buffer[frontIndex ^ 1]; }
+
+  // Not realtime safe. Builds `front()` immediately, and discards requests in flight.
+  void reset(const Input &newInput)
+  {
+    task.wait();
+    task.poll();
+    isPending = false;
+    isPreviousInUse = false;
+    input = newInput;
+    build(buffer[frontIndex], input);
+  }
+
+  // Realtime safe. Only the latest request is built when requested more than once.
+  void request(const Input &newInput)
+  {
+    pendingInput = newInput;
+    isPending = true;
+  }
+
+  // Realtime safe. Returns true when `front()` is replaced.
+  bool update()
+  {
+    bool isSwapped = false;
+    if (task.poll()) {
+      frontIndex ^= 1;
+      isPreviousInUse = true;
+      isSwapped = true;
+    }
+
+    if (isPending && !isPreviousInUse && !task.isBusy()) {
+      input = pendingInput;
+      backIndex = frontIndex ^ 1;
+      if (task.submit()) isPending = false;
+    }
+    return isSwapped;
+  }
+
+  // Realtime safe. Call when `previous()` is no longer used.
+  void release() { isPreviousInUse = false; }
+
+  bool isBuilding() const { return isPending || task.isBusy(); }
+
+private:
+  std::array<Result, 2> buffer{};
+  size_t frontIndex = 0;
+  size_t backIndex = 1;
+
+  Input input{};
+  Input pendingInput{};
+  bool isPending = false;
+  bool isPreviousInUse = false;
+
+  Builder build;
+  BackgroundTask task; // Destructed first, which waits for the work in flight.
+};
+
+} // namespace Synth
+} // namespace Steinberg
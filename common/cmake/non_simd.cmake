@@ -26,6 +26,34 @@ function(build_test additional_sources)
     SndFile::sndfile
     ${src}
     fftw3)
+
+  # Optional offline render and benchmark. See `test/bench.hpp`.
+  if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/test/bench.cpp")
+    set(bench "uhhyou-bench_${PLUGIN_NAME}")
+    add_executable(${bench} test/bench.cpp)
+    target_compile_definitions(${bench} PRIVATE
+      UHHYOU_PLUGIN_NAME="${PLUGIN_NAME}")
+    target_link_libraries(${bench} PRIVATE
+      SndFile::sndfile
+      ${src}
+      fftw3)
+
+    # Same as bench, but records allocations and locks. See `test/rtsafety.hpp`.
+    if(UNIX AND NOT APPLE)
+      set(rtcheck "uhhyou-rtcheck_${PLUGIN_NAME}")
+      add_executable(${rtcheck} test/bench.cpp ../test/rtsafety.cpp)
+      target_compile_definitions(${rtcheck} PRIVATE
+        UHHYOU_PLUGIN_NAME="${PLUGIN_NAME}"
+        UHHYOU_RT_CHECK)
+      target_include_directories(${rtcheck} PRIVATE ../test/sdkstub)
+      set_target_properties(${rtcheck} PROPERTIES ENABLE_EXPORTS ON)
+      target_link_libraries(${rtcheck} PRIVATE
+        SndFile::sndfile
+        ${src}
+        fftw3
+        ${CMAKE_DL_LIBS})
+    endif()
+  endif()
 endfunction()
 
 function(build_vst3 plug_sources)
@@ -25,6 +25,118 @@ function(build_test)
     SndFile::sndfile
     ${src}
     fftw3)
+
+  # Optional offline render and benchmark. See `test/bench.hpp`.
+  if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/test/bench.cpp")
+    set(bench "uhhyou-bench_${PLUGIN_NAME}")
+    add_executable(${bench} test/bench.cpp)
+    target_compile_definitions(${bench} PRIVATE
+      UHHYOU_PLUGIN_NAME="${PLUGIN_NAME}")
+    target_link_libraries(${bench} PRIVATE
+      SndFile::sndfile
+      ${src}
+      fftw3)
+
+    # Same as bench, but records allocations and locks. See `test/rtsafety.hpp`.
+    if(UNIX AND NOT APPLE)
+      set(rtcheck "uhhyou-rtcheck_${PLUGIN_NAME}")
+      add_executable(${rtcheck} test/bench.cpp ../test/rtsafety.cpp)
+      target_compile_definitions(${rtcheck} PRIVATE
+        UHHYOU_PLUGIN_NAME="${PLUGIN_NAME}"
+        UHHYOU_RT_CHECK)
+      target_include_directories(${rtcheck} PRIVATE ../test/sdkstub)
+      set_target_properties(${rtcheck} PROPERTIES ENABLE_EXPORTS ON)
+      target_link_libraries(${rtcheck} PRIVATE
+        SndFile::sndfile
+        ${src}
+        fftw3
+        ${CMAKE_DL_LIBS})
+    endif()
+  endif()
+endfunction()
+
+# Writes a source that includes `source` only when compiled for `arch`. A universal binary
+# on macOS compiles every source for all of `CMAKE_OSX_ARCHITECTURES`.
+function(make_arch_only_source out_var source arch)
+  if(arch STREQUAL "x86_64")
+    set(condition "defined(__x86_64__)")
+  else()
+    set(condition "defined(__arm64__) || defined(__aarch64__)")
+  endif()
+
+  get_filename_component(source_path ${source} ABSOLUTE)
+  get_filename_component(source_name ${source} NAME)
+  set(wrapper "${CMAKE_CURRENT_BINARY_DIR}/${arch}_only/${source_name}")
+  file(CONFIGURE OUTPUT ${wrapper}
+    CONTENT "#if ${condition}\n  #include \"${source_path}\"\n#endif\n" @ONLY)
+  set(${out_var} ${wrapper} PARENT_SCOPE)
+endfunction()
+
+# Compiles `source/dsp/dspcore.cpp` for each instruction set, and adds them to `target`.
+# The variant is selected at runtime. See `common/dsp/simddispatch.hpp`.
+function(add_simd_dspcore target)
+  if(APPLE AND CMAKE_OSX_ARCHITECTURES)
+    set(archs ${CMAKE_OSX_ARCHITECTURES})
+  else()
+    set(archs ${CMAKE_SYSTEM_PROCESSOR})
+  endif()
+
+  if(NOT archs MATCHES "x86_64|AMD64")
+    # On aarch64, Neon instructions are enabled by default.
+    target_sources(${target} PRIVATE source/dsp/dspcore.cpp)
+    return()
+  endif()
+
+  set(dspcore_source source/dsp/dspcore.cpp)
+  set(instrset_detect_source ../lib/vcl/instrset_detect.cpp)
+
+  # Universal binary. x86_64 flags are passed with `-Xarch_x86_64`, and the x86_64
+  # variants are empty on arm64. The arm64 slice gets one `dspcore.cpp` in `target`.
+  list(LENGTH archs n_arch)
+  if(APPLE AND n_arch GREATER 1)
+    make_arch_only_source(dspcore_source source/dsp/dspcore.cpp x86_64)
+    make_arch_only_source(instrset_detect_source ../lib/vcl/instrset_detect.cpp x86_64)
+    make_arch_only_source(dspcore_arm64_source source/dsp/dspcore.cpp arm64)
+    target_sources(${target} PRIVATE ${dspcore_arm64_source})
+  endif()
+
+  if(MSVC)
+    set(flags_SSE41 "")
+    set(flags_AVX /arch:AVX)
+    set(flags_AVX2 /arch:AVX2)
+    set(flags_AVX512 /arch:AVX512)
+  else()
+    set(flags_SSE41 -msse4.1)
+    set(flags_AVX -mavx)
+    set(flags_AVX2 -mavx2 -mfma)
+    set(flags_AVX512 -mavx512f -mavx512bw -mavx512dq -mavx512vl -mfma)
+  endif()
+
+  if(APPLE AND n_arch GREATER 1)
+    foreach(instrset SSE41 AVX AVX2 AVX512)
+      list(TRANSFORM flags_${instrset} PREPEND "SHELL:-Xarch_x86_64 ")
+    endforeach()
+  endif()
+
+  # VCL types are put in a namespace per variant, so the templates instantiated on them
+  # don't share mangled names among variants. The rest of `target` is the same as SSE41.
+  target_compile_options(${target} PRIVATE ${flags_SSE41})
+  target_compile_definitions(${target} PRIVATE VCL_NAMESPACE=vcl_SSE41)
+  target_sources(${target} PRIVATE ${instrset_detect_source})
+
+  # Order matters. The linker must see older instruction set first.
+  foreach(instrset SSE41 AVX AVX2 AVX512)
+    set(variant "${target}_dspcore_${instrset}")
+    add_library(${variant} OBJECT ${dspcore_source})
+    target_compile_options(${variant} PRIVATE ${flags_${instrset}})
+    target_compile_definitions(${variant} PRIVATE VCL_NAMESPACE=vcl_${instrset})
+    target_link_libraries(${variant} PRIVATE sdk)
+    set_target_properties(${variant} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+    if(XCODE)
+      target_compile_options(${variant} PRIVATE -fno-aligned-allocation)
+    endif()
+    target_sources(${target} PRIVATE $<TARGET_OBJECTS:${variant}>)
+  endforeach()
 endfunction()
 
 function(build_vst3 plug_sources)
@@ -32,21 +144,15 @@ function(build_vst3 plug_sources)
   set(target ${PLUGIN_NAME})
 
   smtg_add_vst3plugin(${target}
-    source/dsp/dspcore.cpp
     ${plug_sources})
 
   if(MSVC)
     # # Too many warnings are emitted from VST 3 SDK.
-    target_compile_options(${target} PRIVATE /arch:AVX)
   elseif(UNIX)
     if(XCODE)
       target_compile_options(${target} PRIVATE -fno-aligned-allocation)
     else() # Linux branch.
-      if(CMAKE_SYSTEM_PROCESSOR STREQUAL "x86_64")
-        target_compile_options(${target} PRIVATE -mavx)
-      elseif(CMAKE_SYSTEM_PROCESSOR STREQUAL "aarch64")
-      # On aarch64, Neon instructions are enabled by default.
-      else()
+      if(NOT CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|aarch64)$")
         message(FATAL_ERROR "Unsupported CPU architecture.")
       endif()
     endif()
@@ -54,6 +160,7 @@ function(build_vst3 plug_sources)
   endif()
 
   include_directories(../common)
+  add_simd_dspcore(${target})
   target_link_libraries(${target} PRIVATE
     UhhyouCommon
     sdk
@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace SomeDSP {
+
+/**
+Ring buffer for delays. Size is rounded up to a power of 2, so indices wrap with a mask
+instead of a branch.
+
+`at(n)` returns the sample written `n` samples ago. `at(0)` is the last written sample.
+*/
+template<typename Sample> class DelayBuffer {
+private:
+  std::vector<Sample> buf{Sample(0)};
+  size_t mask = 0;
+  size_t wptr = 0;
+
+public:
+  // Not realtime safe. Allocates. `minSize` is the number of samples to be kept.
+  void setup(size_t minSize)
+  {
+    size_t size = 1;
+    while (size < minSize) size <<= 1;
+    buf.resize(size);
+    mask = size - 1;
+    reset();
+  }
+
+  void reset()
+  {
+    std::fill(buf.begin(), buf.end(), Sample(0));
+    wptr = 0;
+  }
+
+  size_t size() const { return buf.size(); }
+
+  void applyGain(Sample gain)
+  {
+    for (auto &x : buf) x *= gain;
+  }
+
+  inline void write(Sample input)
+  {
+    wptr = (wptr + 1) & mask;
+    buf[wptr] = input;
+  }
+
+  void write(const Sample *input, size_t length)
+  {
+    for (size_t i = 0; i < length; ++i) write(input[i]);
+  }
+
+  inline Sample at(size_t n) const { return buf[(wptr - n) & mask]; }
+
+  /**
+  Reads the last written `length` samples delayed by `n`, in the order of writing. Used
+  after `write(input, length)` to get `output[i] = input[i - n]`. `n + length` must be
+  less than or equal to `size()`.
+  */
+  void read(Sample *output, size_t length, size_t n) const
+  {
+    const size_t start = wptr - n - length + 1;
+    for (size_t i = 0; i < length; ++i) output[i] = buf[(start + i) & mask];
+  }
+};
+
+/**
+Interpolators for `Delay`, `MultiTapDelay` and `ParallelDelay`. `read(y, t)` takes
+`nTap` samples `y[k] = at(timeInt - minTime + k)` and the fraction `t` in [0, 1).
+`minTime` is the lower bound of the delay time in samples.
+*/
+struct DelayInterpLinear {
+  static constexpr size_t nTap = 2;
+  static constexpr size_t minTime = 0;
+
+  template<typename Sample>
+  static inline Sample read(const std::array<Sample, nTap> &y, Sample t)
+  {
+    return y[0] + t * (y[1] - y[0]);
+  }
+};
+
+// Catmull-Rom spline. Interpolates between y[1] and y[2].
+struct DelayInterpCubic {
+  static constexpr size_t nTap = 4;
+  static constexpr size_t minTime = 1;
+
+  template<typename Sample>
+  static inline Sample read(const std::array<Sample, nTap> &y, Sample t)
+  {
+    auto t2 = t * t;
+    auto c0 = y[1] - y[2];
+    auto c1 = (y[2] - y[0]) * Sample(0.5);
+    auto c2 = c0 + c1;
+    auto c3 = c0 + c2 + (y[3] - y[1]) * Sample(0.5);
+    return c3 * t * t2 - (c2 + c3) * t2 + c1 * t + y[1];
+  }
+};
+
+// 3rd order Lagrange interpolation. Interpolates between y[1] and y[2].
+struct DelayInterpLagrange3 {
+  static constexpr size_t nTap = 4;
+  static constexpr size_t minTime = 1;
+
+  template<typename Sample>
+  static inline Sample read(const std::array<Sample, nTap> &y, Sample t)
+  {
+    auto u = Sample(1) + t;
+    auto d0 = y[0] - y[1];
+    auto d1 = d0 - (y[1] - y[2]);
+    auto d2 = d1 - ((y[1] - y[2]) - (y[2] - y[3]));
+    return y[0]
+      - u * (d0 + (Sample(1) - u) / Sample(2) * (d1 + (Sample(2) - u) / Sample(3) * d2));
+  }
+};
+
+/**
+Single tap fractional delay. Input is written before read, so the delay time of 0 returns
+the input as is, when the interpolator allows it.
+*/
+template<typename Sample, typename Interp = DelayInterpLinear> class Delay {
+private:
+  DelayBuffer<Sample> buffer;
+  Sample maxTime = 0;
+
+public:
+  // Not realtime safe. Allocates.
+  void setup(Sample maxTimeSamples)
+  {
+    const auto maxInt = size_t(std::max(maxTimeSamples, Sample(0)));
+    buffer.setup(maxInt + Interp::nTap);
+    maxTime = Sample(buffer.size() - Interp::nTap);
+  }
+
+  void reset() { buffer.reset(); }
+  void applyGain(Sample gain) { buffer.applyGain(gain); }
+  void write(Sample input) { buffer.write(input); }
+
+  Sample read(Sample timeInSamples) const
+  {
+    const Sample clamped = std::clamp(timeInSamples, Sample(Interp::minTime), maxTime);
+    const size_t timeInt = size_t(clamped);
+    const Sample fraction = clamped - Sample(timeInt);
+
+    std::array<Sample, Interp::nTap> y;
+    const size_t start = timeInt - Interp::minTime;
+    for (size_t k = 0; k < y.size(); ++k) y[k] = buffer.at(start + k);
+    return Interp::read(y, fraction);
+  }
+
+  Sample process(Sample input, Sample timeInSamples)
+  {
+    buffer.write(input);
+    return read(timeInSamples);
+  }
+
+  // Block process with a fixed integer delay time.
+  void process(const Sample *input, Sample *output, size_t length, size_t timeInSamples)
+  {
+    timeInSamples = std::min(timeInSamples, size_t(maxTime));
+    for (size_t i = 0; i < length;) {
+      const size_t chunk = std::min(length - i, buffer.size() - timeInSamples);
+      buffer.write(input + i, chunk);
+      buffer.read(output + i, chunk, timeInSamples);
+      i += chunk;
+    }
+  }
+};
+
+/**
+Fractional delay with 1st order allpass interpolation. Flat amplitude response, but the
+delay time should not be modulated fast, because the allpass has internal state.
+
+Fraction is kept in [0.5, 1.5) to avoid the pole near -1.
+*/
+template<typename Sample> class AllpassDelay {
+private:
+  DelayBuffer<Sample> buffer;
+  Sample maxTime = 0;
+  Sample x1 = 0;
+  Sample y1 = 0;
+
+public:
+  // Not realtime safe. Allocates.
+  void setup(Sample maxTimeSamples)
+  {
+    const auto maxInt = size_t(std::max(maxTimeSamples, Sample(0)));
+    buffer.setup(maxInt + 2);
+    maxTime = Sample(buffer.size() - 2);
+  }
+
+  void reset()
+  {
+    buffer.reset();
+    x1 = 0;
+    y1 = 0;
+  }
+
+  Sample process(Sample input, Sample timeInSamples)
+  {
+    buffer.write(input);
+
+    const Sample clamped = std::clamp(timeInSamples, Sample(0.5), maxTime);
+    size_t timeInt = size_t(clamped - Sample(0.5));
+    const Sample fraction = clamped - Sample(timeInt);
+    const Sample a = (Sample(1) - fraction) / (Sample(1) + fraction);
+
+    const Sample x0 = buffer.at(timeInt);
+    y1 = a * (x0 - y1) + x1;
+    x1 = x0;
+    return y1;
+  }
+};
+
+/**
+Multiple taps reading from a single buffer.
+*/
+template<typename Sample, size_t nTap, typename Interp = DelayInterpLinear>
+class MultiTapDelay {
+private:
+  Delay<Sample, Interp> delay;
+
+public:
+  // Not realtime safe. Allocates.
+  void setup(Sample maxTimeSamples) { delay.setup(maxTimeSamples); }
+  void reset() { delay.reset(); }
+
+  std::array<Sample, nTap>
+  process(Sample input, const std::array<Sample, nTap> &timeInSamples)
+  {
+    delay.write(input);
+    std::array<Sample, nTap> output;
+    for (size_t i = 0; i < nTap; ++i) output[i] = delay.read(timeInSamples[i]);
+    return output;
+  }
+};
+
+/**
+`nChannel` delays sharing a buffer with interleaved layout. The write is a contiguous
+store of a frame, and the index and interpolation computations are laid out as separate
+loops over channels, so the compiler can vectorize them.
+
+Intended for FDN and other structures which process many delays in lockstep.
+*/
+template<typename Sample, size_t nChannel, typename Interp = DelayInterpLinear>
+class ParallelDelay {
+private:
+  using Frame = std::array<Sample, nChannel>;
+
+  std::vector<Frame> buf{Frame{}};
+  size_t mask = 0;
+  size_t wptr = 0;
+  Sample maxTime = 0;
+
+public:
+  // Not realtime safe. Allocates.
+  void setup(Sample maxTimeSamples)
+  {
+    const auto minSize = size_t(std::max(maxTimeSamples, Sample(0))) + Interp::nTap;
+    size_t size = 1;
+    while (size < minSize) size <<= 1;
+    buf.resize(size);
+    mask = size - 1;
+    maxTime = Sample(size - Interp::nTap);
+    reset();
+  }
+
+  void reset()
+  {
+    std::fill(buf.begin(), buf.end(), Frame{});
+    wptr = 0;
+  }
+
+  Frame process(const Frame &input, const Frame &timeInSamples)
+  {
+    wptr = (wptr + 1) & mask;
+    buf[wptr] = input;
+
+    std::array<size_t, nChannel> timeInt;
+    Frame fraction;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      const Sample clamped
+        = std::clamp(timeInSamples[ch], Sample(Interp::minTime), maxTime);
+      timeInt[ch] = size_t(clamped);
+      fraction[ch] = clamped - Sample(timeInt[ch]);
+    }
+
+    std::array<Frame, Interp::nTap> y;
+    for (size_t k = 0; k < Interp::nTap; ++k) {
+      for (size_t ch = 0; ch < nChannel; ++ch) {
+        y[k][ch] = buf[(wptr - timeInt[ch] + Interp::minTime - k) & mask][ch];
+      }
+    }
+
+    Frame output;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      std::array<Sample, Interp::nTap> tap;
+      for (size_t k = 0; k < Interp::nTap; ++k) tap[k] = y[k][ch];
+      output[ch] = Interp::read(tap, fraction[ch]);
+    }
+    return output;
+  }
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace SomeDSP {
+
+/**
+Fixed capacity ring buffer of events sorted by `Event::frame`.
+
+Replacement of `std::vector` + `std::find_if` + `erase` for MIDI notes. Both ends are
+used on the audio thread, so there are no locks nor atomics. No allocation after
+construction.
+
+- `push()` is O(1) when events arrive in frame order, which is the usual case. An out of
+  order event is inserted by shifting later events. Events on the same frame keep the
+  order of `push()`.
+- `pop(frame, event)` is O(1). It takes out the oldest event at or before `frame`.
+- When full, `push()` drops the event and returns false.
+
+`capacity` must be a power of 2.
+*/
+template<typename Event, size_t capacity = 1024> class FrameEventQueue {
+private:
+  static_assert(
+    capacity > 0 && (capacity & (capacity - 1)) == 0, "capacity must be power of 2.");
+
+  static constexpr size_t mask = capacity - 1;
+
+  std::array<Event, capacity> buf{};
+  size_t head = 0;
+  size_t count = 0;
+
+  inline Event &at(size_t index) { return buf[(head + index) & mask]; }
+
+public:
+  inline size_t size() const { return count; }
+  inline bool empty() const { return count == 0; }
+
+  inline void clear()
+  {
+    head = 0;
+    count = 0;
+  }
+
+  bool push(const Event &event)
+  {
+    if (count >= capacity) return false;
+
+    size_t index = count;
+    while (index > 0 && event.frame < at(index - 1).frame) {
+      at(index) = at(index - 1);
+      --index;
+    }
+    at(index) = event;
+    ++count;
+    return true;
+  }
+
+  template<typename Frame> inline bool pop(Frame frame, Event &event)
+  {
+    if (count == 0 || buf[head].frame > frame) return false;
+    event = buf[head];
+    head = (head + 1) & mask;
+    --count;
+    return true;
+  }
+};
+
+} // namespace SomeDSP
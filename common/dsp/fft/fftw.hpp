@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "../../../lib/fftw3/fftw3.h"
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace SomeDSP {
+
+/**
+FFTW3 plans shared by all instances of a plugin binary.
+
+FFTW3 isn't thread safe except `fftwf_execute*`, so planning, allocation and wisdom are
+serialized by the mutex of this cache. Plans are shared per (kind, size, data layout), and
+destroyed at exit. Instances never destroy them.
+
+Shared plans must be executed with the new-array functions, `fftwExecute` below, on the
+arrays of the same layout as the ones given to `getR2C` or `getC2R`. Arrays allocated by
+`allocate` all have the same alignment. Plans are made with `FFTW_ESTIMATE`, which
+doesn't touch the arrays.
+
+`importWisdom` is optional. Wisdom made with more rigorous flags, like `FFTW_MEASURE`,
+is also used for `FFTW_ESTIMATE` plans made after the import.
+*/
+class FFTWPlanCache {
+public:
+  static FFTWPlanCache &instance()
+  {
+    static FFTWPlanCache cache;
+    return cache;
+  }
+
+  fftwf_plan getR2C(int size, float *in, std::complex<float> *out)
+  {
+    return get(Kind::r2c, size, in, reinterpret_cast<float *>(out));
+  }
+
+  fftwf_plan getC2R(int size, std::complex<float> *in, float *out)
+  {
+    return get(Kind::c2r, size, reinterpret_cast<float *>(in), out);
+  }
+
+  fftwf_plan getC2R(int size, fftwf_complex *in, float *out)
+  {
+    return get(Kind::c2r, size, reinterpret_cast<float *>(in), out);
+  }
+
+  template<typename T> T *allocate(size_t count)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<T *>(fftwf_malloc(sizeof(T) * count));
+  }
+
+  void free(void *ptr)
+  {
+    if (ptr == nullptr) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    fftwf_free(ptr);
+  }
+
+  bool importWisdom(const char *path)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fftwf_import_wisdom_from_filename(path) != 0;
+  }
+
+  bool exportWisdom(const char *path)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fftwf_export_wisdom_to_filename(path) != 0;
+  }
+
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return plans.size();
+  }
+
+private:
+  enum class Kind { r2c, c2r };
+
+  // (kind, size, is in-place, input alignment, output alignment).
+  using Key = std::tuple<Kind, int, bool, int, int>;
+
+  std::mutex mutex;
+  std::map<Key, fftwf_plan> plans;
+
+  FFTWPlanCache() = default;
+
+  ~FFTWPlanCache()
+  {
+    for (auto &[key, plan] : plans) fftwf_destroy_plan(plan);
+  }
+
+  FFTWPlanCache(const FFTWPlanCache &) = delete;
+  FFTWPlanCache &operator=(const FFTWPlanCache &) = delete;
+
+  fftwf_plan get(Kind kind, int size, float *in, float *out)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Key key{kind, size, in == out, fftwf_alignment_of(in), fftwf_alignment_of(out)};
+    auto found = plans.find(key);
+    if (found != plans.end()) return found->second;
+
+    fftwf_plan plan = kind == Kind::r2c
+      ? fftwf_plan_dft_r2c_1d(
+          size, in, reinterpret_cast<fftwf_complex *>(out), FFTW_ESTIMATE)
+      : fftwf_plan_dft_c2r_1d(
+          size, reinterpret_cast<fftwf_complex *>(in), out, FFTW_ESTIMATE);
+    plans.emplace(key, plan);
+    return plan;
+  }
+};
+
+inline void fftwExecute(fftwf_plan plan, float *in, std::complex<float> *out)
+{
+  fftwf_execute_dft_r2c(plan, in, reinterpret_cast<fftwf_complex *>(out));
+}
+
+// Input is destroyed. This is the default of FFTW3 for complex to real transform.
+inline void fftwExecute(fftwf_plan plan, std::complex<float> *in, float *out)
+{
+  fftwf_execute_dft_c2r(plan, reinterpret_cast<fftwf_complex *>(in), out);
+}
+
+inline void fftwExecute(fftwf_plan plan, fftwf_complex *in, float *out)
+{
+  fftwf_execute_dft_c2r(plan, in, out);
+}
+
+} // namespace SomeDSP
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#ifdef UHHYOU_FFT_BACKEND_FFTW
+  #include "fftw.hpp"
+#else
+  #ifndef POCKETFFT_NO_MULTITHREADING
+    #define POCKETFFT_NO_MULTITHREADING
+  #endif
+  #include "../../../lib/pocketfft/pocketfft_hdronly.h"
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace SomeDSP {
+
+/**
+1D real FFT with selectable backend.
+
+- Default is pocketfft. Each instance owns its plan and scratch buffer, so nothing is
+  shared between instances. pocketfft still allocates a work array in each transform.
+- Define `UHHYOU_FFT_BACKEND_FFTW` to use FFTW3 through `FFTWPlanCache`. Only `float` is
+  available, because only single precision FFTW3 is linked. Buffers that don't have the
+  alignment of `fftwf_malloc` are copied to internal buffers. `forward` and `inverse`
+  don't allocate.
+
+`setup` allocates. `inverse` is scaled by `1 / size`, so `inverse(forward(x)) == x`.
+*/
+template<typename T> class RealFFT {
+public:
+  size_t size() const { return length; }
+  size_t spectrumSize() const { return length / 2 + 1; }
+
+#ifdef UHHYOU_FFT_BACKEND_FFTW
+  static_assert(std::is_same_v<T, float>, "RealFFT: FFTW backend only supports float.");
+
+  RealFFT() = default;
+  RealFFT(const RealFFT &) = delete;
+  RealFFT &operator=(const RealFFT &) = delete;
+
+  ~RealFFT()
+  {
+    auto &cache = FFTWPlanCache::instance();
+    cache.free(bufReal);
+    cache.free(bufSpectrum);
+  }
+
+  void setup(size_t size)
+  {
+    auto &cache = FFTWPlanCache::instance();
+    cache.free(bufReal);
+    cache.free(bufSpectrum);
+
+    length = size;
+    bufReal = cache.allocate<float>(length);
+    bufSpectrum = cache.allocate<std::complex<float>>(spectrumSize());
+    forwardPlan = cache.getR2C(int(length), bufReal, bufSpectrum);
+    inversePlan = cache.getC2R(int(length), bufSpectrum, bufReal);
+  }
+
+  void forward(const T *in, std::complex<T> *out)
+  {
+    std::copy(in, in + length, bufReal);
+    if (isAligned(out)) {
+      fftwExecute(forwardPlan, bufReal, out);
+    } else {
+      fftwExecute(forwardPlan, bufReal, bufSpectrum);
+      std::copy(bufSpectrum, bufSpectrum + spectrumSize(), out);
+    }
+  }
+
+  void inverse(const std::complex<T> *in, T *out)
+  {
+    std::copy(in, in + spectrumSize(), bufSpectrum);
+    if (isAligned(out)) {
+      fftwExecute(inversePlan, bufSpectrum, out);
+    } else {
+      fftwExecute(inversePlan, bufSpectrum, bufReal);
+      std::copy(bufReal, bufReal + length, out);
+    }
+    const T scale = T(1) / T(length);
+    for (size_t idx = 0; idx < length; ++idx) out[idx] *= scale;
+  }
+
+private:
+  template<typename U> bool isAligned(U *ptr)
+  {
+    return fftwf_alignment_of(reinterpret_cast<float *>(ptr)) == 0;
+  }
+
+  size_t length = 0;
+  float *bufReal = nullptr;
+  std::complex<float> *bufSpectrum = nullptr;
+  fftwf_plan forwardPlan = nullptr;
+  fftwf_plan inversePlan = nullptr;
+
+#else
+  void setup(size_t size)
+  {
+    if (plan && length == size) return;
+    length = size;
+    plan = std::make_unique<pocketfft::detail::pocketfft_r<T>>(length);
+    buffer.resize(length);
+  }
+
+  // `buffer` is in half complex order of FFTPACK: `[r0, r1, i1, r2, i2, ...]`. When
+  // `length` is even, the last element is the real part of Nyquist frequency.
+  void forward(const T *in, std::complex<T> *out)
+  {
+    std::copy(in, in + length, buffer.begin());
+    plan->exec(buffer.data(), T(1), true);
+
+    out[0] = {buffer[0], T(0)};
+    size_t idx = 1;
+    size_t bin = 1;
+    for (; idx + 1 < length; idx += 2, ++bin) out[bin] = {buffer[idx], buffer[idx + 1]};
+    if (idx < length) out[bin] = {buffer[idx], T(0)};
+  }
+
+  void inverse(const std::complex<T> *in, T *out)
+  {
+    buffer[0] = in[0].real();
+    size_t idx = 1;
+    size_t bin = 1;
+    for (; idx + 1 < length; idx += 2, ++bin) {
+      buffer[idx] = in[bin].real();
+      buffer[idx + 1] = in[bin].imag();
+    }
+    if (idx < length) buffer[idx] = in[bin].real();
+
+    plan->exec(buffer.data(), T(1) / T(length), false);
+    std::copy(buffer.begin(), buffer.end(), out);
+  }
+
+private:
+  size_t length = 0;
+  std::unique_ptr<pocketfft::detail::pocketfft_r<T>> plan;
+  std::vector<T> buffer;
+#endif
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "../constants.hpp"
+#include "../multirate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace SomeDSP {
+
+enum class OversamplingQuality {
+  iir, // Minimum phase. Low CPU, no constant latency.
+  fir, // Linear phase. More CPU, latency is fixed.
+};
+
+/**
+2x up and down sampler with polyphase allpass halfband filter. Uses the same coefficients
+as `HalfBandIIR`.
+*/
+template<typename Sample> class HalfBandIirStage {
+private:
+  using Coefficient = HalfBandCoefficient<Sample>;
+
+  std::array<FirstOrderAllpass<Sample>, Coefficient::h0_a.size()> up0;
+  std::array<FirstOrderAllpass<Sample>, Coefficient::h1_a.size()> up1;
+  HalfBandIIR<Sample, Coefficient> decimator;
+
+public:
+  // Group delay at DC in the samples of higher rate. Up or down, one way.
+  static double latency()
+  {
+    auto delay = [](const auto &coefficient) {
+      double sum = 0;
+      for (const auto &a : coefficient) sum += 2 * (1 - double(a)) / (1 + double(a));
+      return sum;
+    };
+    return 0.5 * (delay(Coefficient::h0_a) + delay(Coefficient::h1_a) + 1);
+  }
+
+  void reset()
+  {
+    for (auto &ap : up0) ap.reset();
+    for (auto &ap : up1) ap.reset();
+    decimator.reset();
+  }
+
+  // `output` has `2 * length` samples.
+  void up(const Sample *input, size_t length, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) {
+      Sample s0 = input[i];
+      for (size_t j = 0; j < up1.size(); ++j) {
+        s0 = up1[j].process(s0, Coefficient::h1_a[j]);
+      }
+      Sample s1 = input[i];
+      for (size_t j = 0; j < up0.size(); ++j) {
+        s1 = up0[j].process(s1, Coefficient::h0_a[j]);
+      }
+      output[2 * i] = s0;
+      output[2 * i + 1] = s1;
+    }
+  }
+
+  // `input` has `2 * length` samples.
+  void down(const Sample *input, size_t length, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) {
+      output[i] = decimator.process({input[2 * i], input[2 * i + 1]});
+    }
+  }
+};
+
+/**
+2x up and down sampler with linear phase halfband FIR. Windowed sinc with Kaiser window.
+
+The filter has `4 * nSideTap - 1` taps. Only the center tap and the taps at odd offset
+from the center are non-zero, so the polyphase form only computes `2 * nSideTap` taps for
+each output. History is a double length ring buffer to keep the taps contiguous.
+*/
+template<typename Sample> class HalfBandFirStage {
+private:
+  std::vector<Sample> co;      // Non-zero side taps, `2 * nSideTap`.
+  std::vector<Sample> upBuf;   // Input history of `up`.
+  std::vector<Sample> downBuf; // Even phase history of `down`.
+  std::vector<Sample> oddBuf;  // Odd phase history of `down`, delayed by `nSideTap`.
+  size_t nSideTap = 0;
+  size_t upPos = 0;
+  size_t downPos = 0;
+  size_t oddPos = 0;
+
+  static double besselI0(double x)
+  {
+    double sum = 1;
+    double term = 1;
+    for (int k = 1; k < 64; ++k) {
+      term *= x / (2 * k);
+      const double t2 = term * term;
+      sum += t2;
+      if (t2 < sum * 1e-17) break;
+    }
+    return sum;
+  }
+
+  inline void pushRing(std::vector<Sample> &buf, size_t &pos, Sample x)
+  {
+    const size_t len = buf.size() / 2;
+    pos = pos == 0 ? len - 1 : pos - 1;
+    buf[pos] = x;
+    buf[pos + len] = x;
+  }
+
+  inline Sample dot(const Sample *history) const
+  {
+    Sample sum = 0;
+    for (size_t n = 0; n < co.size(); ++n) sum += co[n] * history[n];
+    return sum;
+  }
+
+public:
+  // Not realtime safe. Allocates.
+  void setup(size_t nSideTap, double beta = 8.0)
+  {
+    this->nSideTap = std::max<size_t>(nSideTap, 1);
+
+    const size_t nTap = 4 * this->nSideTap - 1;
+    const double center = double(nTap / 2);
+    co.resize(2 * this->nSideTap);
+    for (size_t j = 0; j < co.size(); ++j) {
+      const double t = double(2 * j) - center; // Always odd.
+      const double r = double(2 * j) / double(nTap - 1) * 2 - 1;
+      const double window
+        = besselI0(beta * std::sqrt(std::max(0.0, 1 - r * r))) / besselI0(beta);
+      co[j] = Sample(std::sin(pi * t / 2) / (pi * t) * window);
+    }
+    const Sample sum = std::accumulate(co.begin(), co.end(), Sample(0));
+    for (auto &value : co) value *= Sample(0.5) / sum;
+
+    upBuf.resize(2 * co.size());
+    downBuf.resize(2 * co.size());
+    oddBuf.resize(2 * (this->nSideTap + 1));
+    reset();
+  }
+
+  // Delay in the samples of higher rate. Up or down, one way.
+  double latency() const { return double(2 * nSideTap - 1); }
+
+  void reset()
+  {
+    std::fill(upBuf.begin(), upBuf.end(), Sample(0));
+    std::fill(downBuf.begin(), downBuf.end(), Sample(0));
+    std::fill(oddBuf.begin(), oddBuf.end(), Sample(0));
+    upPos = 0;
+    downPos = 0;
+    oddPos = 0;
+  }
+
+  // `output` has `2 * length` samples.
+  void up(const Sample *input, size_t length, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) {
+      pushRing(upBuf, upPos, input[i]);
+      output[2 * i] = Sample(2) * dot(upBuf.data() + upPos);
+      output[2 * i + 1] = upBuf[upPos + nSideTap - 1];
+    }
+  }
+
+  // `input` has `2 * length` samples.
+  void down(const Sample *input, size_t length, Sample *output)
+  {
+    for (size_t i = 0; i < length; ++i) {
+      pushRing(downBuf, downPos, input[2 * i]);
+      pushRing(oddBuf, oddPos, input[2 * i + 1]);
+      output[i] = dot(downBuf.data() + downPos) + Sample(0.5) * oddBuf[oddPos + nSideTap];
+    }
+  }
+};
+
+/**
+Oversampler with runtime selectable factor and quality. Factor is a power of 2 from 1 to
+`maxFold`, and made of cascaded 2x stages.
+
+Usage in `process`:
+
+```
+auto buffer = oversampler.up(input, length); // `length * oversampler.fold()` samples.
+for (size_t i = 0; i < length * oversampler.fold(); ++i) buffer[i] = f(buffer[i]);
+oversampler.down(output, length);
+```
+
+`length` must be less than or equal to `maxBlockSize` given to `setup`. `input` and
+`output` can be the same array.
+
+FIR stages near the base rate use longer filters, because the band to reject gets wider
+relative to the rate as the rate goes up.
+*/
+template<typename Sample> class Oversampler {
+public:
+  static constexpr size_t maxStage = 6;
+  static constexpr size_t maxFold = size_t(1) << maxStage;
+  static constexpr std::array<size_t, maxStage> firSideTap{16, 8, 6, 4, 4, 4};
+
+private:
+  std::array<HalfBandIirStage<Sample>, maxStage> iirStage;
+  std::array<HalfBandFirStage<Sample>, maxStage> firStage;
+  std::array<std::vector<Sample>, 2> buffer;
+  size_t nStage = 0;
+  OversamplingQuality quality = OversamplingQuality::iir;
+  size_t outIndex = 0; // Index of `buffer` which holds the oversampled signal.
+
+public:
+  // Not realtime safe. Allocates.
+  void setup(size_t maxBlockSize)
+  {
+    for (size_t idx = 0; idx < maxStage; ++idx) firStage[idx].setup(firSideTap[idx]);
+    for (auto &buf : buffer) buf.resize(maxBlockSize * maxFold);
+    reset();
+  }
+
+  // Realtime safe. Resets the filters only when changed. `fold` is rounded down to a
+  // power of 2.
+  void set(size_t fold, OversamplingQuality quality)
+  {
+    size_t newStage = 0;
+    while (newStage < maxStage && (size_t(2) << newStage) <= fold) ++newStage;
+    if (newStage == nStage && quality == this->quality) return;
+    nStage = newStage;
+    this->quality = quality;
+    reset();
+  }
+
+  void reset()
+  {
+    for (auto &stage : iirStage) stage.reset();
+    for (auto &stage : firStage) stage.reset();
+  }
+
+  size_t fold() const { return size_t(1) << nStage; }
+  OversamplingQuality getQuality() const { return quality; }
+
+  // Oversampled buffer. A generator like synthesizer can write `length * fold()` samples
+  // here, then call `down` without `up`.
+  Sample *data() { return buffer[outIndex].data(); }
+
+  // Round trip latency of `up` and `down` in the samples of base rate. For IIR, it's the
+  // group delay at DC.
+  double latency() const
+  {
+    double sum = 0;
+    for (size_t idx = 0; idx < nStage; ++idx) {
+      const double stageLatency = quality == OversamplingQuality::fir
+        ? firStage[idx].latency()
+        : HalfBandIirStage<Sample>::latency();
+      sum += 2 * stageLatency / double(size_t(2) << idx);
+    }
+    return sum;
+  }
+
+  Sample *up(const Sample *input, size_t length)
+  {
+    outIndex = 0;
+    std::copy(input, input + length, buffer[0].data());
+    for (size_t idx = 0; idx < nStage; ++idx) {
+      auto src = buffer[outIndex].data();
+      auto dst = buffer[outIndex ^ 1].data();
+      if (quality == OversamplingQuality::fir) {
+        firStage[idx].up(src, length << idx, dst);
+      } else {
+        iirStage[idx].up(src, length << idx, dst);
+      }
+      outIndex ^= 1;
+    }
+    return buffer[outIndex].data();
+  }
+
+  void down(Sample *output, size_t length)
+  {
+    for (size_t idx = nStage; idx-- > 0;) {
+      auto src = buffer[outIndex].data();
+      auto dst = buffer[outIndex ^ 1].data();
+      if (quality == OversamplingQuality::fir) {
+        firStage[idx].down(src, length << idx, dst);
+      } else {
+        iirStage[idx].down(src, length << idx, dst);
+      }
+      outIndex ^= 1;
+    }
+    std::copy(buffer[outIndex].data(), buffer[outIndex].data() + length, output);
+  }
+
+  // Per sample shorthand of `up`, `func` on each oversampled sample, and `down`.
+  template<typename Func> Sample process(Sample input, Func func)
+  {
+    auto buf = up(&input, 1);
+    for (size_t i = 0; i < fold(); ++i) buf[i] = func(buf[i]);
+    down(&input, 1);
+    return input;
+  }
+};
+
+} // namespace SomeDSP
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace SomeDSP {
+
+// -120 dB. Signal below this level is treated as silence.
+constexpr double silenceThreshold = 1e-6;
+
+constexpr size_t infiniteTail = std::numeric_limits<size_t>::max();
+
+/**
+Returns the number of samples until the output of a feedback loop falls below
+`silenceThreshold` after the input stops.
+
+- `loopSamples`: Length of a round trip of the loop in samples.
+- `feedback`: Gain of a round trip. Sign is ignored.
+- `peak`: Upper bound of the amplitude in the loop when the input stops.
+
+One more round trip is added for the signal which is still travelling the loop. Returns
+`infiniteTail` when `|feedback| >= 1`.
+*/
+template<typename T>
+inline size_t feedbackTailLength(T loopSamples, T feedback, T peak = T(1))
+{
+  loopSamples = std::max(loopSamples, T(0));
+  feedback = std::abs(feedback);
+  if (!(feedback < T(1))) return infiniteTail;
+
+  double nLoop = 0;
+  if (feedback > T(0) && peak > T(silenceThreshold)) {
+    nLoop = std::ceil(
+      std::log(silenceThreshold / double(peak)) / std::log(double(feedback)));
+  }
+
+  double length = std::ceil((nLoop + 1) * double(loopSamples));
+  if (!(length < double(infiniteTail))) return infiniteTail;
+  return size_t(length);
+}
+
+} // namespace SomeDSP
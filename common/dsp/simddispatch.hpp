@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "../../lib/vcl.hpp"
+
+/**
+Runtime dispatch of DSP code compiled for several instruction sets.
+
+`dspcore.cpp` is compiled once for each instruction set with different compiler flags.
+See `add_simd_dspcore` in `common/cmake/simd_x86_64_and_aarch64.cmake`. Names that
+contain SIMD types are suffixed by `UHHYOU_INSTRSET_NAME`, which is selected from
+`INSTRSET` of VCL. So the definitions in each variant don't collide.
+
+- x86_64: `SSE41`, `AVX`, `AVX2` (with FMA), `AVX512` (AVX512F/BW/DQ/VL).
+- aarch64: `NEON` only. VCL runs on sse2neon.
+
+`SSE41` is the baseline. It's also used for the translation units outside of the
+variants, and for tests. On MSVC, it's compiled with the default flags (SSE2).
+
+VCL is compiled in `VCL_NAMESPACE`, which is `vcl_<INSTRSET>` for each variant. So the
+types like `Vec16f`, and the templates instantiated on them, have different mangled names
+in each variant. Tests don't define `VCL_NAMESPACE`, and VCL stays in global namespace.
+
+Inline functions without SIMD types, like the ones in standard library, are still shared
+among variants. The linker picks the first definition, so the object files are linked
+from the oldest instruction set to the newest. This way a variant never calls the code
+compiled for newer instruction set.
+*/
+
+#if defined(__arm64__) || defined(__aarch64__)
+  #define UHHYOU_INSTRSET_NAME NEON
+#elif INSTRSET >= 10
+  #define UHHYOU_INSTRSET_NAME AVX512
+#elif INSTRSET >= 8
+  #define UHHYOU_INSTRSET_NAME AVX2
+#elif INSTRSET >= 7
+  #define UHHYOU_INSTRSET_NAME AVX
+#else
+  #define UHHYOU_INSTRSET_NAME SSE41
+#endif
+
+#define UHHYOU_SIMD_CONCAT_IMPL(A, B) A##B
+#define UHHYOU_SIMD_CONCAT(A, B) UHHYOU_SIMD_CONCAT_IMPL(A, B)
+#define UHHYOU_SIMD_APPLY_IMPL(MACRO, INSTRSET) MACRO(INSTRSET)
+
+// `UHHYOU_SIMD_NAME(DSPCore_)` becomes `DSPCore_AVX2` when compiled with AVX2.
+#define UHHYOU_SIMD_NAME(PREFIX) UHHYOU_SIMD_CONCAT(PREFIX, UHHYOU_INSTRSET_NAME)
+
+// Expands `MACRO(AVX2)` when compiled with AVX2. For `DSPCORE_CLASS(INSTRSET)` etc.
+#define UHHYOU_SIMD_APPLY(MACRO) UHHYOU_SIMD_APPLY_IMPL(MACRO, UHHYOU_INSTRSET_NAME)
+
+// For `inline namespace`. Wraps the headers that define classes with SIMD members.
+#define UHHYOU_SIMD_NAMESPACE UHHYOU_SIMD_NAME(simd_)
+
+namespace SomeDSP {
+
+enum class InstrSet { SSE41, AVX, AVX2, AVX512, NEON };
+
+// `instrset_detect()` is in `VCL_NAMESPACE`, so this function is also made per variant.
+// Only the one outside of the variants is called, and `instrset_detect.cpp` is compiled
+// there.
+inline namespace UHHYOU_SIMD_NAMESPACE {
+
+// Returns the newest instruction set among the variants, which runs on current CPU.
+inline InstrSet detectInstrSet()
+{
+#if defined(__arm64__) || defined(__aarch64__)
+  return InstrSet::NEON;
+#else
+  static const InstrSet instrSet = []() {
+    auto iset = instrset_detect();
+    if (iset >= 10) return InstrSet::AVX512;
+    if (iset >= 8 && hasFMA3()) return InstrSet::AVX2;
+    if (iset >= 7) return InstrSet::AVX;
+    return InstrSet::SSE41;
+  }();
+  return instrSet;
+#endif
+}
+
+} // namespace UHHYOU_SIMD_NAMESPACE
+} // namespace SomeDSP
+
+/**
+Declares `RETURN FACTORY<INSTRSET>()` for all variants. Each variant defines its own
+with `UHHYOU_SIMD_NAME(FACTORY)`.
+
+`UHHYOU_SIMD_DISPATCH(FACTORY)` calls the one selected by `detectInstrSet()`.
+*/
+#if defined(__arm64__) || defined(__aarch64__)
+  #define UHHYOU_SIMD_DECLARE_FACTORY(RETURN, FACTORY) RETURN FACTORY##NEON();
+
+  #define UHHYOU_SIMD_DISPATCH(FACTORY) FACTORY##NEON()
+#else
+  #define UHHYOU_SIMD_DECLARE_FACTORY(RETURN, FACTORY)                                   \
+    RETURN FACTORY##SSE41();                                                             \
+    RETURN FACTORY##AVX();                                                               \
+    RETURN FACTORY##AVX2();                                                              \
+    RETURN FACTORY##AVX512();
+
+  #define UHHYOU_SIMD_DISPATCH(FACTORY)                                                  \
+    [&]() {                                                                              \
+      switch (SomeDSP::detectInstrSet()) {                                               \
+        case SomeDSP::InstrSet::AVX512:                                                  \
+          return FACTORY##AVX512();                                                      \
+        case SomeDSP::InstrSet::AVX2:                                                    \
+          return FACTORY##AVX2();                                                        \
+        case SomeDSP::InstrSet::AVX:                                                     \
+          return FACTORY##AVX();                                                         \
+        default:                                                                         \
+          return FACTORY##SSE41();                                                       \
+      }                                                                                  \
+    }()
+#endif
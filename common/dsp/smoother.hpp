@@ -9,6 +9,7 @@
 #include <array>
 #include <cmath>
 #include <limits>
+#include <utility>
 
 namespace SomeDSP {
 
@@ -92,38 +93,150 @@ public:
   }
 };
 
-template<typename Sample> class SmootherCommon {
+/**
+Parameters shared by the smoothers of a DSPCore instance.
+
+Each DSPCore owns its own context, and passes it to its smoothers on construction. This
+way, instances running at different sample rates, or on different threads, never write to
+shared state. Smoothers have no default constructor, so a smoother without a context is a
+compile error.
+*/
+template<typename Sample> class SmootherContext {
 public:
-  static void setSampleRate(Sample _sampleRate, Sample time = 0.04)
+  void setSampleRate(Sample _sampleRate, Sample time = 0.04)
   {
     sampleRate = _sampleRate;
     setTime(time);
   }
 
-  static void setTime(Sample seconds)
+  void setTime(Sample seconds)
   {
     timeInSamples = seconds * sampleRate;
     kp = Sample(EMAFilter<double>::cutoffToP(
       sampleRate, std::clamp<double>(1.0 / seconds, 0.0, sampleRate / 2.0)));
   }
-  static void setBufferSize(Sample _bufferSize) { bufferSize = _bufferSize; }
+  void setBufferSize(Sample _bufferSize) { bufferSize = _bufferSize; }
 
-  static Sample sampleRate;
-  static Sample timeInSamples;
-  static Sample kp;
-  static Sample bufferSize;
+  Sample sampleRate = 44100.0;
+  Sample timeInSamples = 0.0;
+  Sample kp = 1.0;
+  Sample bufferSize = 44100.0;
 };
 
-template<typename Sample> Sample SmootherCommon<Sample>::sampleRate = 44100.0;
-template<typename Sample> Sample SmootherCommon<Sample>::timeInSamples = 0.0;
-template<typename Sample> Sample SmootherCommon<Sample>::kp = 1.0;
-template<typename Sample> Sample SmootherCommon<Sample>::bufferSize = 44100.0;
+/**
+Returns `std::array<T, size>` where all elements are constructed from `context`. Intended
+for arrays of smoothers, or arrays of classes holding smoothers.
+*/
+template<typename T, size_t size, typename Context>
+inline std::array<T, size> makeSmootherArray(const Context &context)
+{
+  return [&]<size_t... index>(std::index_sequence<index...>) {
+    return std::array<T, size>{((void)index, T(context))...};
+  }(std::make_index_sequence<size>{});
+}
+
+/**
+Closed form ramps for `processBlock` of smoothers.
+
+`processBlock(dest, length)` writes the next `length` outputs of `process()` into `dest`.
+Each output is computed from the state at the start of the block, so there's no loop
+carried dependency, and the inner loops can be vectorized. Results may differ from
+`process()` by rounding.
+
+When the value has already converged, `dest` is filled by a constant.
+*/
+namespace SmootherBlock {
+
+constexpr size_t nLane = 8;
+
+// Fills `dest[i] = target - (target - value) * (1 - kp)^(i + 1)`. Returns last value.
+template<typename Sample>
+inline Sample fillExp(Sample *dest, size_t length, Sample value, Sample target, Sample kp)
+{
+  if (length == 0) return value;
+  if (value == target) {
+    std::fill(dest, dest + length, target);
+    return target;
+  }
+
+  const Sample decay = Sample(1) - kp;
+  std::array<Sample, nLane> gain;
+  gain[0] = decay;
+  for (size_t k = 1; k < nLane; ++k) gain[k] = gain[k - 1] * decay;
+  const Sample stride = gain[nLane - 1];
+  const Sample diff = target - value;
+
+  size_t i = 0;
+  for (; i + nLane <= length; i += nLane) {
+    for (size_t k = 0; k < nLane; ++k) dest[i + k] = target - diff * gain[k];
+    for (size_t k = 0; k < nLane; ++k) gain[k] *= stride;
+  }
+  for (size_t k = 0; i < length; ++i, ++k) dest[i] = target - diff * gain[k];
+  return dest[length - 1];
+}
+
+// Fills `dest[i] = value + ramp * (i + 1)`, clipped at `target`. Outputs closer to
+// `target` than `threshold` are snapped. Returns last value.
+template<typename Sample>
+inline Sample fillLinear(
+  Sample *dest, size_t length, Sample value, Sample target, Sample ramp, Sample threshold)
+{
+  if (length == 0) return value;
+  if (value == target || ramp == 0) {
+    std::fill(dest, dest + length, value);
+    return value;
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    Sample v = value + ramp * Sample(i + 1);
+    v = ramp > 0 ? std::min(v, target) : std::max(v, target);
+    dest[i] = std::fabs(v - target) < threshold ? target : v;
+  }
+  return dest[length - 1];
+}
+
+// `fillLinear` on a circle of circumference `max`. `ramp` takes the direction to reach
+// `target`, which may go through the wrap around point. Returns last value.
+template<typename Sample>
+inline Sample fillRotary(
+  Sample *dest,
+  size_t length,
+  Sample value,
+  Sample target,
+  Sample ramp,
+  Sample max,
+  Sample threshold)
+{
+  if (length == 0) return value;
+  if (value == target || ramp == 0) {
+    std::fill(dest, dest + length, value);
+    return value;
+  }
+
+  // Remaining distance along the direction of `ramp`, in [0, max).
+  Sample distance = ramp > 0 ? target - value : value - target;
+  distance -= max * std::floor(distance / max);
+  const Sample stopAt = distance - threshold;
+  const Sample absRamp = std::fabs(ramp);
+
+  for (size_t i = 0; i < length; ++i) {
+    const Sample n = Sample(i + 1);
+    Sample v = value + ramp * n;
+    v -= max * std::floor(v / max);
+    dest[i] = absRamp * n >= stopAt ? target : v;
+  }
+  return dest[length - 1];
+}
+
+} // namespace SmootherBlock
 
 template<typename Sample> class ExpSmoother {
 public:
   Sample value = 0;
   Sample target = 0;
 
+  explicit ExpSmoother(const SmootherContext<Sample> &context) : context(&context) {}
+
   inline Sample getValue() { return value; }
 
   void reset(Sample value = 0)
@@ -137,7 +250,15 @@ public:
   // Intended to be used after `push`.
   void catchUp() { value = target; }
 
-  Sample process() { return value += SmootherCommon<Sample>::kp * (target - value); }
+  Sample process() { return value += context->kp * (target - value); }
+
+  void processBlock(Sample *dest, size_t length)
+  {
+    value = SmootherBlock::fillExp(dest, length, value, target, context->kp);
+  }
+
+private:
+  const SmootherContext<Sample> *context;
 };
 
 template<typename Sample> class ExpSmootherLocal {
@@ -154,6 +275,7 @@ public:
   }
 
   void push(Sample newTarget) { target = newTarget; }
+  void catchUp() { value = target; }
   Sample process(Sample kp) { return value += kp * (target - value); }
 };
 
@@ -162,6 +284,10 @@ public:
   std::array<Sample, length> value{};
   std::array<Sample, length> target{};
 
+  explicit ParallelExpSmoother(const SmootherContext<Sample> &context) : context(&context)
+  {
+  }
+
   inline Sample getValueAt(size_t index) { return value[index]; }
 
   inline void resetAt(size_t index, Sample resetValue = 0)
@@ -177,10 +303,22 @@ public:
 
   void process()
   {
+    const auto kp = context->kp;
+    for (size_t i = 0; i < length; ++i) value[i] += kp * (target[i] - value[i]);
+  }
+
+  // Ramp of `index` is written to `dest[index * stride + frame]`.
+  void processBlock(Sample *dest, size_t frames, size_t stride)
+  {
+    const auto kp = context->kp;
     for (size_t i = 0; i < length; ++i) {
-      value[i] += SmootherCommon<Sample>::kp * (target[i] - value[i]);
+      value[i]
+        = SmootherBlock::fillExp(dest + i * stride, frames, value[i], target[i], kp);
     }
   }
+
+private:
+  const SmootherContext<Sample> *context;
 };
 
 /**
@@ -195,7 +333,7 @@ doing this.
  */
 template<typename Sample> class LinearSmoother {
 public:
-  using Common = SmootherCommon<Sample>;
+  explicit LinearSmoother(const SmootherContext<Sample> &context) : context(&context) {}
 
   inline Sample getValue() { return value; }
   virtual void refresh() { push(target); }
@@ -209,11 +347,11 @@ public:
   void push(Sample newTarget)
   {
     target = newTarget;
-    if (Common::timeInSamples < Common::bufferSize) {
+    if (context->timeInSamples < context->bufferSize) {
       value = target;
       ramp = 0;
     } else {
-      ramp = (target - value) / Common::timeInSamples;
+      ramp = (target - value) / context->timeInSamples;
     }
   }
 
@@ -224,7 +362,14 @@ public:
     return value;
   }
 
+  // Unlike `process()`, the ramp stops at `target`.
+  void processBlock(Sample *dest, size_t length)
+  {
+    value = SmootherBlock::fillLinear(dest, length, value, target, ramp, Sample(1e-5));
+  }
+
 protected:
+  const SmootherContext<Sample> *context;
   Sample value = 1.0;
   Sample target = 1.0;
   Sample ramp = 0.0;
@@ -232,7 +377,9 @@ protected:
 
 template<typename Sample> class LinearSmootherLocal {
 public:
-  using Common = SmootherCommon<Sample>;
+  explicit LinearSmootherLocal(const SmootherContext<Sample> &context) : context(&context)
+  {
+  }
 
   void setSampleRate(Sample sampleRate, Sample time = 0.04)
   {
@@ -248,7 +395,7 @@ public:
   void push(Sample newTarget)
   {
     target = newTarget;
-    if (timeInSamples < Common::bufferSize) {
+    if (timeInSamples < context->bufferSize) {
       value = target;
       ramp = 0;
     } else {
@@ -264,6 +411,7 @@ public:
   }
 
 protected:
+  const SmootherContext<Sample> *context;
   Sample sampleRate = 44100;
   Sample timeInSamples = -1;
   Sample target = 1.0;
@@ -274,7 +422,7 @@ protected:
 // Unlike LinearSmoother, value is normalized in [0, 1].
 template<typename Sample> class RotarySmoother {
 public:
-  using Common = SmootherCommon<Sample>;
+  explicit RotarySmoother(const SmootherContext<Sample> &context) : context(&context) {}
 
   inline Sample getValue() { return value; }
   void reset(Sample value) { this->value = value; }
@@ -284,7 +432,7 @@ public:
   void push(Sample newTarget)
   {
     target = newTarget;
-    if (Common::timeInSamples < Common::bufferSize) {
+    if (context->timeInSamples < context->bufferSize) {
       value = target;
       return;
     }
@@ -294,17 +442,17 @@ public:
     if (dist1 < 0) {
       auto dist2 = target + max - value;
       if (std::fabs(dist1) > dist2) {
-        ramp = std::max(dist2 / Common::timeInSamples, max * eps);
+        ramp = std::max(dist2 / context->timeInSamples, max * eps);
         return;
       }
     } else {
       auto dist2 = target - max - value;
       if (dist1 > std::fabs(dist2)) {
-        ramp = std::min(dist2 / Common::timeInSamples, -max * eps);
+        ramp = std::min(dist2 / context->timeInSamples, -max * eps);
         return;
       }
     }
-    ramp = dist1 / Common::timeInSamples;
+    ramp = dist1 / context->timeInSamples;
   }
 
   Sample process()
@@ -318,9 +466,16 @@ public:
     return value;
   }
 
+  void processBlock(Sample *dest, size_t length)
+  {
+    value = SmootherBlock::fillRotary(
+      dest, length, value, target, ramp, max, Sample(0.0000152587890625));
+  }
+
 private:
   static constexpr Sample eps = std::numeric_limits<Sample>::epsilon();
 
+  const SmootherContext<Sample> *context;
   Sample value = Sample(1);
   Sample target = Sample(1);
   Sample ramp = Sample(0);
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+#include "pluginterfaces/vst/vsttypes.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace Steinberg {
+namespace Synth {
+
+/**
+Read-only parameters to show the DSP load on GUI. They are registered by
+`PlugController` for all plugins, outside of the range of `ParameterID::ID`.
+
+Normalized values are:
+- `load` and `peak`: `ratio / DSPLoadMeter::maxRatio`. Ratio 1 means 100% of the
+  block duration is used.
+- `histogram*`: Fraction of recent blocks in each bin. Bin `k` is the ratio in
+  `[k / nBin, (k + 1) / nBin)`. The last bin also counts overruns.
+*/
+namespace DSPLoadID {
+
+constexpr size_t nBin = 8;
+
+enum ID : Vst::ParamID {
+  load = 0x7fff0000,
+  peak,
+  histogram0,
+
+  ID_ENUM_END = histogram0 + nBin,
+};
+
+} // namespace DSPLoadID
+
+/**
+Measures wall time of a block with `std::chrono::steady_clock`, and publishes the load
+through `outputParameterChanges`. Two clock reads per block.
+
+`ProcessDriver` owns one and calls `begin()` and `end()` around its sub-block loop. Values
+are sent about 30 times per second.
+*/
+class DSPLoadMeter {
+public:
+  static constexpr double maxRatio = 2.0;
+  static constexpr double loadSeconds = 0.3;
+  static constexpr double peakSeconds = 3.0;
+  static constexpr double histogramSeconds = 10.0;
+  static constexpr double sendIntervalSeconds = 1.0 / 30.0;
+
+  double load = 0;
+  double peak = 0;
+  std::array<double, DSPLoadID::nBin> histogram{};
+
+  void setSampleRate(double sampleRate)
+  {
+    if (sampleRate > 0) this->sampleRate = sampleRate;
+  }
+
+  void begin() { startTime = Clock::now(); }
+
+  void end(int32 numSamples)
+  {
+    if (numSamples <= 0 || sampleRate <= 0) return;
+
+    const double budget = double(numSamples) / sampleRate;
+    const double elapsed
+      = std::chrono::duration<double>(Clock::now() - startTime).count();
+    const double ratio = elapsed / budget;
+
+    load += (1.0 - std::exp(-budget / loadSeconds)) * (ratio - load);
+    peak = std::max(ratio, peak * std::exp(-budget / peakSeconds));
+
+    const double decay = std::exp(-budget / histogramSeconds);
+    for (auto &hst : histogram) hst *= decay;
+    const size_t bin = std::min(size_t(ratio * DSPLoadID::nBin), DSPLoadID::nBin - 1);
+    histogram[bin] += 1.0 - decay;
+
+    sendCounter += budget;
+  }
+
+  void send(Vst::IParameterChanges *changes)
+  {
+    if (changes == nullptr || sendCounter < sendIntervalSeconds) return;
+    sendCounter = 0;
+
+    addPoint(changes, DSPLoadID::load, load / maxRatio);
+    addPoint(changes, DSPLoadID::peak, peak / maxRatio);
+    for (size_t idx = 0; idx < histogram.size(); ++idx) {
+      addPoint(changes, Vst::ParamID(DSPLoadID::histogram0 + idx), histogram[idx]);
+    }
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  double sampleRate = 0;
+  double sendCounter = 0;
+  Clock::time_point startTime;
+
+  void addPoint(Vst::IParameterChanges *changes, Vst::ParamID id, double value)
+  {
+    int32 index = 0;
+    auto queue = changes->addParameterData(id, index);
+    if (!queue) return;
+    queue->addPoint(0, std::clamp(value, 0.0, 1.0), index);
+  }
+};
+
+} // namespace Synth
+} // namespace Steinberg
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "../dspload.hpp"
+#include "arraycontrol.hpp"
+#include "style.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace VSTGUI {
+
+/**
+Shows the output of `Steinberg::Synth::DSPLoadMeter`. Top line is the current and peak
+load in percent of the block duration. Bottom is the histogram of recent blocks, from
+0% on the left to 100% and over on the right.
+
+Display only. Values are updated through `PlugEditor::updateUI`.
+*/
+class DSPLoadView : public ArrayControl {
+public:
+  explicit DSPLoadView(
+    Steinberg::Vst::VSTGUIEditor *editor,
+    const CRect &size,
+    std::vector<Steinberg::Vst::ParamID> id,
+    std::vector<double> value,
+    const SharedPointer<CFontDesc> &fontId,
+    Uhhyou::Palette &palette)
+    : ArrayControl(editor, size, id, value, std::vector<double>(value.size(), 0.0))
+    , fontId(fontId)
+    , pal(palette)
+  {
+    setMouseEnabled(false);
+  }
+
+  CLASS_METHODS(DSPLoadView, CView);
+
+  void draw(CDrawContext *pContext) override
+  {
+    using Meter = Steinberg::Synth::DSPLoadMeter;
+
+    const auto width = getWidth();
+    const auto height = getHeight();
+    const auto sc = pal.guiScale();
+
+    pContext->setDrawMode(CDrawMode(CDrawModeFlags::kAntiAliasing));
+    CDrawContext::Transform t(
+      *pContext, CGraphicsTransform().translate(getViewSize().getTopLeft()));
+
+    // Background.
+    pContext->setFillColor(pal.boxBackground());
+    pContext->drawRect(CRect(0, 0, width, height), kDrawFilled);
+
+    // Text.
+    const auto load = 100 * Meter::maxRatio * value[0];
+    const auto peak = 100 * Meter::maxRatio * value[1];
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1) << "DSP Load " << load << "% (Peak " << peak
+       << "%)";
+    const auto textHeight = fontId->getSize() * 1.5;
+    pContext->setFont(fontId);
+    pContext->setFontColor(peak >= 100 ? pal.highlightWarning() : pal.foreground());
+    pContext->drawString(
+      os.str().c_str(), CRect(2 * sc, 0, width, textHeight), kLeftText, true);
+
+    // Histogram.
+    const size_t nBin = value.size() - 2;
+    const auto barWidth = width / nBin;
+    const auto barTop = textHeight;
+    const auto barHeight = height - barTop;
+    for (size_t idx = 0; idx < nBin; ++idx) {
+      const auto left = idx * barWidth;
+      const auto top = barTop + (1.0 - value[idx + 2]) * barHeight;
+      pContext->setFillColor(
+        idx + 1 == nBin ? pal.highlightWarning() : pal.highlightMain());
+      pContext->drawRect(
+        CRect(left + sc, top, left + barWidth - sc, height), kDrawFilled);
+    }
+
+    // Border.
+    pContext->setLineWidth(int(sc));
+    pContext->setFrameColor(pal.border());
+    pContext->drawRect(CRect(0, 0, width, height), kDrawStroked);
+
+    setDirty(false);
+  }
+
+private:
+  SharedPointer<CFontDesc> fontId;
+  Uhhyou::Palette &pal;
+};
+
+} // namespace VSTGUI
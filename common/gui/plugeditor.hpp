@@ -15,6 +15,7 @@
 #include "barbox.hpp"
 #include "button.hpp"
 #include "checkbox.hpp"
+#include "dsploadview.hpp"
 #include "knob.hpp"
 #include "label.hpp"
 #include "matrixknob.hpp"
@@ -622,7 +623,38 @@ public:
     frame->addView(splash);
     frame->addView(credit);
 
-    if (showCreditAtStartUp) credit->setVisible(true);
+    // DSP load is shown at the bottom right of the credit.
+    const auto loadWidth = std::min(splashWidth / 2, CCoord(sc * 240.0));
+    const auto loadHeight = std::min(splashHeight / 4, CCoord(sc * 60.0));
+    const auto loadMargin = CCoord(sc * 20.0);
+    auto loadView = addDSPLoadView(
+      splashLeft + splashWidth - loadWidth - loadMargin,
+      splashTop + splashHeight - loadHeight - loadMargin, loadWidth, loadHeight,
+      CCoord(sc * 12.0));
+    credit->setLinkedView(loadView);
+
+    credit->setVisible(showCreditAtStartUp);
+  }
+
+  // Shows the output of `DSPLoadMeter`, which is sent by `ProcessDriver` of all plugins.
+  DSPLoadView *
+  addDSPLoadView(CCoord left, CCoord top, CCoord width, CCoord height, CCoord textSize)
+  {
+    using LoadID = Synth::DSPLoadID::ID;
+
+    std::vector<ParamID> id;
+    for (ParamID i = LoadID::load; i < LoadID::ID_ENUM_END; ++i) id.push_back(i);
+    std::vector<double> value(id.size());
+    for (size_t i = 0; i < value.size(); ++i)
+      value[i] = controller->getParamNormalized(id[i]);
+
+    auto view = new DSPLoadView(
+      this, CRect(left, top, left + width, top + height), id, value, getFont(textSize),
+      palette);
+    frame->addView(view);
+
+    for (const auto &ident : id) arrayControlMap.emplace(std::make_pair(ident, view));
+    return view;
   }
 
   TextView *addTextView(
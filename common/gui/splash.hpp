@@ -31,6 +31,27 @@ public:
     setVisible(false);
   }
 
+  virtual ~CreditView()
+  {
+    if (linkedView != nullptr) linkedView->forget();
+  }
+
+  // `view` is shown and hidden together with this.
+  void setLinkedView(CView *view)
+  {
+    if (linkedView != nullptr) linkedView->forget();
+    linkedView = view;
+    if (linkedView == nullptr) return;
+    linkedView->remember();
+    linkedView->setVisible(isVisible());
+  }
+
+  void setVisible(bool state) override
+  {
+    CControl::setVisible(state);
+    if (linkedView != nullptr) linkedView->setVisible(state);
+  }
+
   void draw(CDrawContext *pContext) override;
   void onMouseDownEvent(MouseDownEvent &event) override;
   void onMouseEnterEvent(MouseEnterEvent &event) override;
@@ -67,6 +88,8 @@ private:
   SharedPointer<CFontDesc> fontIdText;
   Uhhyou::Palette &pal;
 
+  CView *linkedView = nullptr;
+
   bool isMouseEntered = false;
 };
 
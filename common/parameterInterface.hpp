@@ -3,9 +3,80 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <cstddef>
+#include <vector>
+
+/**
+Set of parameter IDs changed since the last `DSPCore::setParameters()`.
+
+`ProcessDriver` marks the IDs written from the input parameter queues, and calls
+`clear()` after each `DSPCore::setParameters()`. DSPCore tests the IDs to skip
+recomputing the values derived from unchanged parameters. Without `ProcessDriver`, as in
+`testdsp`, the set is never cleared and all IDs are reported as changed.
+
+Only `postMarkAll()` is safe to call from other than the audio thread. It's called at the
+end of `GlobalParameter::setState`, after all values are written, and takes effect at
+`applyPosted()` in `ProcessDriver::prepare`. Until then, all IDs are reported as changed.
+*/
+class ParameterChangeSet {
+public:
+  // All IDs are marked after resize, so the first `setParameters()` refreshes everything.
+  void resize(size_t size)
+  {
+    words.assign((size + wordBits - 1) / wordBits, 0);
+    isAllChanged = true;
+  }
+
+  void mark(size_t id)
+  {
+    if (id / wordBits >= words.size()) return;
+    words[id / wordBits] |= uint64_t(1) << (id % wordBits);
+  }
+
+  void markAll() { isAllChanged = true; }
+  void postMarkAll() { isAllPosted.store(true, std::memory_order_release); }
+
+  void applyPosted()
+  {
+    if (isAllPosted.exchange(false, std::memory_order_acquire)) isAllChanged = true;
+  }
+
+  bool test(size_t id) const
+  {
+    if (isAllChanged || isAllPosted.load(std::memory_order_relaxed)) return true;
+    if (id / wordBits >= words.size()) return true;
+    return (words[id / wordBits] >> (id % wordBits)) & 1;
+  }
+
+  // Returns true if any ID in [first, last) is changed.
+  bool any(size_t first, size_t last) const
+  {
+    for (size_t id = first; id < last; ++id) {
+      if (test(id)) return true;
+    }
+    return false;
+  }
+
+  void clear()
+  {
+    isAllChanged = false;
+    std::fill(words.begin(), words.end(), uint64_t(0));
+  }
+
+private:
+  static constexpr size_t wordBits = 64;
+
+  std::vector<uint64_t> words;
+  bool isAllChanged = true;
+  std::atomic<bool> isAllPosted{false};
+};
 
 class ParameterInterface {
 public:
   virtual double getDefaultNormalized(int32_t tag) = 0;
+
+  ParameterChangeSet changed;
 };
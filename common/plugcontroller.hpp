@@ -17,7 +17,10 @@
 #include "public.sdk/source/vst/vsteditcontroller.h"
 #include "public.sdk/source/vst/vstparameters.h"
 
+#include "dspload.hpp"
+
 #include <algorithm>
+#include <string>
 #include <vector>
 
 namespace Steinberg::Synth {
@@ -84,7 +87,22 @@ PlugController<EditorType, ParameterType>::initialize(Steinberg::FUnknown *conte
 {
   if (EditController::initialize(context) != kResultTrue) return kResultTrue;
   ParameterType param;
-  return param.addParameter(parameters);
+  auto result = param.addParameter(parameters);
+  if (result != kResultOk) return result;
+
+  // Output of `DSPLoadMeter`.
+  constexpr int32 flags = Vst::ParameterInfo::kIsReadOnly | Vst::ParameterInfo::kIsHidden;
+  parameters.addParameter(STR16("DSP Load"), nullptr, 0, 0.0, flags, DSPLoadID::load);
+  parameters.addParameter(
+    STR16("DSP Load Peak"), nullptr, 0, 0.0, flags, DSPLoadID::peak);
+  for (size_t idx = 0; idx < DSPLoadID::nBin; ++idx) {
+    auto name = "DSP Load Histogram " + std::to_string(idx);
+    UString128 title;
+    title.fromAscii(name.c_str());
+    parameters.addParameter(
+      title, nullptr, 0, 0.0, flags, Vst::ParamID(DSPLoadID::histogram0 + idx));
+  }
+  return kResultOk;
 }
 
 template<typename EditorType, typename ParameterType>
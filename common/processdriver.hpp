@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "dspload.hpp"
+#include "trace.hpp"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstevents.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Steinberg {
+namespace Synth {
+
+// Returns `channelBuffers32` or `channelBuffers64` of `bus` depending on `Sample`.
+template<typename Sample> inline Sample **getChannelBuffers(Vst::AudioBusBuffers &bus)
+{
+  if constexpr (std::is_same_v<Sample, Vst::Sample64>) {
+    return bus.channelBuffers64;
+  } else {
+    return bus.channelBuffers32;
+  }
+}
+
+/**
+Splits a host block into sub-blocks at parameter change points.
+
+`prepare()` gathers every point of every `IParamValueQueue` and every input event into
+one timeline sorted by sample offset. `process()` then walks the timeline. Each time the
+timeline reaches a parameter point, the current sub-block ends, the values are written to
+`GlobalParameter`, and `setParameters` is called so that the new targets are pushed to
+the smoothers at the frame where the host placed them. Note events are rebased to the
+start of the sub-block that contains them.
+
+Each written ID is marked in `param.changed`, so `setParameters` can skip the groups that
+didn't change. The set is cleared after each `setParameters`, including the one called
+before `process()`.
+
+Points closer than `minSubBlockSize` to the start of the current sub-block are deferred
+to the next boundary. This bounds the per-call overhead of `DSPCore::process` under
+dense automation. `minSubBlockSize` larger than the host buffer size disables splitting.
+
+Wall time of `process()` is measured by `loadMeter`, and sent to GUI at the next
+`prepare()`.
+
+Buffers are allocated in the constructor. When a block has more points than
+`pointCapacity`, the remaining queues fall back to applying only their last point at the
+start of the block. Events beyond `eventCapacity` are dropped.
+*/
+class ProcessDriver {
+public:
+  struct ParameterPoint {
+    int32 offset = 0;
+    Vst::ParamID id = 0;
+    Vst::ParamValue value = 0;
+  };
+
+  int32 minSubBlockSize = 32;
+  DSPLoadMeter loadMeter;
+#ifdef UHHYOU_TRACE
+  TraceRing traceRing;
+#endif
+
+  ProcessDriver(size_t pointCapacity = 4096, size_t eventCapacity = 1024)
+  {
+    points.reserve(pointCapacity);
+    events.reserve(eventCapacity);
+  }
+
+  /**
+  Call at the start of `PlugProcessor::process`. Points at offset 0 are applied to
+  `param` right away, so the transport and bypass handling that follow see the values at
+  the start of the block. Points left over by an early return are applied on the next
+  call, before the new points.
+  */
+  template<typename Parameter> void prepare(Vst::ProcessData &data, Parameter &param)
+  {
+    UHHYOU_TRACE_BIND(traceRing);
+
+    param.changed.applyPosted();
+    flush(param);
+    events.resize(0);
+
+    if (data.processContext != nullptr) {
+      loadMeter.setSampleRate(data.processContext->sampleRate);
+    }
+    loadMeter.send(data.outputParameterChanges);
+
+    const bool isFlushing = data.numSamples <= 0;
+
+    if (data.inputParameterChanges != nullptr) {
+      int32 parameterCount = data.inputParameterChanges->getParameterCount();
+      for (int32 index = 0; index < parameterCount; ++index) {
+        auto queue = data.inputParameterChanges->getParameterData(index);
+        if (!queue) continue;
+
+        ParameterPoint point;
+        point.id = queue->getParameterId();
+        if (point.id >= param.value.size()) continue;
+
+        int32 pointCount = queue->getPointCount();
+        if (isFlushing || pointCount > int32(points.capacity() - points.size())) {
+          if (queue->getPoint(pointCount - 1, point.offset, point.value) != kResultTrue)
+            continue;
+          param.value[point.id]->setFromNormalized(point.value);
+          param.changed.mark(point.id);
+          continue;
+        }
+
+        for (int32 idx = 0; idx < pointCount; ++idx) {
+          if (queue->getPoint(idx, point.offset, point.value) != kResultTrue) continue;
+          points.push_back(point);
+        }
+      }
+    }
+    insertionSort(points, [](const ParameterPoint &a, const ParameterPoint &b) {
+      return a.offset < b.offset;
+    });
+    applyUntil(param, 0);
+
+    if (data.inputEvents != nullptr) {
+      int32 eventCount = data.inputEvents->getEventCount();
+      for (int32 index = 0; index < eventCount; ++index) {
+        if (events.size() >= events.capacity()) break;
+        Vst::Event event;
+        if (data.inputEvents->getEvent(index, event) != kResultOk) continue;
+        events.push_back(event);
+      }
+    }
+    insertionSort(events, [](const Vst::Event &a, const Vst::Event &b) {
+      return a.sampleOffset < b.sampleOffset;
+    });
+  }
+
+  // Applies all remaining points without processing. Used for bypass.
+  template<typename Parameter> void flush(Parameter &param)
+  {
+    applyUntil(param, std::numeric_limits<int32>::max());
+    points.resize(0);
+    pointIndex = 0;
+  }
+
+  /**
+  `setParameters()` is called at each boundary except the first. The caller is
+  expected to have called it once after `prepare()`. It may run several times per host
+  block, so it must only push new targets to the DSP; per-block state such as LFO steps
+  or sample rate setup belongs in `setup()` or `process()`.
+
+  `handleEvent(Vst::Event &)` receives events with `sampleOffset` relative to the start
+  of the sub-block.
+
+  `processSubBlock(int32 offset, int32 length)` processes
+  `[offset, offset + length)` of the host buffers.
+  */
+  template<
+    typename Parameter,
+    typename SetParameters,
+    typename HandleEvent,
+    typename ProcessSubBlock>
+  void process(
+    int32 numSamples,
+    Parameter &param,
+    SetParameters setParameters,
+    HandleEvent handleEvent,
+    ProcessSubBlock processSubBlock)
+  {
+    UHHYOU_TRACE_SCOPE("block");
+    loadMeter.begin();
+
+    param.changed.clear();
+
+    size_t eventIndex = 0;
+    int32 start = 0;
+    while (start < numSamples) {
+      if (start > 0) {
+        applyUntil(param, start);
+        setParameters();
+        param.changed.clear();
+      }
+
+      int32 end = numSamples;
+      for (size_t idx = pointIndex; idx < points.size(); ++idx) {
+        if (points[idx].offset - start < minSubBlockSize) continue;
+        end = std::min(end, points[idx].offset);
+        break;
+      }
+
+      while (eventIndex < events.size()
+             && (end >= numSamples || events[eventIndex].sampleOffset < end))
+      {
+        auto &event = events[eventIndex++];
+        event.sampleOffset = std::max(event.sampleOffset - start, int32(0));
+        handleEvent(event);
+      }
+
+      processSubBlock(start, end - start);
+      start = end;
+    }
+
+    flush(param);
+    loadMeter.end(numSamples);
+  }
+
+  template<typename Parameter, typename SetParameters, typename ProcessSubBlock>
+  void process(
+    int32 numSamples,
+    Parameter &param,
+    SetParameters setParameters,
+    ProcessSubBlock processSubBlock)
+  {
+    process(
+      numSamples, param, setParameters, [](Vst::Event &) {}, processSubBlock);
+  }
+
+private:
+  std::vector<ParameterPoint> points;
+  std::vector<Vst::Event> events;
+  size_t pointIndex = 0;
+
+  template<typename Parameter> void applyUntil(Parameter &param, int32 frame)
+  {
+    for (; pointIndex < points.size(); ++pointIndex) {
+      const auto &point = points[pointIndex];
+      if (point.offset > frame) break;
+      param.value[point.id]->setFromNormalized(point.value);
+      param.changed.mark(point.id);
+    }
+  }
+
+  // Stable and allocation free. Hosts mostly send sorted input, so this is close to
+  // linear in practice.
+  template<typename T, typename Compare>
+  static void insertionSort(std::vector<T> &vec, Compare isLess)
+  {
+    for (size_t i = 1; i < vec.size(); ++i) {
+      if (!isLess(vec[i], vec[i - 1])) continue;
+      T tmp = vec[i];
+      size_t j = i;
+      for (; j > 0 && isLess(tmp, vec[j - 1]); --j) vec[j] = vec[j - 1];
+      vec[j] = tmp;
+    }
+  }
+};
+
+} // namespace Synth
+} // namespace Steinberg
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "dsp/silence.hpp"
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+#include "pluginterfaces/vst/ivstevents.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Steinberg {
+namespace Synth {
+
+/**
+Skips `DSPCore::process` of an effect while its input is silent and its tail has decayed.
+
+- `skip()` is called before processing. It returns true while sleeping. In that case the
+  outputs are filled with 0 and `silenceFlags` of the output bus is set.
+- `update()` is called after processing. The detector falls asleep when the input has
+  been silent for `tailSamples` or longer, and the output of the block is below
+  `threshold`.
+- When the tail can't be bounded from the parameters, `tailSamples` is `infiniteTail`.
+  The detector then measures the output instead, and falls asleep when the output has
+  been below `threshold` for `measureSamples` or longer.
+
+Input channels flagged by the host in `silenceFlags` are not scanned. Any input event
+wakes the detector up, because notes may change the state of DSP.
+*/
+class SilenceDetector {
+public:
+  float threshold = float(SomeDSP::silenceThreshold);
+
+  void reset()
+  {
+    silentFrames = 0;
+    silentOutputFrames = 0;
+    isInputSilent = false;
+    isSleeping = false;
+  }
+
+  bool skip(Vst::ProcessData &data)
+  {
+    isInputSilent = checkInput(data);
+    if (!isInputSilent) {
+      silentFrames = 0;
+      silentOutputFrames = 0;
+      isSleeping = false;
+      return false;
+    }
+
+    size_t length = size_t(data.numSamples);
+    silentFrames = std::min(silentFrames, SomeDSP::infiniteTail - length) + length;
+    if (!isSleeping) return false;
+
+    clearOutput(data);
+    return true;
+  }
+
+  void update(
+    Vst::ProcessData &data,
+    size_t tailSamples,
+    size_t measureSamples = SomeDSP::infiniteTail)
+  {
+    for (int32 idx = 0; idx < data.numOutputs; ++idx) data.outputs[idx].silenceFlags = 0;
+
+    bool isOutputSilent
+      = isBusSilent(data.outputs[0], data.numSamples, data.symbolicSampleSize);
+    size_t length = size_t(data.numSamples);
+    silentOutputFrames = isOutputSilent
+      ? std::min(silentOutputFrames, SomeDSP::infiniteTail - length) + length
+      : 0;
+
+    bool isDecayed = tailSamples == SomeDSP::infiniteTail
+      ? silentOutputFrames >= measureSamples
+      : silentFrames >= tailSamples;
+    isSleeping = isInputSilent && isOutputSilent && isDecayed;
+  }
+
+private:
+  size_t silentFrames = 0;
+  size_t silentOutputFrames = 0;
+  bool isInputSilent = false;
+  bool isSleeping = false;
+
+  bool checkInput(Vst::ProcessData &data)
+  {
+    if (data.inputEvents != nullptr && data.inputEvents->getEventCount() > 0)
+      return false;
+    for (int32 idx = 0; idx < data.numInputs; ++idx) {
+      if (!isBusSilent(data.inputs[idx], data.numSamples, data.symbolicSampleSize))
+        return false;
+    }
+    return true;
+  }
+
+  bool isBusSilent(Vst::AudioBusBuffers &bus, int32 numSamples, int32 sampleSize)
+  {
+    for (int32 ch = 0; ch < bus.numChannels; ++ch) {
+      if (ch < 64 && (bus.silenceFlags >> ch) & 1) continue;
+      bool isSilent = sampleSize == Vst::kSample64
+        ? isBufferSilent(bus.channelBuffers64[ch], numSamples)
+        : isBufferSilent(bus.channelBuffers32[ch], numSamples);
+      if (!isSilent) return false;
+    }
+    return true;
+  }
+
+  template<typename Sample> bool isBufferSilent(const Sample *buf, int32 numSamples)
+  {
+    // `!(a < b)` to also catch NaN.
+    for (int32 i = 0; i < numSamples; ++i) {
+      if (!(std::abs(buf[i]) < Sample(threshold))) return false;
+    }
+    return true;
+  }
+
+  void clearOutput(Vst::ProcessData &data)
+  {
+    for (int32 idx = 0; idx < data.numOutputs; ++idx) {
+      auto &bus = data.outputs[idx];
+      for (int32 ch = 0; ch < bus.numChannels; ++ch) {
+        if (data.symbolicSampleSize == Vst::kSample64) {
+          std::fill_n(bus.channelBuffers64[ch], data.numSamples, Vst::Sample64(0));
+        } else {
+          std::fill_n(bus.channelBuffers32[ch], data.numSamples, Vst::Sample32(0));
+        }
+      }
+      bus.silenceFlags
+        = bus.numChannels >= 64 ? ~uint64(0) : (uint64(1) << bus.numChannels) - 1;
+    }
+  }
+};
+
+} // namespace Synth
+} // namespace Steinberg
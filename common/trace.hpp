@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+/**
+Optional tracing of audio thread events. Enabled by CMake option `UHHYOU_TRACE`, which
+defines the macro of the same name. Without it, the macros below expand to nothing.
+
+- `UHHYOU_TRACE_SCOPE("name")` records begin and end of the enclosing scope.
+- `UHHYOU_TRACE_INSTANT("name")` records a single point in time.
+- `UHHYOU_TRACE_BIND(ring)` directs the events on the current thread to `ring`.
+
+`name` must be a string literal, because only the pointer is stored.
+
+Each plugin instance owns a `TraceRing` in `ProcessDriver`, which is bound at
+`ProcessDriver::prepare`. Events recorded on a thread without a bound ring are discarded.
+`TraceWriter` drains all the rings on its own thread, and writes Chrome trace JSON
+to the path in the environment variable `UHHYOU_TRACE_FILE`, or to
+`uhhyou_trace_*.json` in the temporary directory. Open the file in `chrome://tracing` or
+Perfetto. Each instance appears as a thread.
+*/
+
+#ifdef UHHYOU_TRACE
+
+  #include <algorithm>
+  #include <array>
+  #include <atomic>
+  #include <chrono>
+  #include <condition_variable>
+  #include <cstdint>
+  #include <cstdio>
+  #include <cstdlib>
+  #include <filesystem>
+  #include <mutex>
+  #include <string>
+  #include <thread>
+  #include <vector>
+
+namespace Steinberg {
+namespace Synth {
+
+struct TraceEvent {
+  uint64_t timeNs = 0;
+  const char *name = nullptr;
+  char phase = 'i'; // 'B': begin, 'E': end, 'i': instant.
+};
+
+// Single producer, single consumer. Events are dropped when the ring is full.
+class TraceRing {
+public:
+  static constexpr size_t capacity = size_t(1) << 14;
+
+  inline static thread_local TraceRing *current = nullptr;
+
+  inline TraceRing();
+  inline ~TraceRing();
+
+  TraceRing(const TraceRing &) = delete;
+  TraceRing &operator=(const TraceRing &) = delete;
+
+  static uint64_t now()
+  {
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count());
+  }
+
+  // Realtime safe. Called on the audio thread.
+  void push(const char *name, char phase)
+  {
+    const auto wptr = writePos.load(std::memory_order_relaxed);
+    if (wptr - readPos.load(std::memory_order_acquire) >= capacity) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    buffer[wptr & mask] = {now(), name, phase};
+    writePos.store(wptr + 1, std::memory_order_release);
+  }
+
+  // Called on the thread of `TraceWriter`.
+  template<typename Func> void drain(Func func)
+  {
+    auto rptr = readPos.load(std::memory_order_relaxed);
+    const auto wptr = writePos.load(std::memory_order_acquire);
+    for (; rptr < wptr; ++rptr) func(buffer[rptr & mask]);
+    readPos.store(rptr, std::memory_order_release);
+  }
+
+  uint32_t id = 0;
+  std::atomic<uint64_t> dropped{0};
+
+private:
+  static constexpr size_t mask = capacity - 1;
+
+  std::array<TraceEvent, capacity> buffer;
+  alignas(64) std::atomic<uint64_t> writePos{0};
+  alignas(64) std::atomic<uint64_t> readPos{0};
+};
+
+class TraceWriter {
+public:
+  static TraceWriter &instance()
+  {
+    static TraceWriter writer;
+    return writer;
+  }
+
+  // Not realtime safe. Opens the file and starts the thread on the first ring.
+  void add(TraceRing *ring)
+  {
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    ring->id = ++lastId;
+    rings.push_back(ring);
+    if (rings.size() > 1) return;
+
+    open();
+    isRunning = true;
+    thread = std::thread([this]() { runLoop(); });
+  }
+
+  // Not realtime safe. Closes the file and stops the thread on the last ring.
+  void remove(TraceRing *ring)
+  {
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+    std::unique_lock<std::mutex> lock(mutex);
+    write(ring);
+    rings.erase(std::remove(rings.begin(), rings.end(), ring), rings.end());
+    if (!rings.empty()) return;
+
+    isRunning = false;
+    lock.unlock();
+    wakeup.notify_all();
+    if (thread.joinable()) thread.join();
+
+    lock.lock();
+    close();
+  }
+
+private:
+  static constexpr auto drainInterval = std::chrono::milliseconds(50);
+
+  std::mutex lifecycleMutex; // Serializes `add` and `remove`, including `thread.join()`.
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::thread thread;
+  bool isRunning = false;
+
+  std::vector<TraceRing *> rings;
+  uint32_t lastId = 0;
+  FILE *file = nullptr;
+  bool isFirstEvent = true;
+
+  TraceWriter() = default;
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  void runLoop()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (isRunning) {
+      wakeup.wait_for(lock, drainInterval, [this]() { return !isRunning; });
+      for (auto &ring : rings) write(ring);
+      if (file != nullptr) std::fflush(file);
+    }
+  }
+
+  void open()
+  {
+    std::string path;
+    if (const char *env = std::getenv("UHHYOU_TRACE_FILE"); env != nullptr) {
+      path = env;
+    } else {
+      std::error_code ec;
+      auto dir = std::filesystem::temp_directory_path(ec);
+      auto name = "uhhyou_trace_" + std::to_string(TraceRing::now()) + ".json";
+      path = (dir / name).string();
+    }
+    file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) return;
+    std::fputs("[\n", file);
+    isFirstEvent = true;
+  }
+
+  void close()
+  {
+    if (file == nullptr) return;
+    std::fputs("\n]\n", file);
+    std::fclose(file);
+    file = nullptr;
+  }
+
+  void separate()
+  {
+    if (!isFirstEvent) std::fputs(",\n", file);
+    isFirstEvent = false;
+  }
+
+  // Must be called with `mutex` locked.
+  void write(TraceRing *ring)
+  {
+    if (file == nullptr) {
+      ring->drain([](const TraceEvent &) {});
+      return;
+    }
+
+    ring->drain([&](const TraceEvent &event) {
+      separate();
+      std::fprintf(
+        file, R"({"name":"%s","ph":"%c","ts":%.3f,"pid":1,"tid":%u%s})", event.name,
+        event.phase, double(event.timeNs) * 1e-3, unsigned(ring->id),
+        event.phase == 'i' ? R"(,"s":"t")" : "");
+    });
+
+    auto dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+      separate();
+      std::fprintf(
+        file,
+        R"({"name":"dropped","ph":"i","ts":%.3f,"pid":1,"tid":%u,"s":"t",)"
+        R"("args":{"count":%llu}})",
+        double(TraceRing::now()) * 1e-3, unsigned(ring->id),
+        (unsigned long long)dropped);
+    }
+  }
+};
+
+TraceRing::TraceRing() { TraceWriter::instance().add(this); }
+
+TraceRing::~TraceRing()
+{
+  if (current == this) current = nullptr;
+  TraceWriter::instance().remove(this);
+}
+
+class TraceScope {
+public:
+  explicit TraceScope(const char *name) : name(name)
+  {
+    if (TraceRing::current != nullptr) TraceRing::current->push(name, 'B');
+  }
+
+  ~TraceScope()
+  {
+    if (TraceRing::current != nullptr) TraceRing::current->push(name, 'E');
+  }
+
+private:
+  const char *name;
+};
+
+inline void traceInstant(const char *name)
+{
+  if (TraceRing::current != nullptr) TraceRing::current->push(name, 'i');
+}
+
+} // namespace Synth
+} // namespace Steinberg
+
+  #define UHHYOU_TRACE_SCOPE(name) ::Steinberg::Synth::TraceScope uhhyouTraceScope(name)
+  #define UHHYOU_TRACE_INSTANT(name) ::Steinberg::Synth::traceInstant(name)
+  #define UHHYOU_TRACE_BIND(ring) (::Steinberg::Synth::TraceRing::current = &(ring))
+
+#else
+
+  #define UHHYOU_TRACE_SCOPE(name)
+  #define UHHYOU_TRACE_INSTANT(name)
+  #define UHHYOU_TRACE_BIND(ring)
+
+#endif
@@ -26,3 +26,8 @@
 #endif
 
 #include "vcl/vectorclass.h"
+
+// Set for each instruction set variant by `add_simd_dspcore` in CMake.
+#ifdef VCL_NAMESPACE
+using namespace VCL_NAMESPACE;
+#endif
@@ -0,0 +1,622 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+// Only `Sequencer` is used from `synthtester.hpp`.
+#ifndef NO_DSP_INTERFACE
+  #define NO_DSP_INTERFACE
+#endif
+
+#include "fxtester.hpp"
+#include "rtsafety.hpp"
+#include "synthtester.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <type_traits>
+
+#ifdef UHHYOU_RT_CHECK
+  #include "../common/processdriver.hpp"
+  #include "testhost.hpp"
+#endif
+
+/**
+Offline render and benchmark of a `DSPCore`. Each plugin provides `test/bench.cpp` which
+calls `runBench()` with adapters for its `DSPCore` interface. CMake builds it as
+`uhhyou-bench_<PluginName>`.
+
+The report contains the cost per sample, realtime factor, and the distribution of the
+time spent on each block. See `printBenchUsage()` for the options.
+*/
+
+enum class BenchNotePattern { none, single, sequence };
+
+struct BenchOptions {
+  std::string preset;
+  std::string presetJson;
+  std::string inputPath;
+  std::string outputPath;
+  float sampleRate = 48000.0f;
+  size_t blockSize = 512;
+  float seconds = 10.0f;
+  float tempo = 120.0f;
+  BenchNotePattern notePattern = BenchNotePattern::sequence;
+  bool isJson = false;
+  bool listPresets = false;
+};
+
+inline void printBenchUsage(const std::string &plugin_name)
+{
+  std::cerr << "Usage: uhhyou-bench_" << plugin_name << " [options]\n"
+            << "  --preset <name>         Preset name. Default parameters if omitted.\n"
+            << "  --preset-json <path>    Path to *.preset.json.\n"
+            << "  --list-presets          Print preset names, then exit.\n"
+            << "  --samplerate <Hz>       Default 48000.\n"
+            << "  --blocksize <frames>    Default 512.\n"
+            << "  --seconds <seconds>     Render length. Default 10.\n"
+            << "  --notes <pattern>       none, single, or sequence. Default sequence.\n"
+            << "  --tempo <bpm>           Tempo of sequence. Default 120.\n"
+            << "  --input <path>          Input WAV. White noise if omitted.\n"
+            << "  --output <path>         Writes the rendered output to WAV.\n"
+            << "  --format <format>       csv or json. Default csv.\n";
+}
+
+inline bool parseBenchOptions(int argc, char **argv, BenchOptions &opt)
+{
+  for (int idx = 1; idx < argc; ++idx) {
+    std::string key = argv[idx];
+    if (key == "--list-presets") {
+      opt.listPresets = true;
+      continue;
+    }
+
+    if (idx + 1 >= argc) {
+      std::cerr << "Error: Missing value for " << key << ".\n";
+      return false;
+    }
+    std::string value = argv[++idx];
+
+    try {
+      if (key == "--preset") {
+        opt.preset = value;
+      } else if (key == "--preset-json") {
+        opt.presetJson = value;
+      } else if (key == "--samplerate") {
+        opt.sampleRate = std::stof(value);
+      } else if (key == "--blocksize") {
+        opt.blockSize = std::stoul(value);
+      } else if (key == "--seconds") {
+        opt.seconds = std::stof(value);
+      } else if (key == "--tempo") {
+        opt.tempo = std::stof(value);
+      } else if (key == "--input") {
+        opt.inputPath = value;
+      } else if (key == "--output") {
+        opt.outputPath = value;
+      } else if (key == "--notes") {
+        if (value == "none") {
+          opt.notePattern = BenchNotePattern::none;
+        } else if (value == "single") {
+          opt.notePattern = BenchNotePattern::single;
+        } else if (value == "sequence") {
+          opt.notePattern = BenchNotePattern::sequence;
+        } else {
+          std::cerr << "Error: Unknown note pattern " << value << ".\n";
+          return false;
+        }
+      } else if (key == "--format") {
+        if (value != "csv" && value != "json") {
+          std::cerr << "Error: Unknown format " << value << ".\n";
+          return false;
+        }
+        opt.isJson = value == "json";
+      } else {
+        std::cerr << "Error: Unknown option " << key << ".\n";
+        return false;
+      }
+    } catch (const std::exception &) {
+      std::cerr << "Error: Invalid value " << value << " for " << key << ".\n";
+      return false;
+    }
+  }
+
+  if (!(opt.sampleRate > 0) || opt.blockSize == 0 || !(opt.seconds > 0)
+      || !(opt.tempo > 0))
+  {
+    std::cerr << "Error: samplerate, blocksize, seconds, and tempo must be positive.\n";
+    return false;
+  }
+  return true;
+}
+
+/**
+Builds note events for `nFrame`. `sequence` repeats the pattern of `SynthTester` every 8
+beats with new note IDs.
+*/
+inline std::vector<NoteEvent>
+makeBenchNotes(const BenchOptions &opt, size_t nFrame, bool hasNote)
+{
+  Sequencer sequencer;
+  if (!hasNote) return sequencer.events_;
+
+  if (opt.notePattern == BenchNotePattern::single) {
+    sequencer.addNote(
+      opt.sampleRate, 0.0f, float(nFrame) / opt.sampleRate, 0, 60, 0.0f, 1.0f);
+  } else if (opt.notePattern == BenchNotePattern::sequence) {
+    Sequencer pattern;
+    pattern.setupSequence(opt.sampleRate, opt.tempo);
+    const size_t period = size_t(8 * 60 * opt.sampleRate / opt.tempo);
+    for (size_t offset = 0, loop = 0; offset < nFrame; offset += period, ++loop) {
+      for (auto note : pattern.events_) {
+        note.frame += offset;
+        if (note.frame >= nFrame) continue;
+        note.id += int32_t(loop * pattern.events_.size());
+        sequencer.events_.push_back(note);
+      }
+    }
+    sequencer.sort();
+  }
+  return sequencer.events_;
+}
+
+inline bool loadBenchInput(
+  const BenchOptions &opt, size_t nFrame, std::vector<std::vector<float>> &in)
+{
+  if (opt.inputPath.empty()) {
+    in = generateTestNoise<float>(nFrame);
+    return true;
+  }
+
+  SoundFile snd(opt.inputPath);
+  if (!snd.isReady() || snd.channels_ == 0 || snd.frames_ == 0) return false;
+  if (float(snd.samplerate_) != opt.sampleRate) {
+    std::cerr << "Warning: Sample rate of " << opt.inputPath << " is "
+              << snd.samplerate_ << " Hz. It's used without resampling.\n";
+  }
+
+  // Input is looped to fill `nFrame`. Mono input is copied to both channels.
+  in.assign(2, std::vector<float>(nFrame));
+  for (size_t ch = 0; ch < in.size(); ++ch) {
+    const auto &src = snd.data_[std::min(ch, snd.channels_ - 1)];
+    for (size_t i = 0; i < nFrame; ++i) in[ch][i] = src[i % snd.frames_];
+  }
+  return true;
+}
+
+inline bool findBenchPreset(
+  const BenchOptions &opt, const std::string &plugin_name, nlohmann::json &preset)
+{
+  nlohmann::json data;
+  if (opt.presetJson.empty()) {
+    data = loadPresetJson(plugin_name);
+  } else {
+    std::ifstream ifs(opt.presetJson);
+    if (!ifs.is_open()) {
+      std::cerr << "Failed to open " << opt.presetJson << "\n";
+      return false;
+    }
+    ifs >> data;
+  }
+
+  if (opt.listPresets) {
+    for (const auto &pre : data) std::cout << pre["name"].get<std::string>() << "\n";
+    return true;
+  }
+
+  for (const auto &pre : data) {
+    if (pre["name"] != opt.preset) continue;
+    preset = pre;
+    return true;
+  }
+  std::cerr << "Error: Preset " << opt.preset << " is not found.\n";
+  return false;
+}
+
+struct BenchResult {
+  size_t nFrame = 0;
+  size_t nBlock = 0;
+  double nsPerSample = 0;
+  double realtimeFactor = 0;
+  double p50Us = 0;
+  double p99Us = 0;
+  double maxUs = 0;
+};
+
+inline BenchResult
+computeBenchResult(std::vector<double> &blockNs, size_t nFrame, float sampleRate)
+{
+  BenchResult res;
+  res.nFrame = nFrame;
+  res.nBlock = blockNs.size();
+  if (blockNs.empty()) return res;
+
+  double sumNs = 0;
+  for (const auto &ns : blockNs) sumNs += ns;
+  res.nsPerSample = sumNs / double(nFrame);
+  res.realtimeFactor = double(nFrame) / double(sampleRate) / (sumNs * 1e-9);
+
+  // Nearest-rank percentile.
+  std::sort(blockNs.begin(), blockNs.end());
+  auto percentile = [&](double p) {
+    size_t rank = size_t(std::ceil(p * double(blockNs.size())));
+    return blockNs[std::clamp<size_t>(rank, 1, blockNs.size()) - 1] * 1e-3;
+  };
+  res.p50Us = percentile(0.50);
+  res.p99Us = percentile(0.99);
+  res.maxUs = blockNs.back() * 1e-3;
+  return res;
+}
+
+inline void printBenchResult(
+  const BenchOptions &opt, const std::string &plugin_name, const BenchResult &res)
+{
+  const std::string preset = opt.preset.empty() ? "(default)" : opt.preset;
+  if (opt.isJson) {
+    nlohmann::json data;
+    data["plugin"] = plugin_name;
+    data["preset"] = preset;
+    data["sampleRate"] = opt.sampleRate;
+    data["blockSize"] = opt.blockSize;
+    data["frames"] = res.nFrame;
+    data["blocks"] = res.nBlock;
+    data["nsPerSample"] = res.nsPerSample;
+    data["realtimeFactor"] = res.realtimeFactor;
+    data["blockUs"] = {{"p50", res.p50Us}, {"p99", res.p99Us}, {"max", res.maxUs}};
+    std::cout << data.dump(2) << "\n";
+    return;
+  }
+
+  std::cout << "plugin,preset,sampleRate,blockSize,frames,blocks,nsPerSample,"
+               "realtimeFactor,p50Us,p99Us,maxUs\n"
+            << plugin_name << "," << preset << "," << opt.sampleRate << ","
+            << opt.blockSize << "," << res.nFrame << "," << res.nBlock << ","
+            << res.nsPerSample << "," << res.realtimeFactor << "," << res.p50Us << ","
+            << res.p99Us << "," << res.maxUs << "\n";
+}
+
+/**
+Expands `SET_PARAMETERS` defined in `test/bench.cpp`. It may refer to `dsp` and `tempo`,
+in the same way as `test/testdsp.cpp`. `param.changed` is cleared afterward, as
+`ProcessDriver` does.
+*/
+template<typename DSP_CLASS>
+void setBenchParameters(DSP_CLASS *dsp, [[maybe_unused]] float tempo)
+{
+  SET_PARAMETERS;
+  dsp->param.changed.clear();
+}
+
+template<typename DSP_CLASS>
+void setupBenchDsp(DSP_CLASS *dsp, const BenchOptions &opt, const nlohmann::json &preset)
+{
+  dsp->setup(opt.sampleRate);
+  if (!preset.is_null()) loadPresetParameter(*dsp, preset);
+  setBenchParameters(dsp, opt.tempo);
+  dsp->reset();
+}
+
+/**
+Renders `out` block by block. `onBlock(frame, process)` is called for each block, and
+`process()` sets parameters, sends notes and renders the block.
+
+Note events are sent before the block which contains them, like hosts do.
+*/
+template<typename DSP_CLASS, typename Render, typename Note, typename OnBlock>
+void renderBenchBlocks(
+  DSP_CLASS &dsp,
+  const BenchOptions &opt,
+  const std::vector<NoteEvent> &events,
+  std::vector<std::vector<float>> &in,
+  std::vector<std::vector<float>> &out,
+  Render &render,
+  Note &note,
+  OnBlock onBlock)
+{
+  const size_t nFrame = out[0].size();
+  size_t eventIndex = 0;
+  for (size_t frame = 0; frame < nFrame; frame += opt.blockSize) {
+    const size_t length = std::min(opt.blockSize, nFrame - frame);
+    onBlock(frame, [&]() {
+      setBenchParameters(&dsp, opt.tempo);
+      if constexpr (!std::is_same_v<Note, std::nullptr_t>) {
+        for (; eventIndex < events.size(); ++eventIndex) {
+          const auto &event = events[eventIndex];
+          if (event.frame >= frame + length) break;
+          note(dsp, event.frame - frame, event);
+        }
+      }
+      render(dsp, frame, length, in, out);
+    });
+  }
+}
+
+#ifdef UHHYOU_RT_CHECK
+/**
+Fills `changes` with automation of `nAutomation` parameters for a block of `length`
+frames. Parameters are taken in turn from `id`, and each gets 2 points of random value at
+random offsets.
+*/
+template<typename Rng>
+void addBenchAutomation(
+  Steinberg::Vst::TestParameterChanges &changes,
+  Rng &rng,
+  size_t nParameter,
+  size_t length,
+  size_t &id)
+{
+  constexpr size_t nAutomation = 4;
+  constexpr size_t nPoint = 2;
+
+  using namespace Steinberg;
+  std::uniform_int_distribution<int32> offsetDist(0, int32(length) - 1);
+  std::uniform_real_distribution<Vst::ParamValue> valueDist(0.0, 1.0);
+  for (size_t idx = 0; idx < std::min(nAutomation, nParameter); ++idx) {
+    id = (id + 1) % nParameter;
+    int32 queueIndex = 0;
+    auto queue = changes.addParameterData(Vst::ParamID(id), queueIndex);
+    if (queue == nullptr) return;
+
+    std::array<int32, nPoint> offsets;
+    for (auto &ofst : offsets) ofst = offsetDist(rng);
+    std::sort(offsets.begin(), offsets.end());
+    for (const auto &ofst : offsets) {
+      int32 pointIndex = 0;
+      queue->addPoint(ofst, valueDist(rng), pointIndex);
+    }
+  }
+}
+
+inline Steinberg::Vst::Event toBenchVstEvent(const NoteEvent &note, size_t blockFrame)
+{
+  using namespace Steinberg;
+  Vst::Event event{};
+  event.sampleOffset = int32(note.frame - blockFrame);
+  if (note.type == NoteEventType::noteOn) {
+    event.type = Vst::Event::kNoteOnEvent;
+    event.noteOn.pitch = note.pitch;
+    event.noteOn.tuning = note.tuning;
+    event.noteOn.velocity = note.velocity;
+    event.noteOn.noteId = note.id;
+  } else {
+    event.type = Vst::Event::kNoteOffEvent;
+    event.noteOff.pitch = note.pitch;
+    event.noteOff.tuning = note.tuning;
+    event.noteOff.velocity = note.velocity;
+    event.noteOff.noteId = note.id;
+  }
+  return event;
+}
+
+inline NoteEvent toBenchNoteEvent(const Steinberg::Vst::Event &event)
+{
+  using namespace Steinberg;
+  const bool isNoteOn = event.type == Vst::Event::kNoteOnEvent;
+  const auto &on = event.noteOn;
+  const auto &off = event.noteOff;
+  return NoteEvent{
+    isNoteOn ? on.noteId : off.noteId,
+    isNoteOn ? on.pitch : off.pitch,
+    isNoteOn ? on.tuning : off.tuning,
+    isNoteOn ? on.velocity : off.velocity,
+    size_t(event.sampleOffset),
+    isNoteOn ? NoteEventType::noteOn : NoteEventType::noteOff,
+  };
+}
+
+/**
+Renders presets while recording allocations and locks made on the audio thread. All
+presets are checked when `--preset` is omitted. Violations with the same call stack are
+reported once with the number of occurrences.
+
+Blocks are processed through `ProcessDriver` in the same way as `PlugProcessor::process`.
+Notes are sent as `Vst::Event`, and parameters are automated by `addBenchAutomation()`,
+so sub-block splitting and the extra `setParameters()` calls are also checked.
+
+`setup()`, `reset()`, preset loading and filling the host buffers are excluded from the
+check, because hosts do them outside of the audio thread.
+*/
+template<typename DSP_CLASS, typename Render, typename Note>
+int runRealtimeSafetyCheck(
+  const BenchOptions &opt, std::string plugin_name, Render &render, Note &note)
+{
+  if (!isRealtimeCheckSupported()) {
+    std::cerr << "Error: Realtime safety check is not supported on this platform.\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<nlohmann::json> presets;
+  if (opt.preset.empty()) {
+    for (const auto &pre : loadPresetJson(plugin_name)) presets.push_back(pre);
+  } else {
+    presets.emplace_back();
+    if (!findBenchPreset(opt, plugin_name, presets.back())) return EXIT_FAILURE;
+  }
+  if (presets.empty()) presets.emplace_back();
+
+  constexpr bool hasNote = !std::is_same_v<Note, std::nullptr_t>;
+  const size_t nFrame = std::max(size_t(opt.seconds * opt.sampleRate), size_t(1));
+  std::vector<std::vector<float>> in;
+  if (!loadBenchInput(opt, nFrame, in)) return EXIT_FAILURE;
+  std::vector<std::vector<float>> out(2, std::vector<float>(nFrame));
+  const auto events = makeBenchNotes(opt, nFrame, hasNote);
+
+  struct Report {
+    std::string preset;
+    RealtimeViolationKind kind;
+    size_t count = 0;
+    std::vector<std::string> stack;
+  };
+  std::map<std::vector<void *>, Report> reports;
+  size_t nDropped = 0;
+
+  using namespace Steinberg;
+  Vst::TestParameterChanges inputChanges;
+  Vst::TestParameterChanges outputChanges;
+  Vst::TestEventList eventList;
+
+  Vst::ProcessContext context{};
+  context.state = Vst::ProcessContext::kPlaying | Vst::ProcessContext::kTempoValid;
+  context.sampleRate = opt.sampleRate;
+  context.tempo = opt.tempo;
+
+  Vst::ProcessData data{};
+  data.inputParameterChanges = &inputChanges;
+  data.outputParameterChanges = &outputChanges;
+  data.inputEvents = &eventList;
+  data.processContext = &context;
+
+  for (const auto &preset : presets) {
+    std::string name = preset.is_null() ? "(default)" : preset["name"].get<std::string>();
+    std::cout << "Processing preset: " << name << "\n";
+
+    auto dsp = std::make_unique<DSP_CLASS>();
+    setupBenchDsp(dsp.get(), opt, preset);
+
+    Synth::ProcessDriver driver;
+    std::minstd_rand rng{0};
+    size_t automationId = 0;
+    size_t eventIndex = 0;
+
+    clearRealtimeViolations();
+    for (size_t frame = 0; frame < nFrame; frame += opt.blockSize) {
+      const size_t length = std::min(opt.blockSize, nFrame - frame);
+
+      inputChanges.clear();
+      outputChanges.clear();
+      eventList.clear();
+      addBenchAutomation(inputChanges, rng, dsp->param.value.size(), length, automationId);
+      for (; eventIndex < events.size(); ++eventIndex) {
+        if (events[eventIndex].frame >= frame + length) break;
+        auto event = toBenchVstEvent(events[eventIndex], frame);
+        eventList.addEvent(event);
+      }
+      data.numSamples = int32(length);
+
+      RealtimeScope scope;
+      driver.prepare(data, dsp->param);
+      setBenchParameters(dsp.get(), opt.tempo);
+      driver.process(
+        data.numSamples, dsp->param,
+        [&]() { setBenchParameters(dsp.get(), opt.tempo); },
+        [&](Vst::Event &event) {
+          if constexpr (hasNote) note(*dsp, event.sampleOffset, toBenchNoteEvent(event));
+        },
+        [&](int32 offset, int32 subLength) {
+          render(*dsp, frame + size_t(offset), size_t(subLength), in, out);
+        });
+    }
+
+    size_t count = 0;
+    size_t dropped = 0;
+    const auto *violations = getRealtimeViolations(count, dropped);
+    nDropped += dropped;
+    for (size_t idx = 0; idx < count; ++idx) {
+      const auto &vio = violations[idx];
+      std::vector<void *> key(vio.frame, vio.frame + vio.nFrame);
+      key.push_back(reinterpret_cast<void *>(size_t(vio.kind)));
+
+      auto &report = reports[key];
+      if (report.count == 0) {
+        report.preset = name;
+        report.kind = vio.kind;
+        report.stack = symbolizeRealtimeViolation(vio);
+      }
+      ++report.count;
+    }
+  }
+
+  for (const auto &[key, report] : reports) {
+    std::cerr << "Error " << plugin_name << " \"" << report.preset
+              << "\": " << toString(report.kind) << " on audio thread (" << report.count
+              << " times in all presets).\n";
+    for (size_t idx = 0; idx < report.stack.size(); ++idx) {
+      std::cerr << "  #" << idx << " " << report.stack[idx] << "\n";
+    }
+  }
+  if (nDropped > 0) {
+    std::cerr << "Error " << plugin_name << ": " << nDropped
+              << " violations are not recorded due to buffer size.\n";
+  }
+  std::cout << plugin_name << ": " << reports.size() << " unique violations.\n";
+  return reports.empty() && nDropped == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif
+
+/**
+Parses command line, renders, then prints the report to stdout.
+
+- `render(dsp, frame, length, in, out)`: Processes `[frame, frame + length)`. Same as the
+  argument of `testSampleSize()`.
+- `note(dsp, frame, noteEvent)`: Sends a note at `frame` in the current block. Pass
+  `nullptr` for plugins without note input. In that case `--notes` is ignored.
+
+`SET_PARAMETERS` is called before each block. The time spent on setting parameters and
+sending notes is included in the block time.
+
+When `UHHYOU_RT_CHECK` is defined, `runRealtimeSafetyCheck()` is run instead. CMake
+builds it as `uhhyou-rtcheck_<PluginName>` with `rtsafety.cpp`, and with the SDK stubs
+in `test/sdkstub` for `ProcessDriver`.
+*/
+template<typename DSP_CLASS, typename Render, typename Note = std::nullptr_t>
+int runBench(
+  int argc, char **argv, std::string plugin_name, Render render, Note note = nullptr)
+{
+  constexpr bool hasNote = !std::is_same_v<Note, std::nullptr_t>;
+
+  BenchOptions opt;
+  if (!parseBenchOptions(argc, argv, opt)) {
+    printBenchUsage(plugin_name);
+    return EXIT_FAILURE;
+  }
+
+#ifdef UHHYOU_RT_CHECK
+  if (!opt.listPresets)
+    return runRealtimeSafetyCheck<DSP_CLASS>(opt, plugin_name, render, note);
+#endif
+
+  nlohmann::json preset;
+  if (opt.listPresets || !opt.preset.empty()) {
+    if (!findBenchPreset(opt, plugin_name, preset)) return EXIT_FAILURE;
+    if (opt.listPresets) return EXIT_SUCCESS;
+  }
+
+  const size_t nFrame = std::max(size_t(opt.seconds * opt.sampleRate), size_t(1));
+  std::vector<std::vector<float>> in;
+  if (!loadBenchInput(opt, nFrame, in)) return EXIT_FAILURE;
+  std::vector<std::vector<float>> out(2, std::vector<float>(nFrame));
+  const auto events = makeBenchNotes(opt, nFrame, hasNote);
+
+  auto dsp = std::make_unique<DSP_CLASS>();
+  setupBenchDsp(dsp.get(), opt, preset);
+
+  std::vector<double> blockNs;
+  blockNs.reserve(nFrame / opt.blockSize + 1);
+  renderBenchBlocks(
+    *dsp, opt, events, in, out, render, note, [&](size_t, auto process) {
+      auto start = std::chrono::steady_clock::now();
+      process();
+      auto end = std::chrono::steady_clock::now();
+      blockNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    });
+
+  for (size_t ch = 0; ch < out.size(); ++ch) {
+    auto it = std::find_if(
+      out[ch].begin(), out[ch].end(), [](float x) { return !std::isfinite(x); });
+    if (it == out[ch].end()) continue;
+    std::cerr << "Warning: Non-finite value " << *it << " at channel " << ch
+              << ", frame " << std::distance(out[ch].begin(), it) << "\n";
+  }
+
+  if (!opt.outputPath.empty()) {
+    auto result = writeWave(opt.outputPath, out, int(opt.sampleRate));
+    if (result != SndFileResult::success) return EXIT_FAILURE;
+  }
+
+  printBenchResult(opt, plugin_name, computeBenchResult(blockNs, nFrame, opt.sampleRate));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+// Compares per-block cost of note dispatch when a lot of notes arrive in one block.
+// - `vector`: `std::vector` + `std::find_if` + `erase`, which was used in DSPCores.
+// - `queue`: `SomeDSP::FrameEventQueue`.
+
+#include "../../common/dsp/eventqueue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct NoteInfo {
+  bool isNoteOn;
+  uint32_t frame;
+  int32_t id;
+  float pitch;
+  float velocity;
+};
+
+struct VectorDispatcher {
+  std::vector<NoteInfo> midiNotes;
+  uint64_t sum = 0;
+
+  VectorDispatcher() { midiNotes.reserve(2048); }
+
+  void push(const NoteInfo &note) { midiNotes.push_back(note); }
+
+  void processMidiNote(size_t frame)
+  {
+    while (true) {
+      auto it = std::find_if(midiNotes.begin(), midiNotes.end(), [&](const NoteInfo &nt) {
+        return nt.frame == frame;
+      });
+      if (it == std::end(midiNotes)) return;
+      sum += it->id;
+      midiNotes.erase(it);
+    }
+  }
+};
+
+struct QueueDispatcher {
+  SomeDSP::FrameEventQueue<NoteInfo, 2048> midiNotes;
+  uint64_t sum = 0;
+
+  void push(const NoteInfo &note) { midiNotes.push(note); }
+
+  void processMidiNote(size_t frame)
+  {
+    NoteInfo note;
+    while (midiNotes.pop(frame, note)) sum += note.id;
+  }
+};
+
+template<typename Dispatcher>
+double benchmark(
+  const std::vector<NoteInfo> &notes, size_t blockSize, size_t nBlock, uint64_t &sum)
+{
+  Dispatcher dispatcher;
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t block = 0; block < nBlock; ++block) {
+    for (const auto &note : notes) dispatcher.push(note);
+    for (size_t frame = 0; frame < blockSize; ++frame) dispatcher.processMidiNote(frame);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  sum = dispatcher.sum;
+  return std::chrono::duration<double, std::micro>(end - start).count() / double(nBlock);
+}
+
+int main()
+{
+  constexpr size_t blockSize = 512;
+  constexpr size_t nBlock = 200;
+
+  std::minstd_rand rng{0};
+  std::uniform_int_distribution<uint32_t> distFrame{0, blockSize - 1};
+
+  std::cout << "notes,vector [us/block],queue [us/block]\n";
+  for (size_t nNote : {16, 128, 1024, 2000}) {
+    // Hosts send events in frame order.
+    std::vector<NoteInfo> notes(nNote);
+    for (size_t idx = 0; idx < nNote; ++idx) {
+      notes[idx] = {idx % 2 == 0, distFrame(rng), int32_t(idx), 60.0f, 1.0f};
+    }
+    std::stable_sort(notes.begin(), notes.end(), [](const auto &a, const auto &b) {
+      return a.frame < b.frame;
+    });
+
+    uint64_t sumVector = 0;
+    uint64_t sumQueue = 0;
+    auto usVector = benchmark<VectorDispatcher>(notes, blockSize, nBlock, sumVector);
+    auto usQueue = benchmark<QueueDispatcher>(notes, blockSize, nBlock, sumQueue);
+    if (sumVector != sumQueue) {
+      std::cerr << "Error: Dispatched notes differ at nNote " << nNote << ".\n";
+      return EXIT_FAILURE;
+    }
+    std::cout << nNote << "," << usVector << "," << usQueue << "\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -59,6 +59,8 @@ public:
     for (auto &th : threads) th.join();
 
     isFinished = true;
+
+    testPerformance(plugin_name, out_dir);
   }
 
   std::unique_ptr<DSP_CLASS> setupDSP() { return std::make_unique<DSP_CLASS>(); }
@@ -78,6 +80,24 @@ public:
 #endif
   }
 
+  void testPerformance(std::string plugin_name, std::string out_dir)
+  {
+    constexpr float sampleRate = 48000;
+    constexpr size_t nFrame = size_t(5 * sampleRate);
+
+    const auto input = generateTestNoise<float>(nFrame);
+
+    std::vector<std::vector<float>> wav(2);
+    for (auto &channel : wav) channel.resize(nFrame);
+
+    TesterCommon::testPerformance(
+      plugin_name, out_dir, sampleRate, nFrame, [&]() { return setupDSP(); },
+      [&](auto &dsp) {
+        dsp->reset();
+        render(nFrame, input, wav, dsp);
+      });
+  }
+
   void testSequence(std::shared_ptr<PresetQueue> queue)
   {
     constexpr float sampleRate = 48000;
@@ -101,14 +121,7 @@ public:
       }
       dsp->setup(sampleRate);
 
-      size_t index = 0;
-      for (const auto &parameter : preset["parameter"]) {
-        if (parameter["type"] == "I")
-          dsp->param.value[index]->setFromInt(parameter["value"]);
-        else if (parameter["type"] == "d")
-          dsp->param.value[index]->setFromNormalized(parameter["value"]);
-        ++index;
-      }
+      loadPresetParameter(*dsp, preset);
 
       SET_PARAMETERS;
       dsp->reset();
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "../../lib/ghc/fs_std.hpp"
+#include "../../lib/json.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+/**
+Performance regression gate. Used by the testers after the output check. Disabled unless
+`UHHYOU_PERF_GATE` is set.
+
+Each preset is rendered on a single thread pinned to a core, alternately with a reference
+render of fixed cost. After 1 warm-up render of each, the minimum time of `nRepeat`
+renders is taken. The cost of a preset is the ratio of its time to the reference time in
+the same run, so that the speed and the load of the machine are cancelled out.
+
+Results are written to `snd/<PluginName>/timing/current.json`. The first run writes
+`baseline.json` instead, in the same way as `reference` directory of the output check.
+
+The test fails when the total or a preset costs more than the baseline by more than the
+tolerance. Following environment variables are read:
+
+- `UHHYOU_PERF_GATE`: Enables the gate if set.
+- `UHHYOU_PERF_TOLERANCE`: Relative tolerance. Default 0.1, which is 10% slower.
+- `UHHYOU_PERF_REPEAT`: Number of timed renders per preset. Default 5.
+*/
+class PerformanceGate {
+public:
+  double tolerance = 0.1;
+  size_t nRepeat = 5;
+  bool isEnabled = false;
+
+  // `nFrame` is the length of the reference render. Use the same length as the presets.
+  PerformanceGate(std::string out_dir, size_t nFrame) : timing_dir(out_dir + "/timing/")
+  {
+    isEnabled = std::getenv("UHHYOU_PERF_GATE") != nullptr;
+    if (!isEnabled) return;
+
+    tolerance = readEnv("UHHYOU_PERF_TOLERANCE", tolerance);
+    nRepeat = size_t(std::max(1.0, readEnv("UHHYOU_PERF_REPEAT", double(nRepeat))));
+
+    std::minstd_rand rng{0};
+    std::uniform_real_distribution<float> dist{-0.25f, 0.25f};
+    referenceInput.resize(nFrame);
+    for (auto &x : referenceInput) x = dist(rng);
+  }
+
+  // Pins the calling thread to the first core allowed for the process.
+  static void pinCurrentThread()
+  {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (!CPU_ISSET(cpu, &allowed)) continue;
+      cpu_set_t target;
+      CPU_ZERO(&target);
+      CPU_SET(cpu, &target);
+      pthread_setaffinity_np(pthread_self(), sizeof(target), &target);
+      return;
+    }
+#endif
+  }
+
+  // `renderFunc` is called `nRepeat + 1` times. It must reset the DSP by itself.
+  template<typename Func> void measure(const std::string &name, Func renderFunc)
+  {
+    renderReference();
+    renderFunc();
+
+    double bestReference = std::numeric_limits<double>::max();
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < nRepeat; ++i) {
+      bestReference = std::min(bestReference, elapsed([&]() { renderReference(); }));
+      best = std::min(best, elapsed(renderFunc));
+    }
+    cost[name] = best / bestReference;
+  }
+
+  // Returns `false` on regression.
+  bool compare()
+  {
+    if (!isEnabled) return true;
+
+    nlohmann::json current;
+    double total = 0;
+    for (const auto &[name, ratio] : cost) {
+      current["preset"][name] = ratio;
+      total += ratio;
+    }
+    current["total"] = total;
+    current["tolerance"] = tolerance;
+    current["repeat"] = nRepeat;
+
+    fs::create_directories(timing_dir);
+    const auto baselinePath = timing_dir + "baseline.json";
+    if (!fs::exists(baselinePath)) {
+      writeJson(baselinePath, current);
+      std::cout << "Performance baseline is written to " << baselinePath << "\n";
+      return true;
+    }
+    writeJson(timing_dir + "current.json", current);
+
+    nlohmann::json baseline;
+    {
+      std::ifstream ifs(baselinePath);
+      if (!ifs.is_open()) {
+        std::cerr << "Error: Failed to open " << baselinePath << "\n";
+        return false;
+      }
+      ifs >> baseline;
+    }
+
+    bool isPassed = check("total", total, baseline.value("total", 0.0));
+    for (const auto &[name, ratio] : cost) {
+      if (!baseline["preset"].contains(name)) continue;
+      isPassed &= check(name, ratio, baseline["preset"][name].get<double>());
+    }
+    return isPassed;
+  }
+
+private:
+  std::string timing_dir;
+  std::map<std::string, double> cost;
+  std::vector<float> referenceInput;
+  volatile float referenceOutput = 0;
+
+  template<typename Func> static double elapsed(Func &&func)
+  {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+  }
+
+  // 32 cascaded biquad lowpass. Cutoff is 1/8 of sampling rate, and Q is 1/sqrt(2).
+  void renderReference()
+  {
+    constexpr size_t nStage = 32;
+    constexpr float b0 = 0.09763107f;
+    constexpr float b1 = 0.19526215f;
+    constexpr float b2 = 0.09763107f;
+    constexpr float a1 = -0.94280904f;
+    constexpr float a2 = 0.33333333f;
+
+    std::array<float, nStage> z1{};
+    std::array<float, nStage> z2{};
+    float sum = 0;
+    for (auto x0 : referenceInput) {
+      for (size_t idx = 0; idx < nStage; ++idx) {
+        float y0 = b0 * x0 + z1[idx];
+        z1[idx] = b1 * x0 - a1 * y0 + z2[idx];
+        z2[idx] = b2 * x0 - a2 * y0;
+        x0 = y0;
+      }
+      sum += x0;
+    }
+    referenceOutput = sum;
+  }
+
+  static double readEnv(const char *key, double defaultValue)
+  {
+    const char *env = std::getenv(key);
+    if (env == nullptr) return defaultValue;
+    char *end = nullptr;
+    double value = std::strtod(env, &end);
+    return end == env || value < 0 ? defaultValue : value;
+  }
+
+  static void writeJson(const std::string &path, const nlohmann::json &data)
+  {
+    std::ofstream ofs(path);
+    if (!ofs.is_open()) {
+      std::cerr << "Error: Failed to open " << path << "\n";
+      return;
+    }
+    ofs << data.dump(2) << "\n";
+  }
+
+  bool check(const std::string &name, double actual, double expected)
+  {
+    if (expected <= 0 || actual <= expected * (1.0 + tolerance)) return true;
+    std::cerr << "Error " << name << ": Performance regression. " << actual
+              << " times of reference, baseline " << expected << " times ("
+              << 100.0 * (actual / expected - 1.0) << "% slower, tolerance "
+              << 100.0 * tolerance << "%)\n";
+    return false;
+  }
+};
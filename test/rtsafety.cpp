@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#include "rtsafety.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#if defined(__linux__) && defined(__GLIBC__)
+  #include <cerrno>
+  #include <cxxabi.h>
+  #include <dlfcn.h>
+  #include <execinfo.h>
+  #include <pthread.h>
+
+  #define UHHYOU_RT_INTERPOSE
+#endif
+
+namespace {
+
+constexpr size_t maxViolation = 4096;
+RealtimeViolation violations[maxViolation];
+std::atomic<size_t> nViolation{0};
+std::atomic<size_t> nDropped{0};
+
+thread_local bool isInScope = false;
+thread_local bool isRecording = false;
+
+#ifdef UHHYOU_RT_INTERPOSE
+// Number of frames from `recordViolation()` to the interposed function.
+constexpr int nSkipFrame = 2;
+
+__attribute__((noinline)) void recordViolation(RealtimeViolationKind kind)
+{
+  if (!isInScope || isRecording) return;
+  isRecording = true;
+
+  size_t index = nViolation.fetch_add(1, std::memory_order_relaxed);
+  if (index < maxViolation) {
+    auto &vio = violations[index];
+    vio.kind = kind;
+    vio.nFrame = backtrace(vio.frame, RealtimeViolation::maxFrame);
+  } else {
+    nDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  isRecording = false;
+}
+
+using MutexFunc = int (*)(pthread_mutex_t *);
+
+// `dlsym` may allocate. Resolved at startup to avoid recording it inside of the scope.
+MutexFunc realMutexLock = nullptr;
+MutexFunc realMutexTrylock = nullptr;
+
+void resolveMutexFunctions()
+{
+  if (realMutexLock != nullptr) return;
+  realMutexLock = reinterpret_cast<MutexFunc>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+  realMutexTrylock
+    = reinterpret_cast<MutexFunc>(dlsym(RTLD_NEXT, "pthread_mutex_trylock"));
+}
+
+__attribute__((constructor)) void initializeRealtimeCheck()
+{
+  resolveMutexFunctions();
+
+  // First call of `backtrace` loads libgcc, which allocates.
+  void *frame[1];
+  backtrace(frame, 1);
+}
+#endif
+
+} // namespace
+
+#ifdef UHHYOU_RT_INTERPOSE
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size)
+{
+  recordViolation(RealtimeViolationKind::allocation);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+  recordViolation(RealtimeViolationKind::allocation);
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  recordViolation(RealtimeViolationKind::allocation);
+  return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+  recordViolation(RealtimeViolationKind::allocation);
+  return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+  recordViolation(RealtimeViolationKind::allocation);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+  recordViolation(RealtimeViolationKind::allocation);
+  if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+    return EINVAL;
+  void *mem = __libc_memalign(alignment, size);
+  if (mem == nullptr) return ENOMEM;
+  *ptr = mem;
+  return 0;
+}
+
+void free(void *ptr)
+{
+  if (ptr != nullptr) recordViolation(RealtimeViolationKind::deallocation);
+  __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t *mutex)
+{
+  recordViolation(RealtimeViolationKind::lock);
+  resolveMutexFunctions();
+  return realMutexLock(mutex);
+}
+
+int pthread_mutex_trylock(pthread_mutex_t *mutex)
+{
+  recordViolation(RealtimeViolationKind::lock);
+  resolveMutexFunctions();
+  return realMutexTrylock(mutex);
+}
+} // extern "C"
+#endif
+
+bool isRealtimeCheckSupported()
+{
+#ifdef UHHYOU_RT_INTERPOSE
+  return true;
+#else
+  return false;
+#endif
+}
+
+void beginRealtimeScope() { isInScope = true; }
+void endRealtimeScope() { isInScope = false; }
+
+const RealtimeViolation *getRealtimeViolations(size_t &count, size_t &dropped)
+{
+  count = std::min(nViolation.load(), maxViolation);
+  dropped = nDropped.load();
+  return violations;
+}
+
+void clearRealtimeViolations()
+{
+  nViolation.store(0);
+  nDropped.store(0);
+}
+
+std::vector<std::string> symbolizeRealtimeViolation(const RealtimeViolation &violation)
+{
+  std::vector<std::string> lines;
+#ifdef UHHYOU_RT_INTERPOSE
+  const int nFrame = violation.nFrame - nSkipFrame;
+  if (nFrame <= 0) return lines;
+
+  char **symbols = backtrace_symbols(violation.frame + nSkipFrame, nFrame);
+  if (symbols == nullptr) return lines;
+
+  // Format of a symbol is `object(mangled+offset) [address]`.
+  for (int idx = 0; idx < nFrame; ++idx) {
+    std::string line = symbols[idx];
+    auto begin = line.find('(');
+    auto end = line.find('+', begin);
+    if (begin != std::string::npos && end != std::string::npos && end > begin + 1) {
+      std::string mangled = line.substr(begin + 1, end - begin - 1);
+      int status = 0;
+      char *demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+      if (status == 0 && demangled != nullptr) {
+        line = line.substr(0, begin + 1) + demangled + line.substr(end);
+      }
+      std::free(demangled);
+    }
+    lines.push_back(line);
+  }
+  std::free(symbols);
+#endif
+  return lines;
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+Detection of calls that are not realtime safe. Implemented in `rtsafety.cpp`, which
+interposes `malloc`, `free` and `pthread_mutex_lock` family. Only the calls made on the
+thread inside `RealtimeScope` are recorded.
+
+Recording doesn't allocate. Call stacks are stored in a fixed size buffer, and symbolized
+later by `symbolizeRealtimeViolation()` outside of the scope.
+*/
+
+enum class RealtimeViolationKind { allocation, deallocation, lock };
+
+struct RealtimeViolation {
+  static constexpr int maxFrame = 32;
+
+  RealtimeViolationKind kind;
+  int nFrame;
+  void *frame[maxFrame];
+};
+
+// Returns false when interposition is not available on the platform.
+bool isRealtimeCheckSupported();
+
+void beginRealtimeScope();
+void endRealtimeScope();
+
+// Returns recorded violations. `dropped` is the number of violations that didn't fit in
+// the buffer.
+const RealtimeViolation *getRealtimeViolations(size_t &count, size_t &dropped);
+void clearRealtimeViolations();
+
+std::vector<std::string> symbolizeRealtimeViolation(const RealtimeViolation &violation);
+
+inline const char *toString(RealtimeViolationKind kind)
+{
+  switch (kind) {
+    case RealtimeViolationKind::allocation:
+      return "allocation";
+    case RealtimeViolationKind::deallocation:
+      return "deallocation";
+    case RealtimeViolationKind::lock:
+      return "lock";
+  }
+  return "unknown";
+}
+
+struct RealtimeScope {
+  RealtimeScope() { beginRealtimeScope(); }
+  ~RealtimeScope() { endRealtimeScope(); }
+};
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "testutil.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+/**
+Renders each preset with `float` and `double` buffers, then checks that the `double`
+output rounded to `float` is equal to the `float` output.
+
+This is for DSPCore that computes in `double` internally and provides
+`process<Sample>()`. The input is generated as `float`, so the conversion to `double` is
+exact. Therefore both outputs must match exactly, except for denormals which may be
+flushed to 0 only on one side.
+
+`render(dsp, frame, length, in, out)` processes `[frame, frame + length)` of `in` and
+`out`, which are `std::vector<std::vector<Sample>>` with 2 channels.
+*/
+template<typename DSP_CLASS, typename Render>
+bool testSampleSize(std::string plugin_name, Render render)
+{
+  constexpr float sampleRate = 48000;
+  constexpr size_t nFrame = size_t(2 * sampleRate);
+  constexpr size_t blockSize = 512;
+
+  std::minstd_rand rng{unsigned(26935804702)};
+  std::uniform_real_distribution<float> dist{-0.25f, 0.25f};
+  std::vector<std::vector<float>> in32(2, std::vector<float>(nFrame));
+  std::vector<std::vector<double>> in64(2, std::vector<double>(nFrame));
+  for (size_t ch = 0; ch < in32.size(); ++ch) {
+    for (size_t i = 0; i < nFrame; ++i) {
+      in32[ch][i] = dist(rng);
+      in64[ch][i] = double(in32[ch][i]);
+    }
+  }
+  std::vector<std::vector<float>> out32(2, std::vector<float>(nFrame));
+  std::vector<std::vector<double>> out64(2, std::vector<double>(nFrame));
+
+  bool isSuccess = true;
+  auto presets = loadPresetJson(plugin_name);
+  for (const auto &preset : presets) {
+    std::array<std::unique_ptr<DSP_CLASS>, 2> dsps;
+    for (auto &dsp : dsps) {
+      dsp = std::make_unique<DSP_CLASS>();
+      dsp->setup(sampleRate);
+
+      loadPresetParameter(*dsp, preset);
+      SET_PARAMETERS;
+      dsp->reset();
+    }
+
+    for (size_t frame = 0; frame < nFrame; frame += blockSize) {
+      const size_t length = std::min(blockSize, nFrame - frame);
+      render(*dsps[0], frame, length, in32, out32);
+      render(*dsps[1], frame, length, in64, out64);
+    }
+
+    for (size_t ch = 0; ch < out32.size(); ++ch) {
+      auto mismatch = std::mismatch(
+        out32[ch].begin(), out32[ch].end(), out64[ch].begin(),
+        [](float a, double b) {
+          constexpr double fmin = std::numeric_limits<float>::min();
+          if (std::abs(a) < fmin && std::abs(b) < fmin) return true;
+          return a == float(b);
+        });
+      if (mismatch.first == out32[ch].end()) continue;
+
+      std::cerr << "Error " << preset["name"] << ": 32-bit output " << *mismatch.first
+                << " and 64-bit output " << *mismatch.second
+                << " are not equal at channel " << ch << ", frame "
+                << std::distance(out32[ch].begin(), mismatch.first) << "\n";
+      isSuccess = false;
+      break;
+    }
+  }
+  return isSuccess;
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "ivstevents.h"
+#include "ivstparameterchanges.h"
+#include "vsttypes.h"
+
+namespace Steinberg {
+namespace Vst {
+
+// `ProcessContext` is in `ivstprocesscontext.h` in the SDK.
+struct ProcessContext {
+  enum StatesAndFlags {
+    kPlaying = 1 << 1,
+    kProjectTimeMusicValid = 1 << 9,
+    kTempoValid = 1 << 10,
+  };
+
+  uint32 state;
+  double sampleRate;
+  TQuarterNotes projectTimeMusic;
+  double tempo;
+};
+
+struct AudioBusBuffers {
+  int32 numChannels;
+  uint64 silenceFlags;
+  union {
+    Sample32 **channelBuffers32;
+    Sample64 **channelBuffers64;
+  };
+};
+
+struct ProcessData {
+  int32 processMode;
+  int32 symbolicSampleSize;
+  int32 numSamples;
+  int32 numInputs;
+  int32 numOutputs;
+  AudioBusBuffers *inputs;
+  AudioBusBuffers *outputs;
+  IParameterChanges *inputParameterChanges;
+  IParameterChanges *outputParameterChanges;
+  IEventList *inputEvents;
+  IEventList *outputEvents;
+  ProcessContext *processContext;
+};
+
+} // namespace Vst
+} // namespace Steinberg
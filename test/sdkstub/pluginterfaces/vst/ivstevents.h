@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "vsttypes.h"
+
+namespace Steinberg {
+namespace Vst {
+
+struct NoteOnEvent {
+  int16 channel;
+  int16 pitch;
+  float tuning;
+  float velocity;
+  int32 length;
+  int32 noteId;
+};
+
+struct NoteOffEvent {
+  int16 channel;
+  int16 pitch;
+  float velocity;
+  int32 noteId;
+  float tuning;
+};
+
+struct Event {
+  int32 busIndex;
+  int32 sampleOffset;
+  TQuarterNotes ppqPosition;
+  uint16 flags;
+  uint16 type;
+  union {
+    NoteOnEvent noteOn;
+    NoteOffEvent noteOff;
+  };
+
+  enum EventTypes { kNoteOnEvent = 0, kNoteOffEvent = 1 };
+};
+
+class IEventList {
+public:
+  virtual ~IEventList() {}
+
+  virtual int32 getEventCount() = 0;
+  virtual tresult getEvent(int32 index, Event &e) = 0;
+  virtual tresult addEvent(Event &e) = 0;
+};
+
+} // namespace Vst
+} // namespace Steinberg
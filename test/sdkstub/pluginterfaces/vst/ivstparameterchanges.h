@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "vsttypes.h"
+
+namespace Steinberg {
+namespace Vst {
+
+class IParamValueQueue {
+public:
+  virtual ~IParamValueQueue() {}
+
+  virtual ParamID getParameterId() = 0;
+  virtual int32 getPointCount() = 0;
+  virtual tresult getPoint(int32 index, int32 &sampleOffset, ParamValue &value) = 0;
+  virtual tresult addPoint(int32 sampleOffset, ParamValue value, int32 &index) = 0;
+};
+
+class IParameterChanges {
+public:
+  virtual ~IParameterChanges() {}
+
+  virtual int32 getParameterCount() = 0;
+  virtual IParamValueQueue *getParameterData(int32 index) = 0;
+  virtual IParamValueQueue *addParameterData(const ParamID &id, int32 &index) = 0;
+};
+
+} // namespace Vst
+} // namespace Steinberg
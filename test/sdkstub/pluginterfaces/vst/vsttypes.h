@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+/**
+Subset of VST 3 SDK declarations used by `common/processdriver.hpp`. Only for tests,
+which are built without the SDK. Member names and values follow the SDK, but interfaces
+don't derive from `FUnknown`.
+*/
+
+#include <cstdint>
+
+// Same as `test/value.hpp`.
+using int32 = long;
+
+namespace Steinberg {
+
+using ::int32;
+using int16 = int16_t;
+using uint16 = uint16_t;
+using uint32 = uint32_t;
+using uint64 = uint64_t;
+using tresult = int32_t;
+
+enum : tresult {
+  kResultOk = 0,
+  kResultTrue = kResultOk,
+  kResultFalse = 1,
+  kInvalidArgument = 2,
+};
+
+namespace Vst {
+
+// Same as `test/value.hpp`.
+using ParamID = unsigned long;
+using ParamValue = double;
+using Sample32 = float;
+using Sample64 = double;
+using TQuarterNotes = double;
+
+enum SymbolicSampleSizes { kSample32, kSample64 };
+
+} // namespace Vst
+} // namespace Steinberg
@@ -119,6 +119,8 @@ public:
     for (auto &th : threads) th.join();
 
     isFinished = true;
+
+    testPerformance(plugin_name, out_dir);
   }
 
   std::unique_ptr<DSP_CLASS> setupDSP() { return std::make_unique<DSP_CLASS>(); }
@@ -182,6 +184,27 @@ public:
     processDsp(nFrame - currentFrame, currentFrame, wav, dsp);
   }
 
+  void testPerformance(std::string plugin_name, std::string out_dir)
+  {
+    constexpr float sampleRate = 48000;
+    constexpr size_t nFrame = size_t(5 * sampleRate);
+    constexpr float tempo = 120.0f;
+
+    std::vector<std::vector<float>> wav(2);
+    for (auto &channel : wav) channel.resize(nFrame);
+
+    Sequencer sequencer;
+    sequencer.setupSequence(sampleRate, tempo);
+
+    TesterCommon::testPerformance(
+      plugin_name, out_dir, sampleRate, nFrame, [&]() { return setupDSP(); },
+      [&](auto &dsp) {
+        for (auto &wv : wav) std::fill(wv.begin(), wv.end(), 0.0f);
+        dsp->reset();
+        render(nFrame, sequencer, wav, dsp);
+      });
+  }
+
   void testSequence(std::shared_ptr<PresetQueue> queue)
   {
     constexpr float sampleRate = 48000;
@@ -206,14 +229,7 @@ public:
       }
       dsp->setup(sampleRate);
 
-      size_t index = 0;
-      for (const auto &parameter : preset["parameter"]) {
-        if (parameter["type"] == "I")
-          dsp->param.value[index]->setFromInt(parameter["value"]);
-        else if (parameter["type"] == "d")
-          dsp->param.value[index]->setFromNormalized(parameter["value"]);
-        ++index;
-      }
+      loadPresetParameter(*dsp, preset);
       SET_PARAMETERS;
       dsp->reset();
 
@@ -296,6 +312,8 @@ public:
     for (auto &th : threads) th.join();
 
     isFinished = true;
+
+    testPerformance(plugin_name, out_dir);
   }
 
   bool checkInstrset()
@@ -388,6 +406,27 @@ public:
     processDsp(nFrame - currentFrame, currentFrame, wav, dsp);
   }
 
+  void testPerformance(std::string plugin_name, std::string out_dir)
+  {
+    constexpr float sampleRate = 48000;
+    constexpr size_t nFrame = size_t(5 * sampleRate);
+    constexpr float tempo = 120.0f;
+
+    std::vector<std::vector<float>> wav(2);
+    for (auto &channel : wav) channel.resize(nFrame);
+
+    Sequencer sequencer;
+    sequencer.setupSequence(sampleRate, tempo);
+
+    TesterCommon::testPerformance(
+      plugin_name, out_dir, sampleRate, nFrame, [&]() { return setupDSP(); },
+      [&](auto &dsp) {
+        for (auto &wv : wav) std::fill(wv.begin(), wv.end(), 0.0f);
+        dsp->reset();
+        render(nFrame, sequencer, wav, dsp);
+      });
+  }
+
   void testSequence(std::shared_ptr<PresetQueue> queue)
   {
     constexpr float sampleRate = 48000;
@@ -412,14 +451,7 @@ public:
       }
       dsp->setup(sampleRate);
 
-      size_t index = 0;
-      for (const auto &parameter : preset["parameter"]) {
-        if (parameter["type"] == "I")
-          dsp->param.value[index]->setFromInt(parameter["value"]);
-        else if (parameter["type"] == "d")
-          dsp->param.value[index]->setFromNormalized(parameter["value"]);
-        ++index;
-      }
+      loadPresetParameter(*dsp, preset);
       SET_PARAMETERS;
       dsp->reset();
 
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// Copyright Takamitsu Endo (ryukau@gmail.com)
+
+#pragma once
+
+#include "pluginterfaces/vst/ivstaudioprocessor.h"
+
+#include <vector>
+
+/**
+Host side of `Vst::ProcessData` to drive `ProcessDriver` in tests. Buffers are allocated
+in the constructors, so the audio thread only reads the filled values. `clear()` keeps
+the capacity.
+
+Points beyond the capacity are rejected with `kResultFalse`, as hosts do.
+*/
+
+namespace Steinberg {
+namespace Vst {
+
+class TestParamValueQueue : public IParamValueQueue {
+public:
+  struct Point {
+    int32 offset = 0;
+    ParamValue value = 0;
+  };
+
+  TestParamValueQueue(size_t capacity = 64) { points.reserve(capacity); }
+
+  void reset(ParamID id)
+  {
+    this->id = id;
+    points.resize(0);
+  }
+
+  ParamID getParameterId() override { return id; }
+  int32 getPointCount() override { return int32(points.size()); }
+
+  tresult getPoint(int32 index, int32 &sampleOffset, ParamValue &value) override
+  {
+    if (index < 0 || size_t(index) >= points.size()) return kInvalidArgument;
+    sampleOffset = points[index].offset;
+    value = points[index].value;
+    return kResultTrue;
+  }
+
+  tresult addPoint(int32 sampleOffset, ParamValue value, int32 &index) override
+  {
+    if (points.size() >= points.capacity()) return kResultFalse;
+    index = int32(points.size());
+    points.push_back({sampleOffset, value});
+    return kResultTrue;
+  }
+
+private:
+  ParamID id = 0;
+  std::vector<Point> points;
+};
+
+class TestParameterChanges : public IParameterChanges {
+public:
+  TestParameterChanges(size_t capacity = 256) : queues(capacity) {}
+
+  void clear() { nQueue = 0; }
+
+  int32 getParameterCount() override { return int32(nQueue); }
+
+  IParamValueQueue *getParameterData(int32 index) override
+  {
+    if (index < 0 || size_t(index) >= nQueue) return nullptr;
+    return &queues[index];
+  }
+
+  IParamValueQueue *addParameterData(const ParamID &id, int32 &index) override
+  {
+    for (size_t idx = 0; idx < nQueue; ++idx) {
+      if (queues[idx].getParameterId() != id) continue;
+      index = int32(idx);
+      return &queues[idx];
+    }
+    if (nQueue >= queues.size()) return nullptr;
+    index = int32(nQueue);
+    queues[nQueue].reset(id);
+    return &queues[nQueue++];
+  }
+
+private:
+  std::vector<TestParamValueQueue> queues;
+  size_t nQueue = 0;
+};
+
+class TestEventList : public IEventList {
+public:
+  TestEventList(size_t capacity = 1024) { events.reserve(capacity); }
+
+  void clear() { events.resize(0); }
+
+  int32 getEventCount() override { return int32(events.size()); }
+
+  tresult getEvent(int32 index, Event &e) override
+  {
+    if (index < 0 || size_t(index) >= events.size()) return kInvalidArgument;
+    e = events[index];
+    return kResultOk;
+  }
+
+  tresult addEvent(Event &e) override
+  {
+    if (events.size() >= events.capacity()) return kResultFalse;
+    events.push_back(e);
+    return kResultOk;
+  }
+
+private:
+  std::vector<Event> events;
+};
+
+} // namespace Vst
+} // namespace Steinberg
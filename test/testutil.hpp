@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../../lib/ghc/fs_std.hpp"
+#include "perfgate.hpp"
 
 #include <algorithm>
 #include <deque>
@@ -160,6 +161,20 @@ inline nlohmann::json loadPresetJson(std::string plugin_name)
   return data;
 }
 
+// `preset` is an element of `loadPresetJson()`.
+template<typename DSP_CLASS>
+inline void loadPresetParameter(DSP_CLASS &dsp, const nlohmann::json &preset)
+{
+  size_t index = 0;
+  for (const auto &parameter : preset["parameter"]) {
+    if (parameter["type"] == "I")
+      dsp.param.value[index]->setFromInt(parameter["value"]);
+    else if (parameter["type"] == "d")
+      dsp.param.value[index]->setFromNormalized(parameter["value"]);
+    ++index;
+  }
+}
+
 struct PresetQueue {
   using json = nlohmann::json;
 
@@ -197,6 +212,43 @@ protected:
 
 public:
   bool isFinished = false;
+  bool isPerformanceRegressed = false;
+
+  bool isPassed() const { return isFinished && !isPerformanceRegressed; }
+
+  /**
+  Runs `PerformanceGate` for all presets. `setupDSP()` returns a new DSP. `render(dsp)`
+  resets the DSP and renders `nFrame` frames.
+
+  Expands `SET_PARAMETERS` defined in `test/testdsp.cpp`.
+  */
+  template<typename SetupDSP, typename Render>
+  void testPerformance(
+    const std::string &plugin_name,
+    const std::string &out_dir,
+    float sampleRate,
+    size_t nFrame,
+    SetupDSP setupDSP,
+    Render render)
+  {
+    PerformanceGate gate(out_dir, nFrame);
+    if (!gate.isEnabled) return;
+    PerformanceGate::pinCurrentThread();
+
+    [[maybe_unused]] constexpr float tempo = 120.0f;
+
+    for (const auto &preset : loadPresetJson(plugin_name)) {
+      auto dsp = setupDSP();
+      if (!dsp) return;
+      dsp->setup(sampleRate);
+      loadPresetParameter(*dsp, preset);
+      SET_PARAMETERS;
+
+      gate.measure(preset["name"].get<std::string>(), [&]() { render(dsp); });
+    }
+
+    isPerformanceRegressed = !gate.compare();
+  }
 
   SoundFile readReferenceWave(std::string path)
   {